@@ -265,9 +265,10 @@ void App::CreateTheConsole()
 		GetGraphicsContext()
 	);
 
-	// Add a CommandListCommands command to the interpreter.
+	// Add the CommandListCommands and CommandStats commands to the interpreter.
 	auto *interpreter = m_console->GetInterpreter();
 	interpreter->InstallCommand(std::make_shared<CommandListCommands>(interpreter));
+	interpreter->InstallCommand(std::make_shared<CommandStats>(interpreter));
 }
 
 
@@ -357,6 +358,15 @@ void App::OnWMKeydown(WPARAM wParam)
 	auto alt = is_key_down(VK_MENU);
 	auto mod = ModKeyState{ ctrl, alt };
 
+	// Ctrl+V pastes the clipboard into the command line in one go.
+	if (ctrl && key == 'V') {
+		auto redraw = m_console->HandlePaste(read_clipboard_text(m_hwnd));
+		if (redraw) {
+			SendRedrawRequest();
+		}
+		return;
+	}
+
 	auto redraw = m_console->HandleKey(key, mod);
 	if (redraw) {
 		SendRedrawRequest();
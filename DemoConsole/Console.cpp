@@ -217,8 +217,15 @@ bool Console::HandleKey(Key key, const ModKeyState &mod)
 		}break;
 	}
 
+	auto wasSearching = m_console.is_searching();
+
 	auto changed = m_console.handle_key(key, mod);
 	if (!changed) {
+		// Enter leaves the reverse search even if there is nothing to execute.
+		if (wasSearching != m_console.is_searching()) {
+			UpdateCmdlineItem();
+			return true;// redraw
+		}
 		return false;// do not redraw
 	}
 
@@ -239,6 +246,17 @@ bool Console::HandleKey(Key key, const ModKeyState &mod)
 	return true;// redraw
 }
 
+bool Console::HandlePaste(const std::wstring &text)
+{
+	auto changed = m_console.insert_text(text);
+	if (!changed) {
+		return false;// do not redraw
+	}
+
+	UpdateCmdlineItem();
+	return true;// redraw
+}
+
 void Console::PostProcessReturnKey()
 {
 	// Push the command line that has just got processed.
@@ -339,7 +357,23 @@ bool Console::UpdateCmdlineItem()
 	auto oldHeight = Height(m_cmdlineItem.bbox);
 
 	// Get the command line text from the dbgutils::Console.
-	m_cmdlineItem.text = m_promptStr + m_console.cmdline();
+	// In reverse search mode, the search pattern replaces the prompt.
+	if (m_console.is_searching()) {
+		m_cmdlineItem.text = m_console.search_failed() ? L"(failed reverse-i-search)`" : L"(reverse-i-search)`";
+		m_cmdlineItem.text += m_console.search_pattern();
+		m_cmdlineItem.text += L"': ";
+	}
+	else {
+		m_cmdlineItem.text = m_promptStr;
+	}
+	m_cmdlinePrefixLength = m_cmdlineItem.text.length();
+	auto cmdline = m_console.cmdline_segments();
+	m_cmdlineItem.text += cmdline.first;
+	m_cmdlineItem.text += cmdline.second;
+
+	auto suggestion = m_console.suggestion();
+	m_suggestionLength = suggestion.length();
+	m_cmdlineItem.text += suggestion;
 
 	m_cmdlineItem.RecreateTextLayout(Size(m_rect), m_graphics);
 
@@ -447,8 +481,16 @@ void Console::DrawCmdlineString(const D2D1_COLOR_F &color)
 	ren.SaveBrushColor();
 	ren.solidBrush->SetColor(ColorFrom3i(230, 230, 230));
 
+	// The suggestion is drawn in gray, after the command line.
+	ID2D1SolidColorBrush *grayBrush = nullptr;
+	if (m_suggestionLength > 0 && SUCCEEDED(ren.renderTarget->CreateSolidColorBrush(ColorFrom3i(110, 110, 110), &grayBrush))) {
+		auto start = static_cast<UINT32>(m_cmdlineItem.text.length() - m_suggestionLength);
+		m_cmdlineItem.textLayout->SetDrawingEffect(grayBrush, DWRITE_TEXT_RANGE{ start, static_cast<UINT32>(m_suggestionLength) });
+	}
+
 	ren.renderTarget->DrawTextLayout(TopLeft(m_cmdlineItem.bbox), m_cmdlineItem.textLayout, ren.solidBrush);
 
+	SafeRelease(&grayBrush);
 	ren.RestoreBrushColor();
 }
 
@@ -465,7 +507,7 @@ void Console::DrawCaret()
 	DWRITE_HIT_TEST_METRICS htm;
 	float x, y;// caret position
 	m_cmdlineItem.textLayout->HitTestTextPosition(
-		m_promptStr.length() + m_console.caret(),
+		m_cmdlinePrefixLength + m_console.caret(),
 		isTrailingHit,
 		OUT &x,
 		OUT &y,
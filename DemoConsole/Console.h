@@ -69,6 +69,13 @@ public:
 	//	Returns true iff the console needs to be redrawn.
 	bool HandleKey(Key key, const ModKeyState &mod);
 
+	// HandlePaste inserts a text at the caret of the command line.
+	// The line breaks of the text are replaced by spaces.
+	//
+	// RETURN VALUE
+	//	Returns true iff the console needs to be redrawn.
+	bool HandlePaste(const std::wstring &text);
+
 	// RETURN VALUE
 	//	Returns true iff the console needs to be redrawn.
 	bool HandleMouseWheel(float mvt);
@@ -159,6 +166,12 @@ private:
 	ID2D1SolidColorBrush		*m_solidBrush{ nullptr };
 
 	std::wstring		m_promptStr;
+
+	// Length of the text shown before the command line: the prompt, or the reverse search.
+	size_t				m_cmdlinePrefixLength{ 0 };
+
+	// Length of the suggestion shown after the command line, in gray.
+	size_t				m_suggestionLength{ 0 };
 	RectF				m_rect;
 
 	static const float kScrollBarInitialWidth;
@@ -33,6 +33,12 @@ public:
 	{
 		return kLoremIpsumText;
 	}
+
+	// The text is written directly into the console output, without any intermediate copy.
+	void execute(const dbgutils::CmdArgViews &args, dbgutils::IOutputSink &out) override
+	{
+		out.write(kLoremIpsumText);
+	}
 };
 
 // A command that lists all the console commands installed in the interpreter.
@@ -46,32 +52,76 @@ public:
 	~CommandListCommands() = default;
 
 	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		return output_of(args);
+	}
+
+	void execute(const dbgutils::CmdArgViews &args, dbgutils::IOutputSink &out) override
 	{
 		if (!m_interpreter) {
-			return L"";
+			return;
 		}
 
 		const auto &commands = m_interpreter->GetCommands();
-		std::wstring out;
 
 		for (size_t i = 0; i < commands.size(); i++) {
 			const auto &cmd = commands[i];
 
-			out += cmd->Name();
+			out.write(cmd->Name());
 
 			if (cmd->Alias().length() >= 1) {
-				out += L" @" + cmd->Alias();
+				out.write(L" @");
+				out.write(cmd->Alias());
 			}
 
 			if (i + 1 < commands.size()) {
-				out += L"\n";
+				out.write(L"\n");
 			}
 		}
-
-		return out;
 	}
 
 private:
 	const dbgutils::Interpreter *m_interpreter;
 };
 
+
+// A command that shows the execution statistics of the console commands.
+//
+// Example
+//
+//	> stats			// show the statistics
+//	> stats clear	// reset the statistics
+//
+class CommandStats : public dbgutils::ICommand {
+public:
+	CommandStats(dbgutils::Interpreter *interpreter = nullptr)
+		: dbgutils::ICommand(L"stats", L"st")
+		, m_interpreter(interpreter)
+	{}
+
+	~CommandStats() = default;
+
+	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		return output_of(args);
+	}
+
+	void execute(const dbgutils::CmdArgViews &args, dbgutils::IOutputSink &out) override
+	{
+		if (!m_interpreter) {
+			return;
+		}
+
+		auto &profiler = m_interpreter->profiler();
+
+		if (args.size() >= 1 && args[0] == L"clear") {
+			profiler.clear();
+			return;
+		}
+
+		profiler.report(out);
+	}
+
+private:
+	dbgutils::Interpreter *m_interpreter;
+};
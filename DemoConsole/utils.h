@@ -8,4 +8,25 @@ inline D2D1::ColorF ColorFrom3i(int red, int green, int blue, int alpha = 255)
 inline bool is_key_down(WPARAM wParam)
 {
 	return GetAsyncKeyState((int)wParam) & 0x8000;
-}
\ No newline at end of file
+}
+
+// read_clipboard_text returns the text in the clipboard, or the empty string.
+inline std::wstring read_clipboard_text(HWND hwnd)
+{
+	std::wstring text;
+
+	if (!OpenClipboard(hwnd)) {
+		return text;
+	}
+
+	if (auto h = GetClipboardData(CF_UNICODETEXT)) {
+		if (auto p = static_cast<const wchar_t *>(GlobalLock(h))) {
+			text = p;
+			GlobalUnlock(h);
+		}
+	}
+
+	CloseClipboard();
+
+	return text;
+}
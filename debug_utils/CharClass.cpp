@@ -0,0 +1,217 @@
+#include "pch.h"
+#include "CharClass.h"
+
+namespace dbgutils {
+
+	// Generated by tools/gen_char_class.py (Unicode 14.0.0).
+	// kCharClassBlockBits (CharClass.h) must be 6.
+
+	const uint8_t kCharClassBlockIndex[1024] = {
+		0,1,2,3,4,4,4,4,4,4,4,5,4,6,7,8,4,4,9,4,10,11,12,13,14,15,4,16,17,18,19,20,
+		21,22,23,24,4,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,
+		4,52,53,54,4,4,4,4,4,55,56,57,58,59,60,61,62,4,4,4,4,4,4,4,4,63,64,65,66,67,4,68,
+		69,70,71,72,73,74,75,76,77,78,79,80,4,81,82,83,84,85,86,87,4,4,4,4,4,4,4,4,88,89,90,91,
+		92,93,94,95,96,97,98,99,99,99,99,99,99,99,99,99,100,101,102,103,99,99,99,99,99,99,99,99,99,104,105,99,
+		99,99,99,99,99,99,99,99,99,99,99,99,99,106,107,99,4,4,4,108,109,110,111,112,113,114,115,116,99,99,99,117,
+		118,119,120,121,122,4,123,124,125,126,127,99,99,99,99,99,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,99,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,128,
+		4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,129,130,4,4,4,4,131,132,4,133,134,4,135,136,
+		137,138,4,139,140,141,4,142,143,144,4,145,146,147,4,148,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+		4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+		4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+		4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+		4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+		4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,149,150,
+		4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+		151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,
+		151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,
+		151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,151,
+		151,151,151,151,128,128,128,128,128,152,128,153,154,155,156,157,4,4,4,4,158,159,160,161,162,163,4,164,165,166,167,168,
+	};
+
+	const uint8_t kCharClassBlocks[169][32] = {
+		{ 0x00,0x00,0x00,0x00,0x10,0x11,0x11,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x51,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x33,0x33,0x33,0x33,0x33,0x55,0x55,0x55 },
+		{ 0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x45,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x05 },
+		{ 0x00,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x51,0x55,0x55,0x55,0x55,0x52,0x05,0x55,0x55,0x22,0x25,0x55,0x25,0x52,0x22,0x52 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x22,0x22,0x52,0x55,0x55,0x55,0x52,0x52,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x00,0x22,0x22,0x25 },
+		{ 0x00,0x00,0x55,0x52,0x22,0x02,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x25,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x20,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x52,0x05,0x50,0x55,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x25 },
+		{ 0x25,0x52,0x22,0x25,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x20,0x22,0x52,0x05,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x00,0x00,0x00,0x55,0x55,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x52,0x50,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x33,0x33,0x33,0x33,0x33,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x25,0x22,0x22,0x22,0x02,0x25,0x22,0x22,0x22,0x22,0x52,0x22,0x22,0x22,0x33,0x33,0x33,0x33,0x33,0x22,0x52,0x25 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x02,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x02,0x20,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x05 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x05,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x25,0x22,0x22,0x02,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x33,0x33,0x33,0x33,0x33,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x20,0x22,0x22,0x22,0x02,0x20,0x02,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x02,0x00,0x22,0x22,0x00,0x22,0x22 },
+		{ 0x22,0x22,0x02,0x20,0x02,0x20,0x22,0x02,0x00,0x00,0x00,0x20,0x00,0x00,0x22,0x20,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x22,0x55,0x22,0x22,0x22,0x55,0x52,0x02 },
+		{ 0x20,0x22,0x20,0x22,0x22,0x02,0x00,0x20,0x02,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x20,0x02,0x22,0x00,0x02,0x22 },
+		{ 0x22,0x02,0x00,0x20,0x02,0x20,0x22,0x00,0x20,0x00,0x00,0x00,0x20,0x22,0x02,0x02,0x00,0x00,0x00,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22,0x05,0x00,0x00,0x00,0x00 },
+		{ 0x20,0x22,0x20,0x22,0x22,0x22,0x22,0x20,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x20,0x22,0x22,0x00,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x20,0x22,0x20,0x22,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x55,0x00,0x00,0x00,0x20,0x22,0x22,0x22 },
+		{ 0x20,0x22,0x20,0x22,0x22,0x22,0x02,0x20,0x02,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x20,0x22,0x22,0x00,0x22,0x22 },
+		{ 0x22,0x22,0x02,0x20,0x02,0x20,0x22,0x00,0x00,0x00,0x20,0x22,0x00,0x00,0x22,0x20,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x25,0x22,0x22,0x22,0x00,0x00,0x00,0x00 },
+		{ 0x00,0x22,0x20,0x22,0x22,0x02,0x00,0x22,0x02,0x22,0x22,0x00,0x20,0x02,0x02,0x22,0x00,0x20,0x02,0x00,0x22,0x02,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x22 },
+		{ 0x22,0x02,0x00,0x22,0x02,0x22,0x22,0x00,0x02,0x00,0x00,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x33,0x33,0x33,0x33,0x33,0x22,0x52,0x55,0x55,0x55,0x05,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x22,0x22 },
+		{ 0x22,0x22,0x02,0x22,0x02,0x22,0x22,0x00,0x00,0x00,0x20,0x02,0x22,0x02,0x20,0x00,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x00,0x50,0x22,0x22,0x22,0x52 },
+		{ 0x22,0x22,0x25,0x22,0x22,0x22,0x02,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x00,0x22,0x22 },
+		{ 0x22,0x22,0x02,0x22,0x02,0x22,0x22,0x00,0x00,0x00,0x20,0x02,0x00,0x00,0x20,0x02,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x20,0x02,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x02,0x22,0x02,0x22,0x22,0x52,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22,0x22,0x52,0x22,0x22,0x22 },
+		{ 0x20,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x22,0x22,0x20,0x00 },
+		{ 0x22,0x22,0x22,0x02,0x00,0x02,0x00,0x20,0x22,0x22,0x02,0x02,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x33,0x33,0x33,0x33,0x33,0x00,0x22,0x05,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x50 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x33,0x33,0x33,0x33,0x33,0x55,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x20,0x02,0x02,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00 },
+		{ 0x22,0x22,0x02,0x02,0x22,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x00,0x22,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x52,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x22,0x55,0x55,0x55,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22,0x22,0x22,0x25,0x25,0x25,0x55,0x55,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x52,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x55 },
+		{ 0x55,0x55,0x55,0x52,0x55,0x55,0x05,0x55,0x55,0x55,0x55,0x55,0x55,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x33,0x33,0x33,0x33,0x33,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x20,0x00,0x00,0x20,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x00,0x22,0x22,0x22,0x02,0x02,0x22,0x22,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x00,0x22,0x22,0x22,0x02 },
+		{ 0x02,0x22,0x22,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x20,0x22,0x55,0x55,0x55,0x55,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x00 },
+		{ 0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x21,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x05,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x05,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x02,0x22,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x25,0x55,0x55,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x25,0x22,0x20,0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00 },
+		{ 0x05,0x00,0x55,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x22,0x22,0x02,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x33,0x33,0x33,0x33,0x33,0x02,0x00,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x20 },
+		{ 0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x00,0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x00,0x55,0x55,0x55,0x25,0x55,0x55,0x55,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x33,0x33,0x33,0x33,0x33,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x25,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x05 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x55,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x50,0x55,0x55 },
+		{ 0x33,0x33,0x33,0x33,0x33,0x00,0x20,0x22,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x20,0x22 },
+		{ 0x55,0x55,0x55,0x55,0x00,0x00,0x00,0x00,0x22,0x52,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x22,0x20,0x20,0x20,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x52,0x52 },
+		{ 0x55,0x22,0x02,0x22,0x22,0x22,0x52,0x55,0x22,0x22,0x00,0x22,0x22,0x22,0x50,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x00,0x22,0x02,0x22,0x22,0x22,0x52,0x05 },
+		{ 0x11,0x11,0x11,0x11,0x11,0x01,0x00,0x00,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x11,0x00,0x00,0x10,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x45 },
+		{ 0x54,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x54,0x55,0x55,0x55,0x55,0x15,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x00,0x22,0x22,0x22,0x55,0x55,0x25 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x05,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x55,0x52,0x55,0x25,0x55,0x22,0x22,0x22,0x22,0x22,0x25,0x55,0x25,0x22,0x22,0x55,0x55,0x55,0x52,0x52,0x52,0x22,0x22,0x25,0x22,0x22,0x22,0x22,0x22,0x55,0x22,0x22 },
+		{ 0x55,0x55,0x25,0x22,0x22,0x55,0x55,0x52,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x55,0x00,0x00,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x00,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x50,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x55,0x25,0x22,0x22,0x22,0x22,0x00,0x00,0x50,0x55,0x25,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x00,0x00,0x20,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x20,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x20 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02 },
+		{ 0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x25,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x50,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x55,0x55,0x55,0x55,0x55,0x55,0x00,0x00 },
+		{ 0x51,0x55,0x25,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x25,0x22,0x22,0x55,0x22,0x22,0x52,0x55 },
+		{ 0x60,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66 },
+		{ 0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x06,0x20,0x52,0x65,0x66,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x22 },
+		{ 0x00,0x00,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x55,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x05,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x05,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x33,0x33,0x33,0x33,0x33,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x22,0x22,0x22,0x22,0x25 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x00,0x00,0x00,0x00 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x25,0x22,0x22,0x22,0x22,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x52,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x22,0x20,0x20,0x22,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x02,0x00,0x22,0x22,0x22,0x55,0x55,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x55,0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x25,0x25,0x22 },
+		{ 0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x00,0x50,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00 },
+		{ 0x52,0x55,0x55,0x55,0x55,0x55,0x55,0x20,0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x33,0x33,0x33,0x33,0x33,0x22,0x22,0x02 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x00,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x22,0x22,0x22 },
+		{ 0x22,0x02,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x22,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x22,0x22,0x02,0x00,0x00,0x00,0x00 },
+		{ 0x20,0x22,0x22,0x02,0x20,0x22,0x22,0x02,0x20,0x22,0x22,0x02,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x00,0x33,0x33,0x33,0x33,0x33,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x02,0x00,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x00 },
+		{ 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x00,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66 },
+		{ 0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+		{ 0x22,0x22,0x22,0x02,0x00,0x00,0x00,0x00,0x00,0x20,0x22,0x22,0x00,0x00,0x20,0x22,0x22,0x22,0x22,0x22,0x52,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x22,0x22,0x02,0x02 },
+		{ 0x22,0x20,0x02,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x00,0x00,0x00,0x50,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x55,0x55,0x55,0x55,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x55,0x45,0x54,0x55,0x55,0x55,0x55,0x55 },
+		{ 0x55,0x55,0x55,0x55,0x55,0x55,0x45,0x44,0x55,0x05,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x05,0x55,0x55,0x00,0x00,0x22,0x22,0x02,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02,0x00 },
+		{ 0x50,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x33,0x33,0x33,0x33,0x33,0x55,0x55,0x55,0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x45 },
+		{ 0x25,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x52,0x55,0x55,0x55,0x55,0x55,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22 },
+		{ 0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x02 },
+		{ 0x00,0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x00,0x22,0x22,0x22,0x00,0x22,0x02,0x00,0x55,0x55,0x55,0x05,0x55,0x55,0x55,0x05,0x00,0x00,0x00,0x00,0x00,0x00,0x55,0x00 },
+	};
+
+	static_assert(sizeof(kCharClassBlockIndex) == (0x10000 >> kCharClassBlockBits), "Regenerate the table.");
+}
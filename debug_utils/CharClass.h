@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dbgutils {
+
+	// CHAR_CLASS is the class of a character, for the whitespace and word segmentation.
+	// The classes are a coarse version of the word break properties of Unicode:
+	// a word is a run of letters, digits and connectors, and every ideograph is a word.
+	enum CHAR_CLASS {
+		CHAR_CLASS_OTHER,		// controls, format characters, unassigned code points
+		CHAR_CLASS_SPACE,		// the Unicode White_Space property
+		CHAR_CLASS_LETTER,		// letters, combining marks, letter-like numbers
+		CHAR_CLASS_DIGIT,		// decimal digits
+		CHAR_CLASS_CONNECTOR,	// connector punctuation such as '_'
+		CHAR_CLASS_PUNCT,		// other punctuation and symbols
+		CHAR_CLASS_IDEOGRAPH	// CJK ideographs and Hiragana
+	};
+
+	// The table of the classes of the BMP characters, in two levels: kCharClassBlockIndex maps
+	// each block of 64 characters to a row of kCharClassBlocks, and the identical blocks share
+	// their row. A row holds two classes per byte. See CharClass.cpp.
+	constexpr int kCharClassBlockBits = 6;
+	extern const uint8_t kCharClassBlockIndex[];
+	extern const uint8_t kCharClassBlocks[][(1 << kCharClassBlockBits) / 2];
+
+	// char_class returns the class of a character. Outside the BMP (wchar_t of 32 bits),
+	// the characters are classified as letters.
+	inline CHAR_CLASS char_class(wchar_t c)
+	{
+		auto u = static_cast<uint32_t>(c);
+		if (u > 0xffff) {
+			return CHAR_CLASS_LETTER;
+		}
+
+		auto row = kCharClassBlocks[kCharClassBlockIndex[u >> kCharClassBlockBits]];
+		auto i = u & ((1u << kCharClassBlockBits) - 1);
+
+		return static_cast<CHAR_CLASS>((row[i >> 1] >> ((i & 1) * 4)) & 0xf);
+	}
+
+	// is_white_space returns true iff a character has the Unicode White_Space property.
+	inline bool is_white_space(wchar_t c)
+	{
+		return char_class(c) == CHAR_CLASS_SPACE;
+	}
+
+	// word_group returns the class of a character as far as the word breaks are concerned:
+	// the word characters (letters, digits and connectors) and the punctuation form
+	// separate runs, and every ideograph is a word of its own. The other characters,
+	// such as the format characters and the surrogates, go with the word characters.
+	inline CHAR_CLASS word_group(wchar_t c)
+	{
+		// The group of each class, in the order of CHAR_CLASS.
+		static constexpr CHAR_CLASS kGroups[] = {
+			CHAR_CLASS_LETTER, CHAR_CLASS_SPACE, CHAR_CLASS_LETTER, CHAR_CLASS_LETTER,
+			CHAR_CLASS_LETTER, CHAR_CLASS_PUNCT, CHAR_CLASS_IDEOGRAPH
+		};
+
+		return kGroups[char_class(c)];
+	}
+
+	// is_word_break returns true iff there is a word break between two groups of characters
+	// (see word_group), i.e. iff two consecutive characters belong to different words or spaces.
+	inline bool is_word_break(CHAR_CLASS prevGroup, CHAR_CLASS group)
+	{
+		return prevGroup != group || group == CHAR_CLASS_IDEOGRAPH;
+	}
+
+	inline bool is_word_break(wchar_t prev, wchar_t c)
+	{
+		return is_word_break(word_group(prev), word_group(c));
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace dbgutils {
+
+	// A multiplicative hash, fed field by field so that the padding is not hashed.
+	// It takes a few cycles per field: the checksums of the files are computed for
+	// every record.
+	class Checksum {
+	public:
+		Checksum &add(uint64_t value)
+		{
+			m_hash = (m_hash ^ value) * 0x9e3779b97f4a7c15ull;
+			m_hash ^= m_hash >> 29;
+			return *this;
+		}
+
+		// This overload hashes a block of memory, 8 bytes at a time.
+		Checksum &add(const void *data, size_t size)
+		{
+			auto p = static_cast<const unsigned char *>(data);
+			for (; size >= 8; p += 8, size -= 8) {
+				uint64_t word;
+				std::memcpy(&word, p, 8);
+				add(word);
+			}
+
+			uint64_t tail = 0;
+			std::memcpy(&tail, p, size);
+			return add(tail ^ (static_cast<uint64_t>(size) << 56));
+		}
+
+		uint32_t value() const { return static_cast<uint32_t>(m_hash >> 32); }
+
+	private:
+		uint64_t m_hash{ 0xcbf29ce484222325ull };
+	};
+}
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "CommandLine.h"
+#include "string_utils.h"
 
 namespace dbgutils {
 
@@ -34,6 +35,26 @@ namespace dbgutils {
 		return cur_editbox().handle_character(c);
 	}
 
+	bool CommandLine::insert_text(std::wstring_view text, LINE_BREAK_MODE mode)
+	{
+		if (mode == LINE_BREAK_MODE_JOIN) {
+			return cur_editbox().insert_text(text);
+		}
+
+		std::vector<std::wstring_view> lines;
+		wstr_split_lines(text, &lines);
+
+		// Every line but the last one is followed by a line break.
+		auto changed = false;
+		for (size_t i = 0; i + 1 < lines.size(); i++) {
+			changed |= cur_editbox().insert_text(lines[i]);
+			changed |= handle_enter_key();
+		}
+		changed |= cur_editbox().insert_text(lines.back());
+
+		return changed;
+	}
+
 	bool CommandLine::handle_key(Key key)
 	{
 		bool changed = false;
@@ -69,7 +90,7 @@ namespace dbgutils {
 	{
 		m_history.reset_iteration();
 		m_history.go_to_previous();
-		auto entry = m_history.get();
+		auto entry = std::wstring(m_history.get());
 		m_history.reset_iteration();
 
 		return entry;
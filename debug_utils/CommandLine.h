@@ -24,6 +24,10 @@ namespace dbgutils {
 		bool handle_character(wchar_t c);
 		bool handle_key(Key key);
 
+		// insert_text inserts a string at the caret (e.g. a clipboard paste).
+		// See LINE_BREAK_MODE for the handling of the line breaks.
+		bool insert_text(std::wstring_view text, LINE_BREAK_MODE mode = LINE_BREAK_MODE_JOIN);
+
 	private:
 		const EditBox & cur_editbox() const;
 		EditBox & cur_editbox();
@@ -0,0 +1,185 @@
+#include "pch.h"
+#include "CommandProfiler.h"
+#include <cassert>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include "Interpreter.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace dbgutils {
+
+	// msb returns the index of the most significant bit set in x, which must not be 0.
+	static int msb(uint64_t x)
+	{
+		assert(x != 0);
+
+#ifdef _MSC_VER
+		unsigned long i;
+		_BitScanReverse64(&i, x);
+		return static_cast<int>(i);
+#else
+		return 63 - __builtin_clzll(x);
+#endif
+	}
+
+	int LatencyHistogram::bucket_index(uint64_t ns)
+	{
+		// The smallest durations get one bucket each.
+		if (ns < kSubBuckets) {
+			return static_cast<int>(ns);
+		}
+
+		// Then each power of two is split into kSubBuckets buckets.
+		auto m = msb(ns);
+		auto sub = static_cast<int>((ns >> (m - kSubBucketBits)) & (kSubBuckets - 1));
+
+		return (m - kSubBucketBits + 1) * kSubBuckets + sub;
+	}
+
+	uint64_t LatencyHistogram::bucket_upper_bound(int i)
+	{
+		assert(0 <= i && i < kNumBuckets);
+
+		if (i < kSubBuckets) {
+			return static_cast<uint64_t>(i);
+		}
+
+		auto m = i / kSubBuckets + kSubBucketBits - 1;
+		auto sub = static_cast<uint64_t>(i % kSubBuckets);
+		auto width = uint64_t(1) << (m - kSubBucketBits);
+		auto lower = (kSubBuckets + sub) * width;
+
+		return lower + (width - 1);
+	}
+
+	void LatencyHistogram::record(uint64_t ns)
+	{
+		m_buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+		m_count.fetch_add(1, std::memory_order_relaxed);
+		m_total.fetch_add(ns, std::memory_order_relaxed);
+
+		auto curMax = m_max.load(std::memory_order_relaxed);
+		while (ns > curMax && !m_max.compare_exchange_weak(curMax, ns, std::memory_order_relaxed)) {
+		}
+	}
+
+	void LatencyHistogram::clear()
+	{
+		for (auto &bucket : m_buckets) {
+			bucket.store(0, std::memory_order_relaxed);
+		}
+		m_count.store(0, std::memory_order_relaxed);
+		m_total.store(0, std::memory_order_relaxed);
+		m_max.store(0, std::memory_order_relaxed);
+	}
+
+	uint64_t LatencyHistogram::percentile(double p) const
+	{
+		assert(0. <= p && p <= 1.);
+
+		auto n = count();
+		if (n == 0) {
+			return 0;
+		}
+
+		// Rank of the percentile, between 1 and n.
+		auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * n + 0.5));
+
+		uint64_t cumulated = 0;
+		for (int i = 0; i < kNumBuckets; i++) {
+			cumulated += m_buckets[i].load(std::memory_order_relaxed);
+			if (cumulated >= rank) {
+				return std::min(bucket_upper_bound(i), max());
+			}
+		}
+
+		// Only reached if the histogram is being recorded into by another thread.
+		return max();
+	}
+
+	uint64_t CommandProfiler::steady_clock_ns()
+	{
+		using namespace std::chrono;
+
+		return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	const CommandStats *CommandProfiler::find_stats(const ICommand &cmd) const
+	{
+		auto it = m_stats.find(&cmd);
+		if (it == m_stats.end()) {
+			return nullptr;
+		}
+
+		return it->second.get();
+	}
+
+	CommandStats *CommandProfiler::stats_for(const ICommand &cmd)
+	{
+		if (!m_enabled) {
+			return nullptr;
+		}
+
+		auto &stats = m_stats[&cmd];
+		if (!stats) {
+			stats = std::make_unique<CommandStats>();
+		}
+
+		return stats.get();
+	}
+
+	void CommandProfiler::clear()
+	{
+		for (auto &s : m_stats) {
+			s.second->clear();
+		}
+	}
+
+	void CommandProfiler::report(IOutputSink &out) const
+	{
+		using Row = std::pair<const ICommand *, const CommandStats *>;
+
+		std::vector<Row> rows;
+		for (const auto &s : m_stats) {
+			if (s.second->exec.count() > 0) {
+				rows.push_back(Row{ s.first, s.second.get() });
+			}
+		}
+
+		std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+			return a.second->exec.total() > b.second->exec.total();
+		});
+
+		auto us = [](uint64_t ns) { return ns / 1000.; };
+
+		std::wostringstream s;
+		s << std::fixed << std::setprecision(1);
+		s << std::left << std::setw(16) << L"command" << std::right
+			<< std::setw(10) << L"calls"
+			<< std::setw(14) << L"total (us)"
+			<< std::setw(14) << L"tokens (us)"
+			<< std::setw(12) << L"p50 (us)"
+			<< std::setw(12) << L"p99 (us)"
+			<< std::setw(12) << L"max (us)";
+
+		for (const auto &row : rows) {
+			const auto &exec = row.second->exec;
+
+			s << L"\n" << std::left << std::setw(16) << row.first->Name() << std::right
+				<< std::setw(10) << exec.count()
+				<< std::setw(14) << us(exec.total())
+				<< std::setw(14) << us(row.second->tokenizeTotal.load(std::memory_order_relaxed))
+				<< std::setw(12) << us(exec.percentile(0.5))
+				<< std::setw(12) << us(exec.percentile(0.99))
+				<< std::setw(12) << us(exec.max());
+		}
+
+		out.write(s.str());
+	}
+}
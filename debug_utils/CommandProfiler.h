@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "OutputSink.h"
+
+namespace dbgutils {
+
+	class ICommand;
+
+	//							LATENCY HISTOGRAM
+	//
+	// A histogram of durations in nanoseconds with log-linear buckets:
+	// each power of two is split into kSubBuckets buckets, hence the relative
+	// error of a percentile is at most 1 / kSubBuckets.
+	//
+	// The counters are relaxed atomics so a histogram can be recorded into
+	// from any thread while being read by another one.
+	class LatencyHistogram {
+	public:
+		static constexpr int kSubBucketBits = 2;
+		static constexpr int kSubBuckets = 1 << kSubBucketBits;
+		static constexpr int kNumBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+		//		ACCESSORS
+		//
+		uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+		uint64_t total() const { return m_total.load(std::memory_order_relaxed); }
+		uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+
+		// percentile returns an upper bound of the p-th percentile (0 <= p <= 1)
+		// of the recorded durations. It returns 0 if the histogram is empty.
+		uint64_t percentile(double p) const;
+
+		//		MANIPULATORS
+		//
+		void record(uint64_t ns);
+
+		// clear resets the counters to 0.
+		void clear();
+
+		// Helpers mapping the durations to the buckets.
+		static int bucket_index(uint64_t ns);
+		static uint64_t bucket_upper_bound(int i);
+
+	private:
+		std::atomic<uint32_t>	m_buckets[kNumBuckets]{};
+		std::atomic<uint64_t>	m_count{ 0 };
+		std::atomic<uint64_t>	m_total{ 0 };
+		std::atomic<uint64_t>	m_max{ 0 };
+	};
+
+	// CommandStats are the execution statistics of a single command.
+	// The call count and the total execution time are held by the histogram.
+	struct CommandStats {
+		// Time spent splitting the command lines into tokens.
+		std::atomic<uint64_t>	tokenizeTotal{ 0 };
+
+		// Time spent executing the command.
+		LatencyHistogram		exec;
+
+		void record(uint64_t tokenizeNs, uint64_t execNs)
+		{
+			tokenizeTotal.fetch_add(tokenizeNs, std::memory_order_relaxed);
+			exec.record(execNs);
+		}
+
+		void clear()
+		{
+			tokenizeTotal.store(0, std::memory_order_relaxed);
+			exec.clear();
+		}
+	};
+
+	//							COMMAND PROFILER
+	//
+	// The profiler owns the statistics of the commands executed by an interpreter.
+	// The statistics of a command are allocated on its first profiled execution,
+	// and live as long as the profiler.
+	//
+	// REMARKS
+	//	stats_for must only be called by the thread owning the interpreter.
+	//	The returned CommandStats can however be recorded into from any thread,
+	//	which is how the asynchronous commands are profiled.
+	class CommandProfiler {
+	public:
+		CommandProfiler() = default;
+
+		// A copy of a profiler starts with no statistics.
+		CommandProfiler(const CommandProfiler &other)
+			: m_enabled(other.m_enabled)
+		{}
+
+		CommandProfiler &operator=(const CommandProfiler &other)
+		{
+			m_enabled = other.m_enabled;
+			m_stats.clear();
+			return *this;
+		}
+
+		CommandProfiler(CommandProfiler &&) = default;
+		CommandProfiler &operator=(CommandProfiler &&) = default;
+
+		// steady_clock_ns returns the time elapsed since an arbitrary epoch.
+		static uint64_t steady_clock_ns();
+
+		//		ACCESSORS
+		//
+		bool enabled() const { return m_enabled; }
+
+		// find_stats returns the statistics of a command or nullptr if it was never profiled.
+		const CommandStats *find_stats(const ICommand &cmd) const;
+
+		// report writes a table with the statistics of the commands executed since they
+		// were cleared, sorted by decreasing total execution time.
+		void report(IOutputSink &out) const;
+
+		//		MANIPULATORS
+		//
+		void set_enabled(bool enabled) { m_enabled = enabled; }
+
+		// stats_for returns the statistics of a command, allocating them if needed.
+		// It returns nullptr if the profiler is disabled.
+		CommandStats *stats_for(const ICommand &cmd);
+
+		// clear resets the statistics of all the commands. They are not deallocated: the
+		// commands being executed, including a command clearing the profiler and the
+		// asynchronous ones, record into them when they complete.
+		void clear();
+
+	private:
+		bool	m_enabled{ true };
+
+		std::unordered_map<const ICommand *, std::unique_ptr<CommandStats>>	m_stats;
+	};
+}
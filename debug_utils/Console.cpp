@@ -1,12 +1,14 @@
 #include "pch.h"
 #include "Console.h"
+#include <algorithm>
+#include "string_utils.h"
 
 namespace dbgutils {
 
-	Console::Console(Interpreter interpreter, size_t historyCapacity, size_t outputCapacity)
+	Console::Console(Interpreter interpreter, size_t historyCapacity, size_t outputCapacity, size_t outputByteBudget)
 		: m_interpreter(interpreter)
 		, m_history(historyCapacity)
-		, m_output(outputCapacity)
+		, m_output(outputByteBudget, outputCapacity)
 	{
 		clear_editboxes_and_set_up_new_one();
 	}
@@ -15,36 +17,100 @@ namespace dbgutils {
 	{
 		// Clear
 		m_editboxes.clear();
-		m_i = 0;
+		m_depth = 0;
 
 		// Set up a new one
-		m_editboxes.push_back(EditBox());
+		m_editboxes.emplace(0, EditBox());
 	}
 
-	const std::wstring & Console::cmdline() const
+	std::wstring_view Console::cmdline() const
 	{
-		return cur_editbox().content();
+		auto *editbox = find_editbox();
+		if (editbox) {
+			return editbox->content();
+		}
+
+		return m_history.get();
+	}
+
+	GapBuffer::Segments Console::cmdline_segments() const
+	{
+		auto *editbox = find_editbox();
+		if (editbox) {
+			return editbox->segments();
+		}
+
+		return GapBuffer::Segments{ m_history.get(), std::wstring_view() };
 	}
 
 	size_t Console::caret() const
 	{
-		return cur_editbox().caret();
+		auto *editbox = find_editbox();
+		if (editbox) {
+			return editbox->caret();
+		}
+
+		// The caret is at the end of a recalled entry.
+		return m_history.get().length();
 	}
 
 	std::wstring Console::get_output(size_t i) const
+	{
+		return std::wstring(get_output_view(i));
+	}
+
+	std::wstring_view Console::get_output_view(size_t i) const
 	{
 		assert(0 <= i && i < output_size());
 
-		return m_output.peek(m_output.size() - 1 - i);
+		if (is_output_pending(i)) {
+			return kPendingOutputText;
+		}
+
+		return m_output.get(output_seq(i));
+	}
+
+	bool Console::is_output_pending(size_t i) const
+	{
+		assert(0 <= i && i < output_size());
+
+		return m_output.is_pending(output_seq(i));
+	}
+
+	std::wstring_view Console::suggestion() const
+	{
+		if (m_searching || m_depth > 0) {
+			return std::wstring_view();
+		}
+
+		// The command line is read in place, without copying it out of the edit box.
+		auto line = cmdline_segments();
+		auto length = line.first.length() + line.second.length();
+		std::wstring_view command;
+		if (length == 0 || caret() != length || !m_history.ranking().suggest(line.first, line.second, &command)) {
+			return std::wstring_view();
+		}
+
+		return command.substr(length);
 	}
 
 	bool Console::handle_character(IN wchar_t c)
 	{
+		if (m_searching) {
+			// The shown entry may still match the longer pattern.
+			m_searchPattern += c;
+			return search_history(m_history.end_seq() - m_depth + (m_depth > 0 ? 1 : 0));
+		}
+
 		return cur_editbox().handle_character(c);
 	}
 
 	bool Console::handle_key(Key key, const ModKeyState &mod)
 	{
+		if (m_searching) {
+			return handle_search_key(key, mod);
+		}
+
 		bool changed = false;
 
 		switch (key) {
@@ -56,17 +122,133 @@ namespace dbgutils {
 
 		case VK_DOWN:	changed = handle_down_key();
 			break;
+
+		case 'R':		changed = mod.ctrl ? begin_search() : handle_editbox_key(key, mod);
+			break;
+
+		case VK_RIGHT:
+		case VK_END:	changed = accept_suggestion() || handle_editbox_key(key, mod);
+			break;
 		
-		default:		changed = cur_editbox().handle_key(key, mod);
+		default:		changed = handle_editbox_key(key, mod);
 			break;
 		}
 
 		return changed;
 	}
 
+	bool Console::handle_editbox_key(Key key, const ModKeyState &mod)
+	{
+		// The caret of a recalled entry is at its end, and it has nothing to undo: only these
+		// keys can change it. The others, e.g. shift or ctrl+z, leave it shared with the history.
+		if (!find_editbox()) {
+			auto edits = key == VK_LEFT || key == VK_HOME || key == VK_BACK;
+			if (!edits || m_history.get().empty()) {
+				return false;
+			}
+		}
+
+		return cur_editbox().handle_key(key, mod);
+	}
+
+	bool Console::insert_text(std::wstring_view text, LINE_BREAK_MODE mode)
+	{
+		if (m_searching) {
+			end_search(m_depth);
+		}
+
+		if (mode == LINE_BREAK_MODE_JOIN) {
+			return cur_editbox().insert_text(text);
+		}
+
+		std::vector<std::wstring_view> lines;
+		wstr_split_lines(text, &lines);
+
+		// Every line but the last one is followed by a line break.
+		auto changed = false;
+		for (size_t i = 0; i + 1 < lines.size(); i++) {
+			changed |= cur_editbox().insert_text(lines[i]);
+			changed |= handle_enter_key();
+		}
+		changed |= cur_editbox().insert_text(lines.back());
+
+		return changed;
+	}
+
+	bool Console::update()
+	{
+		auto changed = false;
+
+		auto it = std::remove_if(m_pending.begin(), m_pending.end(), [this, &changed](PendingOutput &p) {
+			if (!p.result->done.load(std::memory_order_acquire)) {
+				return false;
+			}
+
+			// The placeholder may have been evicted by newer outputs in the meantime,
+			// in which case the output is dropped.
+			if (m_output.contains(p.seq)) {
+				m_output.begin_write(p.seq);
+				for (const auto &chunk : p.result->text) {
+					m_output.write(chunk);
+				}
+				end_output_write(p.seq);
+				changed = true;
+			}
+
+			return true;
+		});
+		m_pending.erase(it, m_pending.end());
+
+		// Messages from the log channel.
+		m_logBatch.clear();
+		if (m_log.drain(&m_logBatch) > 0) {
+			for (const auto &msg : m_logBatch) {
+				auto seq = m_output.push();
+				m_output.begin_write(seq);
+				m_output.write(msg.text);
+				end_output_write(seq);
+			}
+			changed = true;
+		}
+
+		// The entries of the other processes renumber the history, so they wait until the
+		// command line is a new one, and no recalled entry has been edited.
+		if (!m_searching && m_depth == 0 && m_editboxes.size() == 1) {
+			m_history.merge_shared();
+		}
+
+		return changed;
+	}
+
+	size_t Console::map_outputs_to_file(const std::filesystem::path &path)
+	{
+		assert(!m_outputFile && "The outputs are already mapped to a file.");
+
+		m_outputFile = std::make_unique<MappedOutputRing>(path, output_byte_budget(), output_capacity());
+
+		auto records = m_outputFile->records();
+		for (const auto &record : records) {
+			m_output.begin_write(m_output.push());
+			m_output.write(record.text);
+			m_output.end_write();
+		}
+
+		return records.size();
+	}
+
+	size_t Console::open_history_journal(const std::filesystem::path &path)
+	{
+		return m_history.open_journal(path);
+	}
+
+	size_t Console::open_shared_history(const std::filesystem::path &path)
+	{
+		return m_history.open_shared(path);
+	}
+
 	bool Console::handle_enter_key()
 	{
-		m_lastCmdlineStr = cmdline();
+		m_lastCmdlineStr.assign(cmdline());
 
 		if (cmdline_is_empty()) {
 			return false;
@@ -83,78 +265,255 @@ namespace dbgutils {
 
 	void Console::exec_cmdline_and_store_output()
 	{
-		auto output = m_interpreter.execute(cmdline());
+		auto cmd = m_interpreter.find_command_in(cmdline());
+		if (cmd && cmd->is_async()) {
+			exec_async_cmd(cmd);
+			return;
+		}
+
+		// Let the command write its output directly into the store.
+		auto seq = m_output.push();
+		m_output.begin_write(seq);
+		m_interpreter.execute(cmdline(), m_output);
+		end_output_write(seq);
+	}
+
+	void Console::exec_async_cmd(const std::shared_ptr<ICommand> &cmd)
+	{
+		// Reserve the output now to keep the outputs in submission order.
+		auto seq = m_output.push(true);
 
-		m_output.push_back(output);
+		auto result = std::make_shared<AsyncResult>();
+		m_pending.push_back(PendingOutput{ seq, result });
+
+		if (!m_workers) {
+			m_workers = std::make_unique<WorkerPool>(kNumAsyncWorkers);
+		}
+
+		// The job owns everything it uses since the command line is about to be cleared.
+		// The statistics are not: they live as long as the interpreter, which outlives the workers.
+		auto *stats = m_interpreter.profiler().stats_for(*cmd);
+
+		m_workers->submit([cmd, result, stats, line = std::wstring(cmdline())]() {
+			Interpreter::run_command(*cmd, line, result->text, stats);
+			result->done.store(true, std::memory_order_release);
+		});
+	}
+
+	void Console::end_output_write(uint64_t seq)
+	{
+		m_output.end_write();
+
+		if (m_outputFile && m_output.contains(seq)) {
+			m_outputFile->append(m_output.get(seq));
+		}
 	}
 
 	void Console::add_cmdline_to_history_and_reset_iteration()
 	{
 		// We do not add the command line string if it is the exact same
 		// as the latest history entry.
+		auto line = cmdline();
+		if (!m_history.empty() && m_history.entry(m_history.end_seq() - 1) == line) {
+			m_history.reset_iteration();
+			return;
+		}
 
-		// Get the top entry
-		m_history.reset_iteration();
-		m_history.go_to_previous();
-		auto topEntry = m_history.get();
+		// The command line may be a view on a history entry, which the push moves.
+		if (m_depth > 0 && find_editbox() == nullptr) {
+			m_history.push(std::wstring(line));
+		}
+		else {
+			m_history.push(line);
+		}
+	}
 
-		// Reset
-		m_history.reset_iteration();
+	bool Console::accept_suggestion()
+	{
+		auto completion = suggestion();
 
-		// Add
-		if (topEntry != cmdline()) {
-			m_history.push(cmdline());
+		return !completion.empty() && cur_editbox().insert_text(completion);
+	}
+
+	void Console::set_history_duplicates(HISTORY_DUPLICATES duplicates)
+	{
+		// The removed entries move the shown one: back to the new command line.
+		if (m_searching) {
+			end_search(0);
 		}
+		m_editboxes.erase(m_editboxes.upper_bound(0), m_editboxes.end());
+		show_history_entry(0);
+
+		m_history.set_duplicates(duplicates);
 	}
 
 	bool Console::handle_up_key()
 	{
-		// Go to the previous editbox from our temporary list.
-		if (m_i + 1 < m_editboxes.size()) {// Are we at the last editbox of our temporary list?
-			++m_i;
+		if (m_navigation == HISTORY_NAVIGATION_PREFIX && m_depth == 0) {
+			m_navPrefix = cmdline();
+		}
+
+		if (navigates_by_prefix()) {
+			uint64_t seq;
+			if (!m_history.find_previous_with_prefix(m_navPrefix, m_history.end_seq() - m_depth, &seq)) {
+				return false;
+			}
+			show_history_entry(static_cast<size_t>(m_history.end_seq() - seq));
 			return true;
 		}
 
-		// Try to get a previous entry from the history.
+		// The iteration ptr of the history follows the command line.
 		auto ev = m_history.go_to_previous();
 		if (ev != ConsoleHistory::ITEREVENT_AT_NEW_ENTRY) {
 			// We were at the oldest entry in the history already so we do nothing.
 			return false;
 		}
 
-		// Here the history iteration ptr points to a previous/older entry
-		// that we encounter for the first time.
-		m_editboxes.push_back(EditBox(m_history.get()));
-		m_i++;
+		// The entry is shown through a view: nothing is copied until it is edited.
+		m_depth++;
 		return true;
 	}
 
 	bool Console::handle_down_key()
 	{
-		if (m_i == 0) {
+		if (m_depth == 0) {
 			return false;
 		}
 
-		--m_i;
+		if (navigates_by_prefix()) {
+			// After the latest matching entry, back to the typed command line.
+			uint64_t seq;
+			auto found = m_history.find_next_with_prefix(m_navPrefix, m_history.end_seq() - m_depth, &seq);
+			show_history_entry(found ? static_cast<size_t>(m_history.end_seq() - seq) : 0);
+			return true;
+		}
+
+		m_history.go_to_next();
+		m_depth--;
 		return true;
 	}
 
-	const EditBox & Console::cur_editbox() const
+	bool Console::navigates_by_prefix() const
+	{
+		// An empty prefix matches every entry: the regular navigation does the same.
+		return m_navigation == HISTORY_NAVIGATION_PREFIX && !m_navPrefix.empty();
+	}
+
+	bool Console::handle_search_key(Key key, const ModKeyState &mod)
 	{
-		assert(m_i < m_editboxes.size());
+		assert(m_searching);
 
-		return m_editboxes[m_i];
+		switch (key) {
+		case 'R':
+			if (!mod.ctrl || m_searchPattern.empty()) {
+				return false;
+			}
+			// The previous match.
+			return search_history(m_history.end_seq() - m_depth);
+
+		case VK_BACK:
+			if (m_searchPattern.empty()) {
+				return false;
+			}
+			m_searchPattern.pop_back();
+			return search_history(m_history.end_seq());
+
+		case 'G':
+			return mod.ctrl && end_search(m_searchStartDepth);
+
+		case VK_ESCAPE:
+			return end_search(m_searchStartDepth);
+
+		case VK_RETURN:
+			end_search(m_depth);
+			return handle_enter_key();
+
+		// The caret movements leave the search with the shown entry.
+		case VK_LEFT:
+		case VK_RIGHT:
+		case VK_HOME:
+		case VK_END:
+		case VK_UP:
+		case VK_DOWN:
+			end_search(m_depth);
+			handle_key(key, mod);
+			return true;
+
+		// The other keys (modifiers, or characters also sent to handle_character) are ignored.
+		default:
+			return false;
+		}
+	}
+
+	bool Console::begin_search()
+	{
+		m_searching = true;
+		m_searchPattern.clear();
+		m_searchFailed = false;
+		m_searchStartDepth = m_depth;
+
+		// The match is not related to the prefix: the navigation goes on from it through all the entries.
+		m_navPrefix.clear();
+
+		return true;
+	}
+
+	bool Console::end_search(size_t depth)
+	{
+		m_searching = false;
+		m_searchPattern.clear();
+		m_searchFailed = false;
+		show_history_entry(depth);
+
+		return true;
+	}
+
+	bool Console::search_history(uint64_t before)
+	{
+		uint64_t seq;
+		m_searchFailed = !m_history.find_previous(m_searchPattern, before, &seq);
+		if (!m_searchFailed) {
+			show_history_entry(static_cast<size_t>(m_history.end_seq() - seq));
+		}
+
+		return true;
+	}
+
+	void Console::show_history_entry(size_t depth)
+	{
+		m_depth = depth;
+
+		if (depth > 0) {
+			m_history.go_to(m_history.end_seq() - depth);
+		}
+		else {
+			m_history.reset_iteration();
+		}
+	}
+
+	const EditBox * Console::find_editbox() const
+	{
+		auto it = m_editboxes.find(m_depth);
+
+		return it != m_editboxes.end() ? &it->second : nullptr;
 	}
 
 	EditBox & Console::cur_editbox()
 	{
-		assert(m_i < m_editboxes.size());
+		auto it = m_editboxes.find(m_depth);
+		if (it == m_editboxes.end()) {
+			// First edit of a recalled entry: give it a private copy.
+			assert(m_depth > 0);
+			it = m_editboxes.emplace(m_depth, EditBox(m_history.get())).first;
+		}
 
-		return m_editboxes[m_i];
+		return it->second;
 	}
 
 	bool Console::cmdline_is_empty() const
 	{
-		return cmdline().length() == 0;
+		auto line = cmdline_segments();
+
+		return line.first.empty() && line.second.empty();
 	}
 }
\ No newline at end of file
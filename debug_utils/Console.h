@@ -2,11 +2,18 @@
 
 #include <vector>
 #include <string>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <filesystem>
 #include "Key.h"
 #include "ConsoleHistory.h"
 #include "EditBox.h"
 #include "Interpreter.h"
-#include "OvwRingBuf.h"
+#include "OutputStore.h"
+#include "MappedOutputRing.h"
+#include "WorkerPool.h"
+#include "LogChannel.h"
 
 #define IN
 #define OUT
@@ -30,14 +37,45 @@ namespace dbgutils {
 	//	CONSOLE_EVENT_CMDLINE_EXECUTED		= 8
 	//};
 
+	// HISTORY_NAVIGATION tells which history entries the up and down arrow keys go through.
+	enum HISTORY_NAVIGATION {
+		// All the entries, one by one.
+		HISTORY_NAVIGATION_ALL,
+
+		// The entries starting with the command line typed before the first up arrow key, if
+		// it is not empty. The down arrow key goes back to it after the latest matching entry.
+		HISTORY_NAVIGATION_PREFIX
+	};
+
 	class Console {
 	public:
-		Console(Interpreter interpreter = Interpreter(), size_t historyCapacity = 32, size_t outputCapacity = 32);
+		// Output of an asynchronous command until it completes.
+		static constexpr const wchar_t *kPendingOutputText = L"...";
+
+		// Number of threads executing the asynchronous commands.
+		static constexpr size_t kNumAsyncWorkers = 2;
+
+		// The outputs are bounded both by a number of outputs (outputCapacity)
+		// and by the memory used by their text (outputByteBudget).
+		Console(
+			Interpreter interpreter = Interpreter(),
+			size_t historyCapacity = 32,
+			size_t outputCapacity = 32,
+			size_t outputByteBudget = 1024 * 1024);
 
 		//		ACCESSORS
 		//
 		// cmdline returns the string in the command line.
-		const std::wstring &cmdline() const;
+		//
+		// REMARKS
+		//	The view is invalidated by the next call to a manipulator.
+		//	The text of an edit box is copied out of its gap buffer the first time it is
+		//	requested after a change: cmdline_segments does not copy it.
+		std::wstring_view cmdline() const;
+
+		// cmdline_segments returns the command line in two parts, whose concatenation is
+		// the string of cmdline. The views are invalidated by the next call to a manipulator.
+		GapBuffer::Segments cmdline_segments() const;
 
 		auto *get_interpreter() { return &m_interpreter; }
 
@@ -52,12 +90,38 @@ namespace dbgutils {
 		// caret returns the position of the caret in the command line string.
 		size_t caret() const;
 
+		// suggestion returns the completion of the command line by the best-ranked command
+		// of the history starting with it (see FrecencyRanking), to be shown after the caret
+		// as ghost text. It is empty unless the caret is at the end of a new, non-empty command
+		// line. The right arrow and End keys accept it. It costs O(command line length).
+		//
+		// REMARKS
+		//	The view is invalidated by the next call to a manipulator.
+		std::wstring_view suggestion() const;
+
+		// is_searching returns true iff the console is in reverse search mode (see handle_key).
+		bool is_searching() const { return m_searching; }
+
+		// search_pattern returns the text searched in the history, in reverse search mode.
+		std::wstring_view search_pattern() const { return m_searchPattern; }
+
+		// search_failed returns true iff no history entry contains the search pattern.
+		// The command line then shows the latest match of a shorter pattern.
+		bool search_failed() const { return m_searchFailed; }
+
+		auto history_navigation() const { return m_navigation; }
+
+		auto history_duplicates() const { return m_history.duplicates(); }
+
 		// output_size returns the number of strings stored in the output buffer.
 		size_t output_size() const { return m_output.size(); }
 
 		// output_capacity returns the maximum number of strings that the ouput buffer can store.
 		size_t output_capacity() const { return m_output.capacity(); }
 
+		// output_byte_budget returns the maximum amount of memory used by the text of the outputs.
+		size_t output_byte_budget() const { return m_output.byte_budget(); }
+
 		// get_output returns a specific output string.
 		//
 		// INPUT
@@ -69,28 +133,166 @@ namespace dbgutils {
 		//		the odlest command.
 		std::wstring get_output(size_t i) const;
 
+		// get_output_view returns a specific output without copying it.
+		// See get_output for the meaning of the index.
+		//
+		// REMARKS
+		//	The view is invalidated by the next command, update, or log message.
+		std::wstring_view get_output_view(size_t i) const;
+
+		// is_output_pending returns true iff a specific output belongs to an asynchronous
+		// command that has not completed yet. See get_output for the meaning of the index.
+		bool is_output_pending(size_t i) const;
+
+		// num_pending_outputs returns the number of asynchronous commands that have not
+		// been collected by update yet.
+		size_t num_pending_outputs() const { return m_pending.size(); }
+
+		// log_channel returns the channel through which any thread can send messages
+		// to the output buffer. The messages are moved into the output buffer by update.
+		LogChannel &log_channel() { return m_log; }
+
 		//		MANIPULATORS
 		//
 		// All handle_xxx functions return true iff the command line content or the caret changed.
+		//
+		// REVERSE SEARCH
+		//	Ctrl+R enters the reverse search mode: the typed characters go into a search pattern
+		//	instead of the command line, which shows the latest history entry containing the
+		//	pattern. Each character narrows the search, from the shown entry towards the oldest
+		//	ones; Backspace removes one and searches again from the latest entry.
+		//	Ctrl+R again shows the previous match. Enter executes the shown entry, Escape or
+		//	Ctrl+G restores the command line shown before the search, and the caret movement
+		//	keys leave the search mode with the shown entry in the command line.
+		//	In search mode, the functions return true iff the search state or the command line
+		//	changed, except Enter which returns true iff a command line was executed.
 		bool handle_character(IN wchar_t c);
 		bool handle_key(Key key, const ModKeyState &mod = ModKeyState());
 
+		// insert_text inserts a string at the caret (e.g. a clipboard paste) in a single splice.
+		// See LINE_BREAK_MODE for the handling of the line breaks: with LINE_BREAK_MODE_SUBMIT,
+		// the lines are executed as a batch, in order, as if ENTER/RETURN was pressed after each.
+		bool insert_text(std::wstring_view text, LINE_BREAK_MODE mode = LINE_BREAK_MODE_JOIN);
+
+		// update replaces the placeholders of the completed asynchronous commands by their output
+		// and moves the messages received by the log channel into the output buffer, one output each.
+		// With a shared history, it also adds the command lines executed by the other processes
+		// to the history, unless a history entry is shown or has been edited.
+		// It should be called regularly (e.g. once per frame) by the thread handling the input.
+		//
+		// RETURN VALUE
+		//	Returns true iff at least one output changed.
+		bool update();
+
+		// map_outputs_to_file makes the outputs survive a crash of the process by also writing
+		// them into a memory-mapped file (see MappedOutputRing). The outputs recovered from the
+		// file, if any, are added to the output buffer, from the oldest to the latest.
+		// The file is sized from the output capacity and byte budget of the console.
+		//
+		// RETURN VALUE
+		//	Returns the number of recovered outputs.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened or mapped.
+		//
+		// REMARKS
+		//	It should be called once, before executing commands: the outputs already in the
+		//	output buffer are not written into the file.
+		size_t map_outputs_to_file(const std::filesystem::path &path);
+
+		// set_history_navigation changes the entries browsed by the up and down arrow keys.
+		// The navigation in progress, if any, goes on from the shown entry through all the entries.
+		void set_history_navigation(HISTORY_NAVIGATION navigation)
+		{
+			m_navigation = navigation;
+			m_navPrefix.clear();
+		}
+
+		// set_history_duplicates changes what the history does with the older entries equal
+		// to an executed command line (see HISTORY_DUPLICATES). The command line goes back to
+		// the new one, since the removed entries renumber the shown one.
+		// With HISTORY_DUPLICATES_KEEP, an entry equal to the latest one is not added.
+		void set_history_duplicates(HISTORY_DUPLICATES duplicates);
+
+		// open_history_journal makes the history survive a restart of the process by also
+		// appending the executed command lines to a journal file (see HistoryJournal).
+		// The command lines loaded from the file, if any, are added to the history.
+		//
+		// RETURN VALUE
+		//	Returns the number of loaded command lines.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened.
+		//
+		// REMARKS
+		//	It should be called once, before executing commands.
+		size_t open_history_journal(const std::filesystem::path &path);
+
+		// open_shared_history shares the history with the consoles of other processes through a
+		// shared file (see SharedHistory): the executed command lines are appended to the file,
+		// and update picks up the ones of the other processes. The latest command lines of the
+		// file, if any, are added to the history.
+		//
+		// RETURN VALUE
+		//	Returns the number of loaded command lines.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened or mapped.
+		//
+		// REMARKS
+		//	It should be called once, before executing commands.
+		size_t open_shared_history(const std::filesystem::path &path);
+
 	private:
-		const EditBox & cur_editbox() const;
+		// find_editbox returns the edit box of the command line, or nullptr if it shows
+		// a history entry which has not been edited.
+		const EditBox * find_editbox() const;
+
+		// cur_editbox returns the edit box of the command line, and creates the private
+		// edit box of a history entry the first time it is edited.
 		EditBox & cur_editbox();
 
+		// handle_editbox_key passes a key to the edit box of the command line. A recalled
+		// entry gets its private edit box only if the key changes its text or its caret.
+		bool handle_editbox_key(Key key, const ModKeyState &mod);
+
 		// ENTER/RETURN key press handling.
 		// Execute the command line.
 		bool handle_enter_key();
 		void exec_cmdline_and_store_output();
+		void exec_async_cmd(const std::shared_ptr<ICommand> &cmd);
 		void add_cmdline_to_history_and_reset_iteration();
 
 		bool handle_up_key();
 		bool handle_down_key();
 
+		// accept_suggestion appends the suggestion, if any, to the command line.
+		bool accept_suggestion();
+
+		// Prefix navigation (see HISTORY_NAVIGATION_PREFIX).
+		bool navigates_by_prefix() const;
+
+		// Reverse search.
+		bool handle_search_key(Key key, const ModKeyState &mod);
+		bool begin_search();
+		bool end_search(size_t depth);
+
+		// search_history shows the latest entry before a given one which contains the
+		// search pattern, if any.
+		bool search_history(uint64_t before);
+
+		// show_history_entry shows the history entry at a given depth (see m_depth).
+		void show_history_entry(size_t depth);
+
 		void clear_editboxes_and_set_up_new_one();
 		bool cmdline_is_empty() const;
 
+		// end_output_write closes the output being written and copies it into the file, if any.
+		void end_output_write(uint64_t seq);
+
+		// output_seq returns the sequence number of an output from its index (see get_output).
+		uint64_t output_seq(size_t i) const { return m_output.end_seq() - 1 - i; }
+
 	private:
 		// Command interpreter.
 		Interpreter					m_interpreter;
@@ -99,17 +301,63 @@ namespace dbgutils {
 		// when the user presses the ENTER/RETURN key.
 		ConsoleHistory				m_history;
 
-		// These editboxes are used to manage the command line.
-		// When the user presses the UP key to look up in the history,
-		// a new edit box is created and becomes the current one.
-		std::vector<EditBox>		m_editboxes;
-		size_t						m_i{ 0 };
+		// The command line shows the new command line (m_depth = 0) or the m_depth-th latest
+		// history entry, which is the one pointed by the iteration ptr of the history.
+		// A history entry is shown through a view until it is edited (caret movements
+		// included). It then gets a private edit box, indexed by its depth, which keeps
+		// the edits until the command line is executed.
+		std::map<size_t, EditBox>	m_editboxes;
+		size_t						m_depth{ 0 };
+
+		// Entries browsed by the up and down arrow keys, and the prefix of the entries of the
+		// prefix navigation: the command line when the first up arrow key was pressed.
+		HISTORY_NAVIGATION			m_navigation{ HISTORY_NAVIGATION_ALL };
+		std::wstring				m_navPrefix;
 
-		// Output strings generated by the interpreter and commands
+		// Outputs generated by the interpreter and commands
 		// when the user presses the ENTER/RETURN key.
-		OvwRingBuf<std::wstring>	m_output;
+		// The commands write their output directly into the store.
+		OutputStore					m_output;
+
+		// Optional copy of the outputs which survives a crash of the process.
+		std::unique_ptr<MappedOutputRing>	m_outputFile;
+
+		// Output of an asynchronous command, written by a worker thread.
+		struct AsyncResult {
+			std::atomic<bool>	done{ false };
+			ChunkedText			text;
+		};
+
+		// Asynchronous commands that have not been collected by update yet.
+		// Their pending output is found with the sequence number, so the outputs
+		// stay in submission order whatever the completion order is.
+		struct PendingOutput {
+			uint64_t						seq;
+			std::shared_ptr<AsyncResult>	result;
+		};
+		std::vector<PendingOutput>	m_pending;
+
+		// Messages sent by other threads, and the batch in which they are drained.
+		// The batch is kept from one update to the next to reuse its memory.
+		LogChannel					m_log;
+		std::vector<LogMessage>		m_logBatch;
+
+		// Reverse search mode. The matched entry is the one shown by the command line, and the
+		// depth of the command line before the search is kept to restore it.
+		bool			m_searching{ false };
+		std::wstring	m_searchPattern;
+		bool			m_searchFailed{ false };
+		size_t			m_searchStartDepth{ 0 };
 
 		// TEMPORARY
 		std::wstring	m_lastCmdlineStr;
+
+		// Threads executing the asynchronous commands.
+		// They are created with the first asynchronous command.
+		//
+		// REMARKS
+		//	This member is declared last so that it is destroyed first: the destructor
+		//	waits for the running commands before the rest of the console is destroyed.
+		std::unique_ptr<WorkerPool>	m_workers;
 	};
 }
\ No newline at end of file
@@ -1,13 +1,132 @@
 #include "pch.h"
 #include "ConsoleHistory.h"
+#include <algorithm>
 
 namespace dbgutils {
 
-	void ConsoleHistory::push(const std::wstring &line)
+	// Smallest arena, in characters.
+	static constexpr size_t kMinArenaLength = 256;
+
+	void ConsoleHistory::push(std::wstring_view line)
 	{
+		insert(line);
+
+		if (m_journal) {
+			m_journal->append(line);
+		}
+		if (m_shared) {
+			m_shared->append(line);
+		}
+	}
+
+	size_t ConsoleHistory::open_journal(const std::filesystem::path &path)
+	{
+		assert(!m_journal && "The history already has a journal.");
+
+		std::vector<std::wstring> records;
+		m_journal = std::make_unique<HistoryJournal>(path, m_capacity, &records);
+
+		for (const auto &record : records) {
+			insert(record);
+		}
+
+		return records.size();
+	}
+
+	size_t ConsoleHistory::open_shared(const std::filesystem::path &path)
+	{
+		assert(!m_shared && "The history is already shared.");
+
+		std::vector<std::wstring> records;
+		m_shared = std::make_unique<SharedHistory>(path, m_capacity, &records);
+
+		for (const auto &record : records) {
+			insert(record);
+		}
+
+		return records.size();
+	}
+
+	size_t ConsoleHistory::merge_shared()
+	{
+		if (!m_shared || m_shared->poll(&m_sharedBatch) == 0) {
+			return 0;
+		}
+
+		for (const auto &line : m_sharedBatch) {
+			insert(line);
+		}
+
+		return m_sharedBatch.size();
+	}
+
+	void ConsoleHistory::set_duplicates(HISTORY_DUPLICATES duplicates)
+	{
+		if (duplicates == m_duplicates) {
+			return;
+		}
+		m_duplicates = duplicates;
+		m_dupIndex.clear();
+
+		if (duplicates == HISTORY_DUPLICATES_ERASE_OLDER) {
+			// From the latest entry, so that the latest of the duplicates is kept.
+			for (auto seq = end_seq(); seq > begin_seq(); seq--) {
+				// The removal takes the entry out of the index, like any indexed entry.
+				auto text = entry(seq - 1);
+				uint64_t later;
+				auto duplicate = m_dupIndex.find(*this, text, &later);
+				m_dupIndex.insert(id_of(seq - 1), text);
+				if (duplicate) {
+					remove(seq - 1);
+				}
+			}
+		}
+
+		reset_iteration();
+	}
+
+	void ConsoleHistory::insert(std::wstring_view line)
+	{
+		m_ranking.add(line);
+
+		if (m_duplicates == HISTORY_DUPLICATES_ERASE_OLDER) {
+			uint64_t id;
+			if (m_dupIndex.find(*this, line, &id)) {
+				remove(seq_of(id));
+			}
+		}
+
 		auto wasFull = full();
 
-		m_buf[m_top] = line;
+		// The oldest entry is overwritten when the history is full.
+		auto first = wasFull ? ptr_next(m_bottom) : m_bottom;
+		auto count = wasFull ? m_size - 1 : m_size;
+		auto tail = count > 0 ? m_buf[first].start : m_head;
+
+		// The text of the oldest entry is still in the arena until the new text is placed.
+		if (wasFull) {
+			const auto &oldest = m_buf[m_bottom];
+			if (m_indexed) {
+				m_index.remove(oldest.id, std::wstring_view(arena_at(oldest.start), oldest.length));
+			}
+			m_prefixIndex.erase(*this, oldest.id);
+			if (m_duplicates == HISTORY_DUPLICATES_ERASE_OLDER) {
+				m_dupIndex.erase(oldest.id, std::wstring_view(arena_at(oldest.start), oldest.length));
+			}
+		}
+
+		auto entry = Entry{ place(line.length(), tail, first, count), m_nextId, static_cast<uint32_t>(line.length()) };
+		std::copy(line.begin(), line.end(), arena_at(entry.start));
+		m_head = entry.start + entry.length;
+
+		// The ring grows until it is full: m_top is then its end.
+		if (m_buf.size() < m_capacity) {
+			assert(m_top == m_buf.size());
+			m_buf.push_back(entry);
+		}
+		else {
+			m_buf[m_top] = entry;
+		}
 		increment_ptr(&m_top);
 
 		if (wasFull) {
@@ -17,16 +136,246 @@ namespace dbgutils {
 			m_size++;
 		}
 
+		m_endSeq++;
+		auto id = m_nextId++;
+
+		if (m_indexed) {
+			m_index.add(id, line);
+		}
+		if (m_duplicates == HISTORY_DUPLICATES_ERASE_OLDER) {
+			m_dupIndex.insert(id, line);
+		}
+		m_prefixIndex.insert(*this, id);
+
+		reset_iteration();
+	}
+
+	void ConsoleHistory::remove(uint64_t seq)
+	{
+		assert(begin_seq() <= seq && seq < end_seq());
+
+		auto dedup = m_duplicates == HISTORY_DUPLICATES_ERASE_OLDER;
+
+		// The indexes are updated before the ring moves. The ids of the later entries
+		// do not change.
+		auto text = entry(seq);
+		auto id = id_of(seq);
+		if (m_indexed) {
+			m_index.erase(id, text);
+		}
+		m_prefixIndex.erase(*this, id);
+		if (dedup) {
+			m_dupIndex.erase(id, text);
+		}
+
+		// The later entries move down by one slot, by runs of contiguous slots. The text
+		// of the removed entry stays in the arena until the next compaction.
+		auto i = slot_of(seq);
+		for (auto count = static_cast<size_t>(end_seq() - seq - 1); count > 0;) {
+			auto next = ptr_next(i);
+			auto run = next == 0 ? 1 : std::min(count, m_capacity - next);
+			std::move(m_buf.begin() + next, m_buf.begin() + next + run, m_buf.begin() + i);
+			i = next + run - 1;
+			count -= run;
+		}
+		decrement_ptr(&m_top);
+
+		// The ring grows until it is full: m_top is then its end.
+		if (m_buf.size() < m_capacity) {
+			m_buf.pop_back();
+		}
+
+		m_size--;
+		m_endSeq--;
+
 		reset_iteration();
 	}
 
-	std::wstring ConsoleHistory::get() const
+	uint64_t ConsoleHistory::place(size_t length, uint64_t tail, size_t first, size_t count)
+	{
+		auto arenaLength = m_arenaLength;
+		auto live = static_cast<size_t>(m_head - tail);
+
+		if (arenaLength == 0 || live + length > arenaLength) {
+			compact(std::max(arenaLength + arenaLength / 2, live + length + kMinArenaLength), first, count);
+			return m_head;
+		}
+
+		// The text does not cross the end of the arena.
+		auto start = m_head;
+		auto offset = static_cast<size_t>(start % arenaLength);
+		if (offset + length > arenaLength) {
+			start += arenaLength - offset;
+
+			// The head starts a new lap.
+			if (live * 4 < arenaLength && arenaLength > kMinArenaLength) {
+				compact(std::max(2 * (live + length), kMinArenaLength), first, count);
+				return m_head;
+			}
+		}
+
+		if (start + length - tail > arenaLength) {
+			compact(std::max(arenaLength + arenaLength / 2, live + length + kMinArenaLength), first, count);
+			return m_head;
+		}
+
+		return start;
+	}
+
+	void ConsoleHistory::compact(size_t arenaLength, size_t first, size_t count)
+	{
+		std::unique_ptr<wchar_t[]> arena(new wchar_t[arenaLength]);
+
+		uint64_t pos = 0;
+		for (size_t k = 0, i = first; k < count; k++, i = ptr_next(i)) {
+			auto &entry = m_buf[i];
+			std::copy(arena_at(entry.start), arena_at(entry.start) + entry.length, arena.get() + pos);
+			entry.start = pos;
+			pos += entry.length;
+		}
+
+		m_arena = std::move(arena);
+		m_arenaLength = arenaLength;
+		m_head = pos;
+	}
+
+	void ConsoleHistory::build_index() const
+	{
+		assert(!m_indexed && m_index.size() == 0);
+
+		// The ids increase from the oldest entry to the latest one, as the index requires.
+		for (auto seq = begin_seq(); seq < end_seq(); seq++) {
+			m_index.add(id_of(seq), entry(seq));
+		}
+		m_indexed = true;
+	}
+
+	uint64_t ConsoleHistory::seq_of(uint64_t id) const
+	{
+		assert(!empty());
+
+		// Without removals since the oldest entry, the ids follow the numbers.
+		auto oldestId = id_of(begin_seq());
+		auto guess = begin_seq() + (id - oldestId);
+		if (id >= oldestId && guess < end_seq() && id_of(guess) == id) {
+			return guess;
+		}
+
+		// Otherwise the ids increase from the oldest entry to the latest one.
+		uint64_t lo = begin_seq();
+		uint64_t hi = end_seq();
+		while (lo < hi) {
+			auto mid = lo + (hi - lo) / 2;
+			if (m_buf[slot_of(mid)].id < id) {
+				lo = mid + 1;
+			}
+			else {
+				hi = mid;
+			}
+		}
+
+		assert(lo < end_seq() && m_buf[slot_of(lo)].id == id);
+		return lo;
+	}
+
+	std::wstring_view ConsoleHistory::entry(uint64_t seq) const
+	{
+		const auto &e = m_buf[slot_of(seq)];
+
+		return std::wstring_view(arena_at(e.start), e.length);
+	}
+
+	bool ConsoleHistory::find_previous(std::wstring_view pattern, uint64_t before, OUT uint64_t *seq) const
+	{
+		assert(seq != nullptr);
+
+		before = std::min(before, end_seq());
+
+		if (before <= begin_seq()) {
+			return false;
+		}
+
+		// Every entry contains the empty pattern.
+		if (pattern.empty()) {
+			*seq = before - 1;
+			return true;
+		}
+
+		// The trigram index works with the ids of the entries. The candidates hold all the
+		// trigrams of the pattern, not necessarily in order; a shorter pattern is indexed
+		// by itself.
+		if (!m_indexed) {
+			build_index();
+		}
+
+		auto beforeId = before < end_seq() ? m_buf[slot_of(before)].id : m_nextId;
+		TrigramIndex::Search search(m_index, pattern);
+		uint64_t candidate;
+		while (search.previous(beforeId, &candidate)) {
+			auto s = seq_of(candidate);
+			if (entry(s).find(pattern) != std::wstring_view::npos) {
+				*seq = s;
+				return true;
+			}
+			beforeId = candidate;
+		}
+
+		return false;
+	}
+
+	bool ConsoleHistory::find_previous_with_prefix(std::wstring_view prefix, uint64_t before, OUT uint64_t *seq) const
+	{
+		assert(seq != nullptr);
+
+		if (before <= begin_seq()) {
+			return false;
+		}
+
+		// The prefix index works with the ids of the entries.
+		auto beforeId = before < end_seq() ? id_of(before) : m_nextId;
+		uint64_t id;
+		if (!m_prefixIndex.find_previous(*this, prefix, beforeId, &id)) {
+			return false;
+		}
+
+		*seq = seq_of(id);
+		return true;
+	}
+
+	bool ConsoleHistory::find_next_with_prefix(std::wstring_view prefix, uint64_t after, OUT uint64_t *seq) const
+	{
+		assert(seq != nullptr);
+
+		if (empty() || after + 1 >= end_seq()) {
+			return false;
+		}
+
+		// The oldest entry is the first one after an evicted one.
+		if (after < begin_seq()) {
+			if (entry(begin_seq()).substr(0, prefix.length()) == prefix) {
+				*seq = begin_seq();
+				return true;
+			}
+			after = begin_seq();
+		}
+
+		uint64_t id;
+		if (!m_prefixIndex.find_next(*this, prefix, id_of(after), &id)) {
+			return false;
+		}
+
+		*seq = seq_of(id);
+		return true;
+	}
+
+	std::wstring_view ConsoleHistory::get() const
 	{
 		if (it_inside_stack()) {
-			return m_buf[m_it];
+			const auto &entry = m_buf[m_it];
+			return std::wstring_view(arena_at(entry.start), entry.length);
 		}
 		else {
-			return L"";
+			return std::wstring_view();
 		}
 	}
 
@@ -1,17 +1,68 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
+#include "DuplicateIndex.h"
+#include "FrecencyRanking.h"
+#include "HistoryJournal.h"
+#include "PrefixIndex.h"
+#include "SharedHistory.h"
+#include "TrigramIndex.h"
 
 namespace dbgutils {
 
-	//	
+	// HISTORY_DUPLICATES tells what a history does with the older entries which have the
+	// same text as a pushed one.
+	enum HISTORY_DUPLICATES {
+		// They are kept.
+		HISTORY_DUPLICATES_KEEP,
+
+		// They are removed, so the pushed entry is moved to the top and the entries are
+		// distinct: the history holds more commands.
+		HISTORY_DUPLICATES_ERASE_OLDER
+	};
+
+	//							CONSOLE HISTORY
+	//
+	// The ConsoleHistory keeps the latest command lines, up to a fixed number of entries.
+	//
+	// The text of the entries is kept in a single ring of wide characters (the arena), and
+	// a ring of offsets indexes it, so nothing is allocated per entry. Both grow on demand,
+	// so a history with a large capacity costs nothing until it is filled.
+	//
+	// The entries are evicted in push order, so the live text is a contiguous part of the
+	// arena, between the text of the oldest entry and the head. The text of an entry is never
+	// split by the end of the arena: it starts over at the beginning instead.
+	// When the new text does not fit, the arena grows by half and the live text is compacted
+	// at its beginning. Once per lap of the head, the arena is compacted into a smaller one
+	// if the live text takes less than a quarter of it.
+	//
+	// The entries are numbered in push order, and indexed by their trigrams (see TrigramIndex)
+	// for the reverse search, and by their text (see PrefixIndex) for the prefix navigation.
+	// The trigram index is the largest part of the history, so it is only built by the first
+	// reverse search: a history which is never searched does not pay for it.
+	//
+	// An entry removed from the middle (see HISTORY_DUPLICATES) leaves a hole in the arena,
+	// which is reclaimed by the next compaction. The later entries move down by one position
+	// in the ring, so their number decreases by one. The indexes identify the entries by an
+	// id which does not change instead: the push count, kept with the entry (see id_of).
+	// A removal only moves the offsets of the later entries, and leaves the indexes alone.
+	//
+	// The pushed entries are also ranked by frecency (see FrecencyRanking), for the suggestions
+	// of the console. The ranking outlives the entries: it counts every push.
+	//
+	// The entries can be persisted in a journal file (see HistoryJournal), which is loaded
+	// back by the next process, or shared with the histories of other processes through a
+	// shared file (see SharedHistory).
 	class ConsoleHistory {
 	public:
 		ConsoleHistory(size_t capacity)
 			: m_capacity(capacity)
-			, m_buf(capacity)
 		{
 			assert(capacity >= 1);
 		}
@@ -34,17 +85,133 @@ namespace dbgutils {
 
 		bool empty() const { return m_size == 0; }
 
+		auto duplicates() const { return m_duplicates; }
+
+		// begin_seq and end_seq return the number of the oldest entry, and the number of
+		// the next pushed entry. The entries are numbered from 0 in push order, and the
+		// removal of an entry renumbers the later ones, so the numbers are contiguous.
+		uint64_t begin_seq() const { return m_endSeq - m_size; }
+		uint64_t end_seq() const { return m_endSeq; }
+
+		// entry returns the text of an entry from its number.
+		//
+		// REMARKS
+		//	The view is invalidated by the next call to push.
+		std::wstring_view entry(uint64_t seq) const;
+
+		// id_of returns the id of an entry from its number, and seq_of the number of an entry
+		// from its id, by a binary search. The id of an entry is the number of entries pushed
+		// before it: unlike the number, it does not change when an older entry is removed.
+		uint64_t id_of(uint64_t seq) const { return m_buf[slot_of(seq)].id; }
+		uint64_t seq_of(uint64_t id) const;
+
+		// entry_by_id returns the text of an entry from its id.
+		std::wstring_view entry_by_id(uint64_t id) const { return entry(seq_of(id)); }
+
+		// find_previous returns the latest entry before a given one whose text contains
+		// a pattern. The search goes through the trigram index, whatever the length of the
+		// pattern.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		//
+		// REMARKS
+		//	The first search with a non-empty pattern builds the trigram index, so the history
+		//	must not be searched from several threads, although the function is const.
+		bool find_previous(std::wstring_view pattern, uint64_t before, OUT uint64_t *seq) const;
+
+		// find_previous_with_prefix returns the latest entry before a given one whose text
+		// starts with a prefix.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		bool find_previous_with_prefix(std::wstring_view prefix, uint64_t before, OUT uint64_t *seq) const;
+
+		// find_next_with_prefix returns the oldest entry after a given one whose text
+		// starts with a prefix.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		bool find_next_with_prefix(std::wstring_view prefix, uint64_t after, OUT uint64_t *seq) const;
+
+		// ranking returns the frecency ranking of the pushed entries.
+		const FrecencyRanking &ranking() const { return m_ranking; }
+
+		// journal returns the journal of the history, or nullptr if there is none.
+		const HistoryJournal *journal() const { return m_journal.get(); }
+
+		// shared returns the shared file of the history, or nullptr if there is none.
+		const SharedHistory *shared() const { return m_shared.get(); }
+
+		// memory_usage returns the number of bytes allocated by the history.
+		size_t memory_usage() const
+		{
+			return m_arenaLength * sizeof(wchar_t) + m_buf.capacity() * sizeof(Entry)
+				+ m_index.memory_usage() + m_prefixIndex.memory_usage() + m_dupIndex.memory_usage()
+				+ m_ranking.memory_usage();
+		}
 
 		//		MANIPULATORS
 		//
 
+		// set_duplicates changes what is done with the duplicates of the pushed entries.
+		// With HISTORY_DUPLICATES_ERASE_OLDER, the older duplicates already in the history
+		// are removed, and the iteration is reset.
+		void set_duplicates(HISTORY_DUPLICATES duplicates);
+
 		// push inserts a new entry in the history, which becomes the latest one, and
-		// resets the iteration.
-		void push(const std::wstring &line);
+		// resets the iteration. See HISTORY_DUPLICATES for the older entries with the same text.
+		//
+		// REMARKS
+		//	The line must not be a view on an entry of the history.
+		void push(std::wstring_view line);
+
+		// open_journal persists the history in a journal file: the entries loaded from the
+		// file, if any, are added to the history, from the oldest to the latest, and the next
+		// pushed entries are appended to the file.
+		// The file keeps the duplicates: they are removed again when they are loaded, so
+		// fewer entries than the capacity may be loaded.
+		//
+		// RETURN VALUE
+		//	Returns the number of loaded entries.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened.
+		//
+		// REMARKS
+		//	It should be called once, before pushing entries: the entries already in the
+		//	history are not written into the file.
+		size_t open_journal(const std::filesystem::path &path);
+
+		// open_shared shares the history with the histories of other processes through a
+		// shared file: the latest entries of the file, if any, are added to the history, from
+		// the oldest to the latest, and the next pushed entries are appended to the file.
+		//
+		// RETURN VALUE
+		//	Returns the number of loaded entries.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened or mapped.
+		//
+		// REMARKS
+		//	It should be called once, before pushing entries: the entries already in the
+		//	history are not written into the file.
+		size_t open_shared(const std::filesystem::path &path);
+
+		// merge_shared adds the entries appended to the shared file by the other processes
+		// since the previous call, like pushed entries, without writing them into the file.
+		// It costs an atomic load when there is none (see SharedHistory::poll).
+		//
+		// RETURN VALUE
+		//	Returns the number of added entries.
+		size_t merge_shared();
 
 		// get returns an entry pointed by the iteration ptr if it is defined.
 		// If it is undefined, get returns the empty string.
-		std::wstring get() const;
+		//
+		// REMARKS
+		//	The view is invalidated by the next call to push.
+		std::wstring_view get() const;
 
 		// ITEREVENTs are returned by the two iteration functions
 		// go_to_previous() and got_to_next().
@@ -83,8 +250,33 @@ namespace dbgutils {
 		{
 			m_iterationPtrInsideStack = false;
 		}
+
+		// go_to moves the iteration ptr to an entry from its number.
+		void go_to(uint64_t seq)
+		{
+			assert(begin_seq() <= seq && seq < end_seq());
+
+			m_iterationPtrInsideStack = true;
+			m_it = slot_of(seq);
+		}
 		
 	private:
+		// insert adds an entry to the ring, without writing it into the journal or the shared file.
+		void insert(std::wstring_view line);
+
+		// remove takes an entry out of the ring, and renumbers the later ones.
+		void remove(uint64_t seq);
+
+		// slot_of returns the position of an entry in the ring from its number.
+		size_t slot_of(uint64_t seq) const
+		{
+			assert(begin_seq() <= seq && seq < end_seq());
+
+			// Both terms are below the capacity: no division.
+			auto slot = m_bottom + static_cast<size_t>(seq - begin_seq());
+			return slot < m_capacity ? slot : slot - m_capacity;
+		}
+
 		//		Iteration ptr functions
 		//
 		void point_at_the_latest_entry()
@@ -166,7 +358,60 @@ namespace dbgutils {
 		bool		m_iterationPtrInsideStack{ false };// is the iteration ptr defined?
 		size_t		m_it;
 
-		// Underlying vector containing the entries.
-		std::vector<std::wstring>	m_buf;
+		// Text of an entry. The positions in the arena are logical: they grow with every
+		// push, and the character at position p is m_arena[p % m_arenaLength].
+		struct Entry {
+			uint64_t	start;
+			uint64_t	id;
+			uint32_t	length;
+		};
+
+		wchar_t *arena_at(uint64_t pos) const { return m_arena.get() + pos % m_arenaLength; }
+
+		// place returns the position of the text of a new entry, growing or compacting
+		// the arena if needed. The live text starts at the position tail; the count entries
+		// from the first one are kept.
+		uint64_t place(size_t length, uint64_t tail, size_t first, size_t count);
+
+		// build_index adds all the entries to the trigram index. It is called by the first
+		// search, and the index then follows the changes of the history.
+		void build_index() const;
+
+		// compact moves the text of the count entries from the first one at the beginning
+		// of a new arena.
+		void compact(size_t arenaLength, size_t first, size_t count);
+
+		// Ring of the entries. It grows up to the capacity, then wraps around.
+		std::vector<Entry>		m_buf;
+
+		// Ring of the text of the entries, and the position of the next text.
+		// The arena is not initialized: only the text of the entries is read.
+		std::unique_ptr<wchar_t[]>	m_arena;
+		size_t						m_arenaLength{ 0 };
+		uint64_t					m_head{ 0 };
+
+		// Number of the next entry, id of the next entry (the number of pushed entries),
+		// and the indexes of their text.
+		uint64_t		m_endSeq{ 0 };
+		uint64_t		m_nextId{ 0 };
+		PrefixIndex		m_prefixIndex;
+
+		// The trigram index, and whether it was built (see build_index).
+		mutable TrigramIndex	m_index;
+		mutable bool			m_indexed{ false };
+
+		// The entries by text, with HISTORY_DUPLICATES_ERASE_OLDER only.
+		HISTORY_DUPLICATES	m_duplicates{ HISTORY_DUPLICATES_KEEP };
+		DuplicateIndex		m_dupIndex;
+
+		FrecencyRanking		m_ranking;
+
+		// Optional copy of the entries which survives a restart of the process.
+		std::unique_ptr<HistoryJournal>	m_journal;
+
+		// Optional file shared with the histories of other processes, and the batch in which
+		// their entries are read. The batch is kept from one merge to the next to reuse its memory.
+		std::unique_ptr<SharedHistory>	m_shared;
+		std::vector<std::wstring>		m_sharedBatch;
 	};
 }
@@ -0,0 +1,103 @@
+#include "pch.h"
+#include "DuplicateIndex.h"
+#include <algorithm>
+#include <cassert>
+#include "Checksum.h"
+#include "ConsoleHistory.h"
+
+namespace dbgutils {
+
+	// Smallest table, in slots.
+	static constexpr size_t kMinSlots = 16;
+
+	uint32_t DuplicateIndex::hash_of(std::wstring_view text)
+	{
+		return Checksum().add(text.data(), text.length() * sizeof(wchar_t)).value();
+	}
+
+	size_t DuplicateIndex::slot_of(uint64_t id, uint32_t hash) const
+	{
+		assert(!m_slots.empty());
+
+		auto i = hash & mask();
+		while (m_slots[i].id != id) {
+			assert(m_slots[i].id != kEmpty && "The entry is not in the index.");
+			i = (i + 1) & mask();
+		}
+
+		return i;
+	}
+
+	void DuplicateIndex::place(const Slot &slot)
+	{
+		auto i = slot.hash & mask();
+		while (m_slots[i].id != kEmpty) {
+			i = (i + 1) & mask();
+		}
+
+		m_slots[i] = slot;
+	}
+
+	bool DuplicateIndex::find(const ConsoleHistory &history, std::wstring_view text, OUT uint64_t *id) const
+	{
+		assert(id != nullptr);
+
+		if (m_size == 0) {
+			return false;
+		}
+
+		auto hash = hash_of(text);
+		for (auto i = hash & mask(); m_slots[i].id != kEmpty; i = (i + 1) & mask()) {
+			if (m_slots[i].hash == hash && history.entry_by_id(m_slots[i].id) == text) {
+				*id = m_slots[i].id;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void DuplicateIndex::insert(uint64_t id, std::wstring_view text)
+	{
+		assert(id != kEmpty);
+
+		if ((m_size + 1) * 2 > m_slots.size()) {
+			std::vector<Slot> slots(std::max(kMinSlots, m_slots.size() * 2));
+			slots.swap(m_slots);
+
+			for (const auto &slot : slots) {
+				if (slot.id != kEmpty) {
+					place(slot);
+				}
+			}
+		}
+
+		place(Slot{ id, hash_of(text) });
+		m_size++;
+	}
+
+	void DuplicateIndex::erase(uint64_t id, std::wstring_view text)
+	{
+		auto i = slot_of(id, hash_of(text));
+
+		// The following slots of the cluster move back into the hole, unless their
+		// probe sequence starts after it.
+		for (auto j = (i + 1) & mask(); m_slots[j].id != kEmpty; j = (j + 1) & mask()) {
+			auto home = m_slots[j].hash & mask();
+			auto stays = i < j ? (i < home && home <= j) : (i < home || home <= j);
+			if (!stays) {
+				m_slots[i] = m_slots[j];
+				i = j;
+			}
+		}
+
+		m_slots[i].id = kEmpty;
+		m_size--;
+	}
+
+	void DuplicateIndex::clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#define IN
+#define OUT
+#define OPTIONAL
+
+namespace dbgutils {
+
+	class ConsoleHistory;
+
+	//							DUPLICATE INDEX
+	//
+	// The DuplicateIndex finds the entry of a history which has a given text, in constant time,
+	// for the removal of the older duplicates (see HISTORY_DUPLICATES). The entries are
+	// identified by their id (see ConsoleHistory::id_of), which does not change when an older
+	// entry is removed, and their text is read from the history: the index holds no copy of it.
+	//
+	// The index is a hash table with open addressing: a slot holds the id of an entry and
+	// the hash of its text, which is checked before the text. The slots are probed linearly,
+	// and a removal shifts the following slots back instead of leaving a tombstone, so the
+	// probe sequences stay as short as the load allows. The table doubles when it is half full.
+	//
+	// REMARKS
+	//	The texts are expected to be distinct: find returns any of the entries with the text.
+	class DuplicateIndex {
+	public:
+		//		ACCESSORS
+		//
+
+		size_t size() const { return m_size; }
+
+		// memory_usage returns the number of bytes allocated by the index.
+		size_t memory_usage() const { return m_slots.capacity() * sizeof(Slot); }
+
+		// find returns the entry which has a given text.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		bool find(const ConsoleHistory &history, std::wstring_view text, OUT uint64_t *id) const;
+
+		//		MANIPULATORS
+		//
+
+		// insert adds an entry, which has the given id and text.
+		void insert(uint64_t id, std::wstring_view text);
+
+		// erase removes an entry, which has the given id and text.
+		void erase(uint64_t id, std::wstring_view text);
+
+		void clear();
+
+	private:
+		static constexpr uint64_t kEmpty = UINT64_MAX;
+
+		struct Slot {
+			uint64_t	id{ kEmpty };
+			uint32_t	hash{ 0 };
+		};
+
+		static uint32_t hash_of(std::wstring_view text);
+
+		size_t mask() const { return m_slots.size() - 1; }
+
+		// slot_of returns the slot of an entry, which must be in the index.
+		size_t slot_of(uint64_t id, uint32_t hash) const;
+
+		// place puts an entry in the first free slot of its probe sequence.
+		void place(const Slot &slot);
+
+	private:
+		// The number of slots is a power of two.
+		std::vector<Slot>	m_slots;
+		size_t				m_size{ 0 };
+	};
+}
@@ -1,131 +1,122 @@
 #include "pch.h"
 #include "EditBox.h"
-#include <cctype> // std::isspace
+#include <bitset>
 #include <cassert>
+#include "string_utils.h"
+#include "SpaceMask.h"
+#include "CharClass.h"
 
-namespace dbgutils {
-	
-	//	class:				StringRangeGenerator
-	//
-	//	The StringRangeGenerator is a helper class used to implement
-	//	the public function	ComputeStringRanges.
-	
-	class StringRangeGenerator {
-	public:
-		StringRangeGenerator(const std::wstring *s)
-			: m_s(s)
-		{
-			assert(s != nullptr);
-			m_sLen = s->length();
-		}
-
-		std::vector<StringRange> GenerateRanges();
-
-	private:
-		enum Event {
-			Unknown,
-			Initialize,
-			WordRangeLeft,
-			WordRangeContinued,
-			SpaceRangeLeft,
-			SpaceRangeContinued
-		};
-
-		// GenerateEvent returns an event based on the index i in the input string.
-		Event GenerateEvent(size_t i) const;
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
-	private:
-		const std::wstring	*m_s;
-		size_t				m_sLen;
-	};
+namespace dbgutils {
 
-	std::vector<StringRange> StringRangeGenerator::GenerateRanges()
+	// is_range_space returns true iff a character belongs to a space range.
+	// It is the test made by ComputeSpaceMask.
+	static bool is_range_space(wchar_t c)
 	{
-		if (m_s->empty()) {
-			return {};
-		}
-
-		std::vector<StringRange> ranges;
-
-		// Beginning of the current range.
-		size_t	begin = 0;
+		return wstr_is_space(c);
+	}
+	
+	// lsb returns the index of the least significant bit set in x, which must not be 0.
+	static int lsb(uint64_t x)
+	{
+		assert(x != 0);
+
+#ifdef _MSC_VER
+		unsigned long i;
+		_BitScanForward64(&i, x);
+		return static_cast<int>(i);
+#else
+		return __builtin_ctzll(x);
+#endif
+	}
 
-		// IMPORTANT NOTE
-		// The inequality is indeed large (<=); it is not an error.
-		// The value m_sLen for the loop index i is a sentinel and
-		// is handled by GenerateEvent.
-		for (size_t i = 0; i <= m_sLen; i++) {
-			auto ev = GenerateEvent(i);
-			switch (ev) {
-			case Event::WordRangeLeft: {
-				ranges.push_back(StringRange::MakeWordRange(begin, i - begin));
-				begin = i;
-			}break;
-			
-			case Event::SpaceRangeLeft: {
-				ranges.push_back(StringRange::MakeSpaceRange(begin, i - begin));
+	// append_word_ranges appends the word ranges of s[begin, end), which holds no space:
+	// the characters are split at the word breaks (see is_word_break).
+	static void append_word_ranges(const wchar_t *s, size_t begin, size_t end, std::vector<StringRange> *ranges)
+	{
+		auto prevGroup = word_group(s[begin]);
+		for (auto i = begin + 1; i < end; i++) {
+			auto group = word_group(s[i]);
+			if (is_word_break(prevGroup, group)) {
+				ranges->push_back(StringRange::MakeWordRange(begin, i - begin));
 				begin = i;
-			}break;
-
-			case Event::Unknown: {
-				assert(false && "Should never happen.");
-			}break;
-
-			default:// Nothing to do.
-				break;
 			}
+			prevGroup = group;
 		}
 
-		return ranges;
+		ranges->push_back(StringRange::MakeWordRange(begin, end - begin));
 	}
 
-	StringRangeGenerator::Event StringRangeGenerator::GenerateEvent(size_t i) const
+	std::vector<StringRange> ComputeStringRanges(const std::wstring &s)
 	{
-		assert(m_sLen != 0);
-		assert(i <= m_sLen && "Index out of range of the input string.");
-
-		// Did we enter the string?
-		if (i == 0) {
-			return Event::Initialize;
+		const auto n = s.length();
+		if (n == 0) {
+			return {};
 		}
 
-		auto prev = (*m_s)[i-1];
-
-		// Did we quit the string?
-		if (i == m_sLen) {
-			if (std::isspace(prev)) {
-				return Event::SpaceRangeLeft;
-			}
-			else {
-				return Event::WordRangeLeft;
+		// Classify the whole string at once: one bit per character, set for the spaces.
+		std::vector<uint64_t> mask((n + 63) / 64);
+		ComputeSpaceMask(s.data(), n, mask.data());
+
+		// A range ends where a bit differs from the previous one: these are the bits set in
+		// mask ^ (mask << 1), the previous bit of the first character of a word being carried
+		// from the previous word. The bits past the end of the string are ignored.
+		auto changes_in_word = [&mask, n](size_t w) {
+			auto m = mask[w];
+			auto carry = w == 0 ? (m & 1) : (mask[w - 1] >> 63);
+			auto changes = m ^ ((m << 1) | carry);
+
+			auto numChars = n - w * 64;
+			if (numChars < 64) {
+				changes &= (uint64_t(1) << numChars) - 1;
 			}
+			return changes;
+		};
+
+		// Count the space and word ranges first: growing the vector from empty would cost more
+		// than counting the bits. The splits of the words at a punctuation or an ideograph
+		// (see append_word_ranges) are not counted: classifying every character twice would
+		// cost more than the one or two reallocations they cause.
+		size_t numRanges = 1;
+		for (size_t w = 0; w < mask.size(); w++) {
+			numRanges += std::bitset<64>(changes_in_word(w)).count();
 		}
 
-		// Here we can access [i] since 0 <= i < m_sLen.
-		auto cur = (*m_s)[i];
+		std::vector<StringRange> ranges;
+		ranges.reserve(numRanges);
 
-		if (std::isspace(prev)) {
-			if (std::isspace(cur)) {
-				return Event::SpaceRangeContinued;
-			}
-			else {
-				return Event::SpaceRangeLeft;
+		// Beginning and type of the current range.
+		size_t	begin = 0;
+		bool	space = (mask[0] & 1) != 0;
+
+		for (size_t w = 0; w < mask.size(); w++) {
+			for (auto changes = changes_in_word(w); changes != 0; changes &= changes - 1) {
+				auto end = w * 64 + lsb(changes);
+
+				if (space) {
+					ranges.push_back(StringRange::MakeSpaceRange(begin, end - begin));
+				}
+				else {
+					append_word_ranges(s.data(), begin, end, &ranges);
+				}
+
+				// Spaces and words alternate.
+				begin = end;
+				space = !space;
 			}
 		}
-		
-		// Here, prev is not a space.
-		if (std::isspace(cur)) {
-			return Event::WordRangeLeft;
+
+		if (space) {
+			ranges.push_back(StringRange::MakeSpaceRange(begin, n - begin));
 		}
 		else {
-			return Event::WordRangeContinued;
+			append_word_ranges(s.data(), begin, n, &ranges);
 		}
-	}
 
-	std::vector<StringRange> ComputeStringRanges(const std::wstring &s)
-	{
-		StringRangeGenerator	generator(&s);
-		return generator.GenerateRanges();
+		return ranges;
 	}
 
 	bool FindRangeContainingIndex(
@@ -193,6 +184,178 @@ namespace dbgutils {
 
 
 
+	//	class:				StringRangeIndex
+	//
+	//
+
+	StringRange StringRangeIndex::operator[](size_t i) const
+	{
+		assert(i < size());
+
+		if (i < m_before.size()) {
+			return m_before[i];
+		}
+
+		auto r = m_after[m_after.size() - 1 - (i - m_before.size())];
+		r.begin = m_length - r.begin;
+
+		return r;
+	}
+
+	size_t StringRangeIndex::find(size_t position) const
+	{
+		// Find the first range ending after the position.
+		size_t lo = 0;
+		size_t hi = size();
+		while (lo < hi) {
+			auto mid = lo + (hi - lo) / 2;
+			auto r = (*this)[mid];
+			if (r.begin + r.length <= position) {
+				lo = mid + 1;
+			}
+			else {
+				hi = mid;
+			}
+		}
+
+		return lo;
+	}
+
+	bool StringRangeIndex::find_previous_type(IN STRING_RANGE_TYPE type, IN size_t start, OUT size_t *iRange) const
+	{
+		assert(iRange != nullptr);
+		assert(start <= size());// large inequality here
+
+		for (size_t i = start; i > 0; i--) {
+			if ((*this)[i - 1].type == type) {
+				*iRange = i - 1;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool StringRangeIndex::find_next_type(IN STRING_RANGE_TYPE type, IN size_t start, OUT size_t *iRange) const
+	{
+		assert(iRange != nullptr);
+		assert(start <= size());// large inequality here
+
+		for (size_t i = start; i + 1 < size(); i++) {
+			if ((*this)[i + 1].type == type) {
+				*iRange = i + 1;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void StringRangeIndex::reset(const GapBuffer &text)
+	{
+		m_before.clear();
+		m_after.clear();
+		m_length = text.length();
+
+		scan(text, 0, m_length);
+	}
+
+	void StringRangeIndex::update(const GapBuffer &text, size_t position, size_t erased, size_t inserted)
+	{
+		assert(m_length + inserted - erased == text.length());
+
+		// Positions before the edit are the same in the old and in the new text.
+		move_split(position);
+
+		// Take out the ranges touched by the edit: from the range containing the character
+		// before the edit to the range containing the character after it, since the edit
+		// may merge or split them. Only the inserted characters are scanned: the parts of
+		// these ranges outside the edit keep their type.
+		auto head = StringRange::MakeWordRange(position, 0);
+		auto tail = StringRange::MakeWordRange(position + erased, 0);
+		while (!m_after.empty() && m_length - m_after.back().begin <= position + erased) {
+			auto r = m_after.back();
+			m_after.pop_back();
+
+			auto rBegin = m_length - r.begin;
+			auto rEnd = rBegin + r.length;
+			if (rBegin < position) {
+				head = StringRange{ r.type, rBegin, position - rBegin };
+			}
+			if (rEnd > position + erased) {
+				tail = StringRange{ r.type, position + erased, rEnd - (position + erased) };
+			}
+		}
+
+		// The ranges left after the split do not move relative to the end of the text.
+		m_length = text.length();
+
+		append(text, head);
+		scan(text, position, position + inserted);
+		tail.begin = position + inserted;
+		append(text, tail);
+	}
+
+	void StringRangeIndex::move_split(size_t position)
+	{
+		// The ranges ending at or after the position go after the split...
+		while (!m_before.empty() && m_before.back().begin + m_before.back().length >= position) {
+			auto r = m_before.back();
+			m_before.pop_back();
+
+			r.begin = m_length - r.begin;
+			m_after.push_back(r);
+		}
+
+		// ...and the ranges ending before it go before the split.
+		while (!m_after.empty()) {
+			auto r = m_after.back();
+			r.begin = m_length - r.begin;
+			if (r.begin + r.length >= position) {
+				break;
+			}
+
+			m_after.pop_back();
+			m_before.push_back(r);
+		}
+	}
+
+	void StringRangeIndex::scan(const GapBuffer &text, size_t begin, size_t end)
+	{
+		auto i = begin;
+		while (i < end) {
+			auto space = is_range_space(text[i]);
+
+			auto rangeBegin = i++;
+			while (i < end && !is_word_break(text[i - 1], text[i])) {
+				i++;
+			}
+
+			append(text, space
+				? StringRange::MakeSpaceRange(rangeBegin, i - rangeBegin)
+				: StringRange::MakeWordRange(rangeBegin, i - rangeBegin));
+		}
+	}
+
+	void StringRangeIndex::append(const GapBuffer &text, const StringRange &range)
+	{
+		if (range.length == 0) {
+			return;
+		}
+
+		if (!m_before.empty()) {
+			auto &last = m_before.back();
+			if (last.begin + last.length == range.begin && !is_word_break(text[range.begin - 1], text[range.begin])) {
+				last.length += range.length;
+				return;
+			}
+		}
+
+		m_before.push_back(range);
+	}
+
+
+
 	//	class:				EditBox
 	//
 	//
@@ -200,19 +363,65 @@ namespace dbgutils {
 
 	const EditBox::Movement EditBox::Movement::Zero = Movement{ 0,0 };
 
-	EditBox::EditBox(const std::wstring str)
-		: m_str(str)
+	EditBox::EditBox(std::wstring_view str)
+		: m_text(str)
+		, m_ranges(m_text)
 		, m_caret(str.length())
 	{}
 
+	const std::wstring &EditBox::content() const
+	{
+		if (!m_contentValid) {
+			m_text.copy_to(&m_content);
+			m_contentValid = true;
+		}
+
+		return m_content;
+	}
+
 	bool EditBox::handle_character(wchar_t c)
 	{
-		m_str.insert(m_caret, 1, c);
+		m_log.record_character(m_caret, c, m_caret);
+
+		m_text.insert(m_caret, c);
+		m_ranges.update(m_text, m_caret, 0, 1);
+		m_contentValid = false;
 		++m_caret;
 
 		return true;
 	}
 
+	bool EditBox::insert_text(std::wstring_view text)
+	{
+		if (text.empty()) {
+			return false;
+		}
+
+		auto hasLineBreaks = text.find_first_of(L"\r\n") != std::wstring_view::npos;
+		if (!hasLineBreaks) {
+			m_log.record(m_caret, std::wstring_view(), text, m_caret);
+
+			m_text.insert(m_caret, text);
+			m_ranges.update(m_text, m_caret, 0, text.length());
+			m_contentValid = false;
+			m_caret += text.length();
+			return true;
+		}
+
+		std::vector<std::wstring_view> lines;
+		wstr_split_lines(text, &lines);
+
+		std::wstring joined;
+		for (size_t i = 0; i < lines.size(); i++) {
+			if (i > 0) {
+				joined += L' ';
+			}
+			joined += lines[i];
+		}
+
+		return insert_text(joined);
+	}
+
 	bool EditBox::handle_key(Key key, const ModKeyState &mod)
 	{
 		auto changed = false;
@@ -223,6 +432,8 @@ namespace dbgutils {
 		case VK_BACK:		changed = handle_key_backspace(mod); break;
 		case VK_HOME:		changed = handle_key_home(mod); break;
 		case VK_END:		changed = handle_key_end(mod); break;
+		case 'Z':			changed = mod.ctrl && undo(); break;
+		case 'Y':			changed = mod.ctrl && redo(); break;
 
 		default: break;
 		}
@@ -230,6 +441,32 @@ namespace dbgutils {
 		return changed;
 	}
 
+	bool EditBox::undo()
+	{
+		EditLog::Edit edit;
+		if (!m_log.undo(&edit)) {
+			return false;
+		}
+
+		replace_text(edit.position, edit.inserted.length(), edit.erased);
+		m_caret = edit.caret;
+
+		return true;
+	}
+
+	bool EditBox::redo()
+	{
+		EditLog::Edit edit;
+		if (!m_log.redo(&edit)) {
+			return false;
+		}
+
+		replace_text(edit.position, edit.erased.length(), edit.inserted);
+		m_caret = edit.position + edit.inserted.length();
+
+		return true;
+	}
+
 	bool EditBox::handle_key_left(const ModKeyState &mod)
 	{
 		return handle_arrow_key(Direction::LEFT, mod);
@@ -284,23 +521,19 @@ namespace dbgutils {
 
 	EditBox::Movement EditBox::simulate_caret_movement_ctrl_left()
 	{
-		// Determine the word and space ranges in the input string.
-		auto ranges = ComputeStringRanges(m_str);
+		// The word and space ranges of the content are kept up to date by the edits.
+		const auto &ranges = m_ranges;
 
 		// Look if a range contains the caret.
-		size_t i = 0;
-		auto caretInARange = FindRangeContainingIndex(IN m_caret, IN ranges, OUT &i);
-		if (!caretInARange) {
-			// Case where the caret is at the end of the string, hence does not belong
-			// to any range. We put a sentinel value to i that will be handled by
-			// the following code below.
-			i = ranges.size();
-		}
+		// If the caret is at the end of the string, it does not belong to any range,
+		// and i is a sentinel value (ranges.size()) handled by the code below.
+		auto i = ranges.find(m_caret);
+		auto caretInARange = i < ranges.size();
 
 		// If the caret is in a word range but not at the begining,
 		// we move it to the beginning of this range.
 		if (caretInARange) {
-			const auto &caretRange = ranges[i];
+			const auto caretRange = ranges[i];
 			if (caretRange.type == STRING_RANGE_TYPE_WORD && m_caret != caretRange.begin) {
 				return movement_from_caret_to(caretRange.begin);
 			}
@@ -311,13 +544,13 @@ namespace dbgutils {
 		size_t j;
 
 		// We first look for a word range.
-		auto prevWordRangeFound = FindPreviousRangeType(STRING_RANGE_TYPE_WORD, i, ranges, &j);
+		auto prevWordRangeFound = ranges.find_previous_type(STRING_RANGE_TYPE_WORD, i, &j);
 		if (prevWordRangeFound) {
 			return movement_from_caret_to(ranges[j].begin);
 		}
 
 		// We then we look for a space range.
-		auto prevSpaceRangeFound = FindPreviousRangeType(STRING_RANGE_TYPE_SPACE, i, ranges, &j);
+		auto prevSpaceRangeFound = ranges.find_previous_type(STRING_RANGE_TYPE_SPACE, i, &j);
 		if (prevSpaceRangeFound) {
 			return movement_from_caret_to(ranges[j].begin);
 		}
@@ -344,22 +577,17 @@ namespace dbgutils {
 
 	EditBox::Movement EditBox::simulate_caret_movement_ctrl_right()
 	{
-		// Determine the word and space ranges in the input string.
-		auto ranges = ComputeStringRanges(m_str);
+		// The word and space ranges of the content are kept up to date by the edits.
+		const auto &ranges = m_ranges;
 
 		// Look if a range contains the caret.
-		size_t i = 0;
-		auto caretInARange = FindRangeContainingIndex(IN m_caret, IN ranges, OUT &i);
-		if (!caretInARange) {
-			// Case where the caret is at the end of the string, hence does not belong
-			// to any range. We put a sentinel value to i that will be handled by
-			// the following code below.
-			i = ranges.size();
-		}
+		// If the caret is at the end of the string, it does not belong to any range,
+		// and i is a sentinel value (ranges.size()) handled by the code below.
+		auto i = ranges.find(m_caret);
 
 		// Try to go to the next word's beginning.
 		size_t j;
-		auto nextWordRangeFound = FindNextRangeType(STRING_RANGE_TYPE_WORD, i, ranges, &j);
+		auto nextWordRangeFound = ranges.find_next_type(STRING_RANGE_TYPE_WORD, i, &j);
 		if (nextWordRangeFound) {
 			return movement_from_caret_to(ranges[j].begin);
 		}
@@ -390,10 +618,23 @@ namespace dbgutils {
 
 	void EditBox::delete_string_range(const Range<size_t> &range)
 	{
-		m_str.erase(
-			m_str.begin() + range.begin(),
-			m_str.begin() + range.end()
-		);
+		if (range.length() == 0) {
+			return;
+		}
+
+		std::wstring erased;
+		m_text.copy_to(&erased, range.begin(), range.length());
+		m_log.record(range.begin(), erased, std::wstring_view(), m_caret);
+
+		replace_text(range.begin(), range.length(), std::wstring_view());
+	}
+
+	void EditBox::replace_text(size_t position, size_t count, std::wstring_view text)
+	{
+		m_text.erase(position, count);
+		m_text.insert(position, text);
+		m_ranges.update(m_text, position, count, text.length());
+		m_contentValid = false;
 	}
 
 	bool EditBox::handle_key_home(const ModKeyState &mod)
@@ -408,13 +649,18 @@ namespace dbgutils {
 
 	bool EditBox::set_caret(size_t position)
 	{
-		const auto len = m_str.length();
+		const auto len = m_text.length();
 		assert(0 <= position && position <= len);
 
 		auto before = m_caret;
 
 		m_caret = position;
 
+		// Typing after moving the caret starts a new undo record.
+		if (m_caret != before) {
+			m_log.seal();
+		}
+
 		return m_caret != before;
 	}
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "Key.h"
 #include "Range.h"
 #include "StringSelectionRange.h"
+#include "GapBuffer.h"
+#include "EditLog.h"
 
 namespace dbgutils {
 
@@ -15,6 +17,17 @@ namespace dbgutils {
 		STRING_RANGE_TYPE_WORD,
 		STRING_RANGE_TYPE_SPACE
 	};
+	// LINE_BREAK_MODE tells how the insert_text functions of the command lines
+	// handle the line breaks of a text, e.g. of a clipboard paste.
+	enum LINE_BREAK_MODE {
+		// The line breaks are replaced by spaces: the text goes into the command line.
+		LINE_BREAK_MODE_JOIN,
+
+		// Every line break submits the command line, as the ENTER/RETURN key does.
+		// The text after the last line break stays in the command line.
+		LINE_BREAK_MODE_SUBMIT
+	};
+
 	struct StringRange {
 		STRING_RANGE_TYPE	type{ STRING_RANGE_TYPE_WORD };
 
@@ -48,6 +61,9 @@ namespace dbgutils {
 		return !(lhs == rhs);
 	}
 
+	// ComputeStringRanges splits a string into ranges of spaces and words. Two space ranges
+	// are never adjacent, but the word ranges are split at the word breaks, e.g. between a
+	// letter and a punctuation, or around an ideograph (see is_word_break).
 	std::vector<StringRange> ComputeStringRanges(const std::wstring &s);
 
 	// RETURN VALUE
@@ -76,19 +92,103 @@ namespace dbgutils {
 		IN const std::vector<StringRange> &ranges,
 		OUT size_t *iRange);
 
+	//							STRING RANGE INDEX
+	//
+	// The StringRangeIndex holds the same ranges as ComputeStringRanges, for a text which
+	// is being edited. It is updated incrementally: an edit only scans the characters it
+	// inserts and splices the ranges it touches, whatever the length of the text or of
+	// its words.
+	//
+	// Like a gap buffer, the ranges are split in two at the last edit. The ranges before the
+	// split store their position from the beginning of the text, and the ranges after the
+	// split store it from the end of the text, so an edit does not shift them. An edit
+	// elsewhere first moves the split, which costs O(number of ranges in between).
+	class StringRangeIndex {
+	public:
+		StringRangeIndex() = default;
+		StringRangeIndex(const GapBuffer &text) { reset(text); }
+
+		//		ACCESSORS
+		//
+
+		// size returns the number of ranges.
+		size_t size() const { return m_before.size() + m_after.size(); }
+		bool empty() const { return size() == 0; }
+
+		// operator[] returns the ith range, from the beginning of the text.
+		StringRange operator[](size_t i) const;
+
+		// find returns the index of the range containing a position in the text,
+		// or size() if there is none (the position is the end of the text).
+		// It is a binary search.
+		size_t find(size_t position) const;
+
+		// find_previous_type and find_next_type are the counterparts of FindPreviousRangeType
+		// and FindNextRangeType. Since two space ranges are never adjacent, they are O(1)
+		// when looking for a word range.
+		bool find_previous_type(IN STRING_RANGE_TYPE type, IN size_t start, OUT size_t *iRange) const;
+		bool find_next_type(IN STRING_RANGE_TYPE type, IN size_t start, OUT size_t *iRange) const;
+
+		//		MANIPULATORS
+		//
+
+		// reset rebuilds the index of a text from scratch.
+		void reset(const GapBuffer &text);
+
+		// update updates the index after an edit of the text: the erased characters started
+		// at a given position, and the inserted characters were put at the same position.
+		void update(const GapBuffer &text, size_t position, size_t erased, size_t inserted);
+
+	private:
+		// move_split moves the split so that the ranges ending before a position are
+		// before the split, and the others after it.
+		void move_split(size_t position);
+
+		// scan appends the ranges of text[begin, end) before the split.
+		void scan(const GapBuffer &text, size_t begin, size_t end);
+
+		// append appends a range before the split, merging it with the last one
+		// if there is no word break between them.
+		void append(const GapBuffer &text, const StringRange &range);
+
+	private:
+		// The ranges before the split, from the first one.
+		std::vector<StringRange>	m_before;
+
+		// The ranges after the split, from the last one. Their begin member is
+		// the distance between their beginning and the end of the text.
+		std::vector<StringRange>	m_after;
+
+		// Length of the text.
+		size_t						m_length{ 0 };
+	};
+
 	class EditBox {
 	public:
-		EditBox(const std::wstring str = L"");
+		EditBox(std::wstring_view str = std::wstring_view());
 
 		//			ACCESSORS
 		//
 
 		// content returns the string contained in the edit box.
-		const auto &content() const { return m_str; }
+		//
+		// REMARKS
+		//	The string is copied out of the gap buffer the first time it is requested
+		//	after a change, then cached. The reference is invalidated by the next change.
+		const std::wstring &content() const;
+
+		// segments returns the content in two parts, without copying it out of the gap buffer.
+		// The views are invalidated by the next change.
+		GapBuffer::Segments segments() const { return m_text.segments(); }
+
+		size_t length() const { return m_text.length(); }
 
 		// caret returns the position of the caret in the content string.
 		const auto caret() const { return m_caret; }
 
+		// edit_log returns the undo/redo stack of the edit box.
+		const EditLog &edit_log() const { return m_log; }
+
 		//			MANIPULATORS
 		//
 
@@ -98,8 +198,18 @@ namespace dbgutils {
 		// handle_character receives a printable unicode character to insert at the caret.
 		bool handle_character(wchar_t c);
 
+		// insert_text inserts a string at the caret in a single splice, and moves the caret
+		// after it. The line breaks are replaced by spaces since the edit box holds one line.
+		bool insert_text(std::wstring_view text);
+
 		bool handle_key(Key key, const ModKeyState &mod = ModKeyState());
 
+		// undo reverts the latest edit, and puts the caret where it was before it.
+		// redo applies the latest undone edit again. Ctrl+Z and Ctrl+Y call them.
+		// Their cost is proportional to the size of the edit.
+		bool undo();
+		bool redo();
+
 	private:
 		bool handle_key_left(const ModKeyState &mod);
 		bool handle_key_right(const ModKeyState &mod);
@@ -166,12 +276,26 @@ namespace dbgutils {
 
 		void delete_string_range(const Range<size_t> &range);
 
+		// replace_text replaces count characters from a position by a string, without
+		// recording the edit. The caret is left unchanged.
+		void replace_text(size_t position, size_t count, std::wstring_view text);
+
 		size_t beginning_of_string() const { return 0; }
-		size_t end_of_string() const { return m_str.length(); }
+		size_t end_of_string() const { return m_text.length(); }
 
 	private:
-		// The content of the edit box.
-		std::wstring	m_str;
+		// The content of the edit box. The gap is moved to the caret by the edits.
+		GapBuffer		m_text;
+
+		// Word and space ranges of the content, for the ctrl movements.
+		StringRangeIndex		m_ranges;
+
+		// Edits of the content, for undo and redo.
+		EditLog					m_log;
+
+		// Contiguous copy of the content, made on demand by content().
+		mutable std::wstring	m_content;
+		mutable bool			m_contentValid{ false };
 		
 		// Position of the caret inside the string.
 		size_t			m_caret{ 0 };
@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "EditLog.h"
+#include <cassert>
+#include "string_utils.h"
+
+namespace dbgutils {
+
+	EditLog::EditLog(size_t byteBudget)
+		: m_byteBudget(byteBudget)
+	{}
+
+	size_t EditLog::memory_usage() const
+	{
+		auto dead = m_records.empty() ? m_arena.size() : m_records.front().text - m_arenaBase;
+
+		return m_records.size() * sizeof(Record) + (m_arena.size() - dead) * sizeof(wchar_t);
+	}
+
+	void EditLog::record(size_t position, std::wstring_view erased, std::wstring_view inserted, size_t caret)
+	{
+		drop_redo_records();
+		m_open = false;
+
+		// The older records cannot be undone without this one.
+		auto length = erased.length() + inserted.length();
+		if (sizeof(Record) + length * sizeof(wchar_t) > m_byteBudget) {
+			clear();
+			return;
+		}
+
+		m_records.push_back(Record{
+			position,
+			m_arenaBase + m_arena.size(),
+			static_cast<uint32_t>(erased.length()),
+			static_cast<uint32_t>(inserted.length()),
+			caret
+		});
+		m_arena.insert(m_arena.end(), erased.begin(), erased.end());
+		m_arena.insert(m_arena.end(), inserted.begin(), inserted.end());
+		m_next = m_records.size();
+
+		enforce_budget();
+	}
+
+	void EditLog::record_character(size_t position, wchar_t c, size_t caret)
+	{
+		drop_redo_records();
+
+		// An open record only holds inserted characters, and its text ends the arena.
+		if (m_open && !m_records.empty()) {
+			auto &last = m_records.back();
+			auto startsWord = wstr_is_space(m_arena.back()) && !wstr_is_space(c);
+
+			if (last.position + last.inserted == position && !startsWord) {
+				m_arena.push_back(c);
+				last.inserted++;
+				enforce_budget();
+				return;
+			}
+		}
+
+		record(position, std::wstring_view(), std::wstring_view(&c, 1), caret);
+		m_open = !m_records.empty();
+	}
+
+	bool EditLog::undo(OUT Edit *edit)
+	{
+		assert(edit != nullptr);
+
+		if (!can_undo()) {
+			return false;
+		}
+
+		m_open = false;
+		*edit = edit_of(m_records[--m_next]);
+		return true;
+	}
+
+	bool EditLog::redo(OUT Edit *edit)
+	{
+		assert(edit != nullptr);
+
+		if (!can_redo()) {
+			return false;
+		}
+
+		m_open = false;
+		*edit = edit_of(m_records[m_next++]);
+		return true;
+	}
+
+	void EditLog::clear()
+	{
+		m_records.clear();
+		m_next = 0;
+		m_open = false;
+		m_arena.clear();
+		m_arenaBase = 0;
+	}
+
+	EditLog::Edit EditLog::edit_of(const Record &r) const
+	{
+		auto text = m_arena.data() + (r.text - m_arenaBase);
+
+		return Edit{
+			r.position,
+			std::wstring_view(text, r.erased),
+			std::wstring_view(text + r.erased, r.inserted),
+			r.caret
+		};
+	}
+
+	void EditLog::drop_redo_records()
+	{
+		if (!can_redo()) {
+			return;
+		}
+
+		m_arena.resize(m_records[m_next].text - m_arenaBase);
+		m_records.resize(m_next);
+	}
+
+	void EditLog::enforce_budget()
+	{
+		while (!m_records.empty() && memory_usage() > m_byteBudget) {
+			m_records.pop_front();
+			m_next = m_next > 0 ? m_next - 1 : 0;
+		}
+		if (m_records.empty()) {
+			clear();
+			return;
+		}
+
+		// Remove the text of the dropped records once it is as long as the live text.
+		auto dead = m_records.front().text - m_arenaBase;
+		if (dead > 0 && dead >= m_arena.size() - dead) {
+			m_arena.erase(m_arena.begin(), m_arena.begin() + dead);
+			m_arenaBase += dead;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+#define IN
+#define OUT
+#define OPTIONAL
+
+namespace dbgutils {
+
+	//							EDIT LOG
+	//
+	// The EditLog is the undo/redo stack of an edit box. It stores every edit as a delta
+	// record: a position, the erased text and the inserted text. The texts of all the records
+	// live in a single arena of wide characters, so nothing is allocated per record and undoing
+	// or redoing an edit costs O(size of the edit), whatever the length of the line.
+	//
+	//		records		[ r0 | r1 | r2 | r3 ]
+	//		                          ^ next: r0 and r1 are done, r2 and r3 can be redone
+	//		arena		[ r0 erased, r0 inserted | r1 erased, r1 inserted | ... ]
+	//
+	// Recording an edit drops the records that could be redone.
+	//
+	// COALESCING
+	//	The characters typed one after the other go into a single record, so that one undo
+	//	removes a whole word. A record stops growing when it is sealed (e.g. by a caret movement)
+	//	and when a word starts after a space.
+	//
+	// MEMORY
+	//	The records and their text are bounded by a byte budget. When it is exceeded, the oldest
+	//	records are dropped. An edit larger than the whole budget cannot be undone: it clears
+	//	the log. The dead text at the front of the arena is removed once it is as long as the live
+	//	text, so the arena takes at most twice the budget.
+	class EditLog {
+	public:
+		static constexpr size_t kDefaultByteBudget = 64 * 1024;
+
+		// An edit to apply to the text. The views point into the arena: they are invalidated
+		// by the next call to a manipulator.
+		struct Edit {
+			size_t				position{ 0 };
+			std::wstring_view	erased;
+			std::wstring_view	inserted;
+
+			// Position of the caret before the edit.
+			size_t				caret{ 0 };
+		};
+
+		EditLog(size_t byteBudget = kDefaultByteBudget);
+
+		//		ACCESSORS
+		//
+
+		// size returns the number of records, done and undone.
+		size_t size() const { return m_records.size(); }
+		bool empty() const { return m_records.empty(); }
+
+		bool can_undo() const { return m_next > 0; }
+		bool can_redo() const { return m_next < m_records.size(); }
+
+		size_t byte_budget() const { return m_byteBudget; }
+
+		// memory_usage returns the number of bytes counted against the budget:
+		// the records and their live text.
+		size_t memory_usage() const;
+
+		//		MANIPULATORS
+		//
+
+		// record adds an edit to the log. The erased text started at a given position,
+		// and the inserted text was put at the same position. The caret is the position
+		// of the caret before the edit.
+		void record(size_t position, std::wstring_view erased, std::wstring_view inserted, size_t caret);
+
+		// record_character adds the insertion of a single typed character, coalescing it
+		// with the previous record if possible.
+		void record_character(size_t position, wchar_t c, size_t caret);
+
+		// seal closes the latest record: the next character starts a new one.
+		void seal() { m_open = false; }
+
+		// undo steps back one record, and returns the edit to revert: the caller replaces
+		// its inserted text by its erased text.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is nothing to undo.
+		bool undo(OUT Edit *edit);
+
+		// redo steps forward one record, and returns the edit to apply again: the caller
+		// replaces its erased text by its inserted text.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is nothing to redo.
+		bool redo(OUT Edit *edit);
+
+		void clear();
+
+	private:
+		struct Record {
+			size_t		position;
+			size_t		text;		// position of the erased then inserted text in the arena (see m_arenaBase)
+			uint32_t	erased;
+			uint32_t	inserted;
+			size_t		caret;
+		};
+
+		Edit edit_of(const Record &r) const;
+
+		// drop_redo_records drops the records after m_next, and their text.
+		void drop_redo_records();
+
+		// enforce_budget drops the oldest records until the budget is met.
+		void enforce_budget();
+
+	private:
+		size_t					m_byteBudget;
+
+		std::deque<Record>		m_records;
+
+		// Index of the next record to redo. The records before it are done.
+		size_t					m_next{ 0 };
+
+		// True iff the latest record may still grow with typed characters.
+		bool					m_open{ false };
+
+		// Text of the records. m_arena[0] is at position m_arenaBase in the log, and the
+		// text of the dropped records is in front of the one of the oldest record.
+		std::vector<wchar_t>	m_arena;
+		size_t					m_arenaBase{ 0 };
+	};
+}
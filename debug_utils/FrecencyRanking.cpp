@@ -0,0 +1,366 @@
+#include "pch.h"
+#include "FrecencyRanking.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace dbgutils {
+
+	// The scores are scaled down when the weight of a use reaches it, far from the range
+	// of a double.
+	static constexpr double kMaxWeight = 1e150;
+
+	// Smallest table of edges, in slots.
+	static constexpr size_t kMinEdgeSlots = 64;
+
+	FrecencyRanking::FrecencyRanking(size_t capacity, size_t halfLife)
+		: m_capacity(capacity)
+		, m_growth(std::exp2(1.0 / halfLife))
+	{
+		assert(capacity >= 1 && capacity < kNil);
+		assert(halfLife >= 1);
+	}
+
+	size_t FrecencyRanking::memory_usage() const
+	{
+		auto bytes = m_counters.capacity() * sizeof(Counter)
+			+ m_heap.capacity() * sizeof(uint32_t)
+			+ m_nodes.capacity() * sizeof(Node)
+			+ (m_freeNodes.capacity() + m_path.capacity()) * sizeof(uint32_t)
+			+ m_edges.capacity() * sizeof(Edge);
+
+		for (const auto &counter : m_counters) {
+			bytes += counter.text.capacity() * sizeof(wchar_t);
+		}
+
+		return bytes;
+	}
+
+	uint32_t FrecencyRanking::child(uint32_t node, wchar_t c) const
+	{
+		if (m_edges.empty()) {
+			return kNil;
+		}
+
+		auto key = edge_key(node, c);
+		auto mask = m_edges.size() - 1;
+		for (auto i = home(key); m_edges[i].key != kNoEdge; i = (i + 1) & mask) {
+			if (m_edges[i].key == key) {
+				return m_edges[i].child;
+			}
+		}
+
+		return kNil;
+	}
+
+	void FrecencyRanking::insert_edge(uint64_t key, uint32_t child)
+	{
+		if ((m_numEdges + 1) * 2 > m_edges.size()) {
+			std::vector<Edge> edges(std::max(kMinEdgeSlots, m_edges.size() * 2));
+			edges.swap(m_edges);
+
+			for (const auto &edge : edges) {
+				if (edge.key != kNoEdge) {
+					auto i = home(edge.key);
+					while (m_edges[i].key != kNoEdge) {
+						i = (i + 1) & (m_edges.size() - 1);
+					}
+					m_edges[i] = edge;
+				}
+			}
+		}
+
+		auto i = home(key);
+		while (m_edges[i].key != kNoEdge) {
+			i = (i + 1) & (m_edges.size() - 1);
+		}
+		m_edges[i] = Edge{ key, child };
+		m_numEdges++;
+	}
+
+	void FrecencyRanking::erase_edge(uint64_t key)
+	{
+		auto mask = m_edges.size() - 1;
+		auto i = home(key);
+		while (m_edges[i].key != key) {
+			assert(m_edges[i].key != kNoEdge && "The edge is not in the table.");
+			i = (i + 1) & mask;
+		}
+
+		// The following slots of the cluster move back into the hole, unless their
+		// probe sequence starts after it.
+		for (auto j = (i + 1) & mask; m_edges[j].key != kNoEdge; j = (j + 1) & mask) {
+			auto h = home(m_edges[j].key);
+			auto stays = i < j ? (i < h && h <= j) : (i < h || h <= j);
+			if (!stays) {
+				m_edges[i] = m_edges[j];
+				i = j;
+			}
+		}
+
+		m_edges[i] = Edge();
+		m_numEdges--;
+	}
+
+	uint32_t FrecencyRanking::find(std::wstring_view command) const
+	{
+		if (m_nodes.empty()) {
+			return kNil;
+		}
+
+		uint32_t node = 0;
+		for (auto c : command) {
+			node = child(node, c);
+			if (node == kNil) {
+				return kNil;
+			}
+		}
+
+		return m_nodes[node].terminal;
+	}
+
+	uint32_t FrecencyRanking::walk(std::wstring_view command)
+	{
+		m_path.clear();
+		if (m_nodes.empty()) {
+			return kNil;
+		}
+
+		uint32_t node = 0;
+		m_path.push_back(node);
+		for (auto c : command) {
+			node = child(node, c);
+			if (node == kNil) {
+				return kNil;
+			}
+			m_path.push_back(node);
+		}
+
+		return m_nodes[node].terminal;
+	}
+
+	bool FrecencyRanking::better(uint32_t counter, uint32_t best) const
+	{
+		return best == kNil || m_counters[counter].score > m_counters[best].score;
+	}
+
+	double FrecencyRanking::score(std::wstring_view command) const
+	{
+		auto counter = find(command);
+		if (counter == kNil) {
+			return 0;
+		}
+
+		// The latest use weighs the weight of the next one over the growth.
+		return m_counters[counter].score * m_growth / m_weight;
+	}
+
+	bool FrecencyRanking::suggest(std::wstring_view prefix, OUT std::wstring_view *command) const
+	{
+		return suggest(prefix, std::wstring_view(), command);
+	}
+
+	bool FrecencyRanking::suggest(std::wstring_view first, std::wstring_view second, OUT std::wstring_view *command) const
+	{
+		assert(command != nullptr);
+
+		if (m_nodes.empty()) {
+			return false;
+		}
+
+		uint32_t node = 0;
+		for (auto part : { first, second }) {
+			for (auto c : part) {
+				node = child(node, c);
+				if (node == kNil) {
+					return false;
+				}
+			}
+		}
+
+		auto best = m_nodes[node].best;
+		if (best == kNil) {
+			return false;
+		}
+
+		*command = m_counters[best].text;
+		return true;
+	}
+
+	void FrecencyRanking::link(uint32_t counter)
+	{
+		if (m_nodes.empty()) {
+			m_nodes.emplace_back();
+		}
+
+		const auto &text = m_counters[counter].text;
+		uint32_t node = 0;
+		for (auto c : text) {
+			m_nodes[node].count++;
+			if (better(counter, m_nodes[node].best)) {
+				m_nodes[node].best = counter;
+			}
+
+			auto next = child(node, c);
+			if (next == kNil) {
+				if (!m_freeNodes.empty()) {
+					next = m_freeNodes.back();
+					m_freeNodes.pop_back();
+					m_nodes[next] = Node();
+				}
+				else {
+					next = static_cast<uint32_t>(m_nodes.size());
+					m_nodes.emplace_back();
+				}
+				insert_edge(edge_key(node, c), next);
+			}
+			node = next;
+		}
+
+		m_nodes[node].count++;
+		m_nodes[node].terminal = counter;
+	}
+
+	void FrecencyRanking::unlink(uint32_t counter)
+	{
+		const auto &text = m_counters[counter].text;
+
+		walk(text);
+		assert(m_path.size() == text.length() + 1);
+		m_nodes[m_path.back()].terminal = kNil;
+
+		// From the deepest node: a node is freed with its last command.
+		for (auto depth = text.length() + 1; depth-- > 0; ) {
+			auto &n = m_nodes[m_path[depth]];
+			if (--n.count == 0 && depth > 0) {
+				erase_edge(edge_key(m_path[depth - 1], text[depth - 1]));
+				m_freeNodes.push_back(m_path[depth]);
+				continue;
+			}
+
+			// The counter is the lowest-ranked one, so it is the best of a node only when
+			// the other commands of the node tie with it, or are not longer than its prefix.
+			if (n.best == counter) {
+				n.best = kNil;
+				auto prefix = std::wstring_view(text).substr(0, depth);
+				for (uint32_t other = 0; other < m_counters.size(); other++) {
+					const auto &otherText = m_counters[other].text;
+					if (other != counter && otherText.length() > depth
+						&& std::wstring_view(otherText).substr(0, depth) == prefix
+						&& better(other, n.best)) {
+						n.best = other;
+					}
+				}
+			}
+		}
+	}
+
+	void FrecencyRanking::raise(uint32_t counter)
+	{
+		// The commands of a node are among the commands of its parent, so the command is
+		// already the best of the nodes below the first one where it is. The last node of
+		// the path is the command itself.
+		for (size_t depth = 0; depth + 1 < m_path.size(); depth++) {
+			auto &best = m_nodes[m_path[depth]].best;
+			if (best == counter) {
+				break;
+			}
+			if (better(counter, best)) {
+				best = counter;
+			}
+		}
+	}
+
+	void FrecencyRanking::sift_up(size_t pos)
+	{
+		auto counter = m_heap[pos];
+		while (pos > 0) {
+			auto parent = (pos - 1) / 2;
+			if (m_counters[m_heap[parent]].score <= m_counters[counter].score) {
+				break;
+			}
+			m_heap[pos] = m_heap[parent];
+			m_counters[m_heap[pos]].heapPos = static_cast<uint32_t>(pos);
+			pos = parent;
+		}
+
+		m_heap[pos] = counter;
+		m_counters[counter].heapPos = static_cast<uint32_t>(pos);
+	}
+
+	void FrecencyRanking::sift_down(size_t pos)
+	{
+		auto counter = m_heap[pos];
+		for (;;) {
+			auto smallest = 2 * pos + 1;
+			if (smallest >= m_heap.size()) {
+				break;
+			}
+			if (smallest + 1 < m_heap.size() && m_counters[m_heap[smallest + 1]].score < m_counters[m_heap[smallest]].score) {
+				smallest++;
+			}
+			if (m_counters[counter].score <= m_counters[m_heap[smallest]].score) {
+				break;
+			}
+			m_heap[pos] = m_heap[smallest];
+			m_counters[m_heap[pos]].heapPos = static_cast<uint32_t>(pos);
+			pos = smallest;
+		}
+
+		m_heap[pos] = counter;
+		m_counters[counter].heapPos = static_cast<uint32_t>(pos);
+	}
+
+	void FrecencyRanking::add(std::wstring_view command)
+	{
+		if (command.length() > kMaxLength) {
+			return;
+		}
+
+		if (m_weight > kMaxWeight) {
+			for (auto &counter : m_counters) {
+				counter.score /= m_weight;
+			}
+			m_weight = 1;
+		}
+		auto weight = m_weight;
+		m_weight *= m_growth;
+
+		auto counter = walk(command);
+		if (counter != kNil) {
+			m_counters[counter].score += weight;
+			sift_down(m_counters[counter].heapPos);
+			raise(counter);
+			return;
+		}
+
+		if (m_counters.size() < m_capacity) {
+			counter = static_cast<uint32_t>(m_counters.size());
+			m_counters.push_back(Counter{ std::wstring(command), weight, 0 });
+			m_heap.push_back(counter);
+			sift_up(m_heap.size() - 1);
+			link(counter);
+			return;
+		}
+
+		// Space-saving: the lowest-ranked command is replaced, and its score is inherited.
+		counter = m_heap[0];
+		unlink(counter);
+		m_counters[counter].text.assign(command);
+		m_counters[counter].score += weight;
+		sift_down(0);
+		link(counter);
+	}
+
+	void FrecencyRanking::clear()
+	{
+		m_weight = 1;
+		m_counters.clear();
+		m_heap.clear();
+		m_nodes.clear();
+		m_freeNodes.clear();
+		m_edges.clear();
+		m_numEdges = 0;
+	}
+}
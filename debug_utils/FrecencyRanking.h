@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define IN
+#define OUT
+#define OPTIONAL
+
+namespace dbgutils {
+
+	//							FRECENCY RANKING
+	//
+	// The FrecencyRanking ranks the commands of a history by frecency: every use of a command
+	// adds to its score a weight which halves every halfLife uses of any command, so the score
+	// is both a frequency and a recency. It suggests the best-ranked command starting with a
+	// prefix, for the completion of the command line (see Console::suggestion).
+	//
+	// The weights grow instead of the scores decaying (forward decay): the use at time t weighs
+	// 2^(t / halfLife), and the scores are compared as they are. They are scaled down from time
+	// to time, which keeps their order.
+	//
+	// Only the capacity best-ranked commands are tracked, with the space-saving algorithm: a
+	// command which is not tracked replaces the lowest-ranked one, and inherits its score.
+	// The score of a new command is thus an overestimate, by at most the lowest score, but the
+	// commands used often enough are always tracked. The lowest-ranked command is the top of
+	// a min-heap. So the memory is bounded by the capacity and the maximum length of a tracked
+	// command, however long the session is.
+	//
+	// The tracked commands are also in a trie, in which every node keeps the best-ranked
+	// command longer than its prefix. A suggestion walks the prefix in the trie, so it costs
+	// O(prefix length). The children of the nodes are in a single hash table, keyed by the
+	// parent and the character, with linear probing (like the DuplicateIndex).
+	//
+	//		""		-> "git status"
+	//		"g"		-> "git status"
+	//		"gi"	-> "git status"
+	//		...
+	//		"m"		-> "make clean"
+	class FrecencyRanking {
+	public:
+		// The longer commands are not tracked.
+		static constexpr size_t kMaxLength = 256;
+
+		FrecencyRanking(size_t capacity = 64, size_t halfLife = 64);
+
+		//		ACCESSORS
+		//
+
+		auto capacity() const { return m_capacity; }
+
+		// size returns the number of tracked commands.
+		size_t size() const { return m_counters.size(); }
+
+		// memory_usage returns an estimate of the number of bytes allocated by the ranking.
+		size_t memory_usage() const;
+
+		// score returns the frecency of a command: the latest use counts as 1, and the
+		// older ones as less. Returns 0 if the command is not tracked.
+		double score(std::wstring_view command) const;
+
+		// suggest returns the best-ranked command which starts with a prefix, and is longer.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such command.
+		//
+		// REMARKS
+		//	The view is invalidated by the next call to a manipulator.
+		bool suggest(std::wstring_view prefix, OUT std::wstring_view *command) const;
+
+		// This overload takes a prefix in two parts, e.g. the segments of a gap buffer.
+		bool suggest(std::wstring_view first, std::wstring_view second, OUT std::wstring_view *command) const;
+
+		//		MANIPULATORS
+		//
+
+		// add counts a use of a command.
+		void add(std::wstring_view command);
+
+		void clear();
+
+	private:
+		static constexpr uint32_t kNil = UINT32_MAX;
+
+		// A tracked command. The counters are reused when the commands are replaced.
+		struct Counter {
+			std::wstring	text;
+			double			score;
+			uint32_t		heapPos;
+		};
+
+		// A node of the trie, for the prefix of its depth.
+		struct Node {
+			uint32_t	best{ kNil };		// best-ranked command longer than the prefix
+			uint32_t	terminal{ kNil };	// command equal to the prefix
+			uint32_t	count{ 0 };			// number of commands starting with the prefix
+		};
+
+		static constexpr uint64_t kNoEdge = UINT64_MAX;
+
+		// A link from a node to a child, in the hash table.
+		struct Edge {
+			uint64_t	key{ kNoEdge };
+			uint32_t	child{ kNil };
+		};
+
+		static uint64_t edge_key(uint32_t node, wchar_t c) { return static_cast<uint64_t>(node) << 32 | static_cast<uint32_t>(c); }
+
+		// home returns the first slot of the probe sequence of an edge.
+		size_t home(uint64_t key) const { return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (m_edges.size() - 1); }
+
+		// child returns the child of a node for a character, or kNil.
+		uint32_t child(uint32_t node, wchar_t c) const;
+
+		void insert_edge(uint64_t key, uint32_t child);
+		void erase_edge(uint64_t key);
+
+		// find returns the counter of a command, or kNil.
+		uint32_t find(std::wstring_view command) const;
+
+		// walk is find, which also keeps the nodes of the command in m_path.
+		uint32_t walk(std::wstring_view command);
+
+		// better returns true iff a counter is ranked above the best one of a node.
+		bool better(uint32_t counter, uint32_t best) const;
+
+		// link adds the command of a counter to the trie, and unlink removes it.
+		void link(uint32_t counter);
+		void unlink(uint32_t counter);
+
+		// raise updates the best commands of the prefixes of a command whose score increased,
+		// along the path of the command walked last.
+		void raise(uint32_t counter);
+
+		void sift_up(size_t pos);
+		void sift_down(size_t pos);
+
+	private:
+		size_t		m_capacity;
+
+		// Weight of the next use, and its growth per use.
+		double		m_weight{ 1 };
+		double		m_growth;
+
+		std::vector<Counter>	m_counters;
+
+		// Min-heap of the counters by score.
+		std::vector<uint32_t>	m_heap;
+
+		// Trie of the commands. The root is the first node, created with the first command.
+		std::vector<Node>		m_nodes;
+		std::vector<uint32_t>	m_freeNodes;
+
+		// Edges of the trie. The number of slots is a power of two.
+		std::vector<Edge>		m_edges;
+		size_t					m_numEdges{ 0 };
+
+		// Nodes of the command walked last, from the root.
+		std::vector<uint32_t>	m_path;
+	};
+}
@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "GapBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace dbgutils {
+
+	// Smallest gap made when the buffer grows.
+	static constexpr size_t kMinGap = 64;
+
+	GapBuffer::GapBuffer(std::wstring_view text)
+	{
+		assign(text);
+	}
+
+	void GapBuffer::copy_to(std::wstring *out) const
+	{
+		assert(out != nullptr);
+
+		out->resize(length());
+		if (out->empty()) {
+			return;
+		}
+
+		auto *dst = &(*out)[0];
+		std::memcpy(dst, m_buf.data(), m_gapBegin * sizeof(wchar_t));
+		std::memcpy(dst + m_gapBegin, m_buf.data() + m_gapEnd, (m_buf.size() - m_gapEnd) * sizeof(wchar_t));
+	}
+
+	void GapBuffer::copy_to(std::wstring *out, size_t pos, size_t count) const
+	{
+		assert(out != nullptr);
+		assert(pos + count <= length());
+
+		out->resize(count);
+		for (size_t i = 0; i < count; i++) {
+			(*out)[i] = (*this)[pos + i];
+		}
+	}
+
+	void GapBuffer::insert(size_t pos, wchar_t c)
+	{
+		assert(pos <= length());
+
+		move_gap(pos);
+		reserve_gap(1);
+
+		m_buf[m_gapBegin++] = c;
+	}
+
+	void GapBuffer::insert(size_t pos, std::wstring_view text)
+	{
+		assert(pos <= length());
+
+		move_gap(pos);
+		reserve_gap(text.length());
+
+		std::copy(text.begin(), text.end(), m_buf.begin() + m_gapBegin);
+		m_gapBegin += text.length();
+	}
+
+	void GapBuffer::erase(size_t pos, size_t count)
+	{
+		assert(pos + count <= length());
+
+		// The erased characters join the gap.
+		move_gap(pos);
+		m_gapEnd += count;
+	}
+
+	void GapBuffer::assign(std::wstring_view text)
+	{
+		m_buf.assign(text.begin(), text.end());
+		m_buf.resize(text.length() + kMinGap);
+
+		m_gapBegin = text.length();
+		m_gapEnd = m_buf.size();
+	}
+
+	void GapBuffer::move_gap(size_t pos)
+	{
+		assert(pos <= length());
+
+		auto *buf = m_buf.data();
+
+		if (pos < m_gapBegin) {
+			// Move the text in [pos, m_gapBegin) after the gap.
+			auto n = m_gapBegin - pos;
+			std::memmove(buf + m_gapEnd - n, buf + pos, n * sizeof(wchar_t));
+			m_gapBegin -= n;
+			m_gapEnd -= n;
+		}
+		else if (pos > m_gapBegin) {
+			// Move the text in [m_gapEnd, m_gapEnd + n) before the gap.
+			auto n = pos - m_gapBegin;
+			std::memmove(buf + m_gapBegin, buf + m_gapEnd, n * sizeof(wchar_t));
+			m_gapBegin += n;
+			m_gapEnd += n;
+		}
+	}
+
+	void GapBuffer::reserve_gap(size_t n)
+	{
+		if (gap_length() >= n) {
+			return;
+		}
+
+		// Double the buffer so that a series of insertions is amortized O(1).
+		auto tail = m_buf.size() - m_gapEnd;
+		auto newSize = std::max(m_buf.size() * 2, length() + n + kMinGap);
+
+		m_buf.resize(newSize);
+
+		auto newGapEnd = newSize - tail;
+		std::memmove(m_buf.data() + newGapEnd, m_buf.data() + m_gapEnd, tail * sizeof(wchar_t));
+		m_gapEnd = newGapEnd;
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dbgutils {
+
+	//							GAP BUFFER
+	//
+	// A GapBuffer is a string with a hole (the gap) kept where the text is edited.
+	// Inserting or erasing at the gap is O(1) (amortized for insertions); editing
+	// elsewhere first moves the gap, which costs O(distance).
+	// An edit box keeps the gap at the caret, so typing anywhere in a long line
+	// does not move the text after the caret.
+	//
+	//		[ text before the gap | gap | text after the gap ]
+	//
+	// The text is not contiguous: it is read in two segments, or copied into a string
+	// with copy_to.
+	class GapBuffer {
+	public:
+		// The text before the gap, then the text after it.
+		struct Segments {
+			std::wstring_view	first;
+			std::wstring_view	second;
+		};
+
+		GapBuffer(std::wstring_view text = std::wstring_view());
+
+		//		ACCESSORS
+		//
+
+		size_t length() const { return m_buf.size() - gap_length(); }
+		bool empty() const { return length() == 0; }
+
+		wchar_t operator[](size_t i) const
+		{
+			return i < m_gapBegin ? m_buf[i] : m_buf[i + gap_length()];
+		}
+
+		// segments returns the text without copying it.
+		// The views are invalidated by the next call to a manipulator.
+		Segments segments() const
+		{
+			return Segments{
+				std::wstring_view(m_buf.data(), m_gapBegin),
+				std::wstring_view(m_buf.data() + m_gapEnd, m_buf.size() - m_gapEnd) };
+		}
+
+		// copy_to replaces the content of a string with the text of the buffer.
+		void copy_to(std::wstring *out) const;
+
+		// This overload copies the count characters from a position.
+		void copy_to(std::wstring *out, size_t pos, size_t count) const;
+
+		//		MANIPULATORS
+		//
+
+		void insert(size_t pos, wchar_t c);
+		void insert(size_t pos, std::wstring_view text);
+		void erase(size_t pos, size_t count);
+
+		void assign(std::wstring_view text);
+
+	private:
+		size_t gap_length() const { return m_gapEnd - m_gapBegin; }
+
+		// move_gap moves the gap at a position in the text.
+		void move_gap(size_t pos);
+
+		// reserve_gap grows the buffer so that the gap can hold at least n characters.
+		void reserve_gap(size_t n);
+
+	private:
+		std::vector<wchar_t>	m_buf;
+
+		// The gap is [m_gapBegin, m_gapEnd) in m_buf.
+		size_t					m_gapBegin{ 0 };
+		size_t					m_gapEnd{ 0 };
+	};
+}
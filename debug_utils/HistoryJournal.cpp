@@ -0,0 +1,378 @@
+#include "pch.h"
+#include "HistoryJournal.h"
+#include "Checksum.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dbgutils {
+
+	static constexpr uint32_t kMagic = 0x48474244;	// "DBGH"
+	static constexpr uint16_t kVersion = 1;
+
+	struct JournalHeader {
+		uint32_t	magic;
+		uint16_t	version;
+		uint16_t	charSize;
+	};
+
+	static constexpr uint64_t kHeaderBytes = sizeof(JournalHeader);
+
+	// Size of a record without its text: the length, the checksum and the trailing length.
+	static constexpr uint64_t kRecordOverhead = 3 * sizeof(uint32_t);
+
+	static uint32_t record_checksum(uint32_t length, const void *text)
+	{
+		return Checksum().add(length).add(text, length * sizeof(wchar_t)).value();
+	}
+
+	static uint32_t read_u32(const char *p)
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static void write_header(std::ostream &out)
+	{
+		JournalHeader header{ kMagic, kVersion, static_cast<uint16_t>(sizeof(wchar_t)) };
+		out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	}
+
+	// copy_bytes appends the bytes [begin, end) of a file to a stream.
+	static bool copy_bytes(const std::filesystem::path &path, uint64_t begin, uint64_t end, std::ostream &out)
+	{
+		std::ifstream in(path, std::ios::binary);
+		in.seekg(static_cast<std::streamoff>(begin));
+
+		std::vector<char> buf(64 * 1024);
+		for (auto pos = begin; pos < end && in; ) {
+			auto n = static_cast<size_t>(std::min<uint64_t>(buf.size(), end - pos));
+			in.read(buf.data(), n);
+			out.write(buf.data(), in.gcount());
+			pos += in.gcount();
+		}
+
+		return in.good() && out.good();
+	}
+
+	// A read-only mapping of a whole file. It is empty if the file does not exist.
+	class JournalView {
+	public:
+		JournalView(const std::filesystem::path &path);
+		~JournalView();
+
+		JournalView(const JournalView &) = delete;
+		JournalView &operator=(const JournalView &) = delete;
+
+		const char *data() const { return m_view; }
+		uint64_t size() const { return m_size; }
+
+	private:
+		const char	*m_view{ nullptr };
+		uint64_t	m_size{ 0 };
+
+#ifdef _WIN32
+		HANDLE		m_file{ INVALID_HANDLE_VALUE };
+		HANDLE		m_mapping{ nullptr };
+#else
+		int			m_fd{ -1 };
+#endif
+	};
+
+#ifdef _WIN32
+	JournalView::JournalView(const std::filesystem::path &path)
+	{
+		m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE) {
+			return;
+		}
+
+		// An empty file cannot be mapped.
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+			return;
+		}
+
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mapping == nullptr) {
+			return;
+		}
+
+		m_view = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (m_view != nullptr) {
+			m_size = static_cast<uint64_t>(size.QuadPart);
+		}
+	}
+
+	JournalView::~JournalView()
+	{
+		if (m_view) {
+			UnmapViewOfFile(m_view);
+		}
+		if (m_mapping) {
+			CloseHandle(m_mapping);
+		}
+		if (m_file != INVALID_HANDLE_VALUE) {
+			CloseHandle(m_file);
+		}
+	}
+#else
+	JournalView::JournalView(const std::filesystem::path &path)
+	{
+		m_fd = ::open(path.c_str(), O_RDONLY);
+		if (m_fd < 0) {
+			return;
+		}
+
+		struct stat st;
+		if (::fstat(m_fd, &st) != 0 || st.st_size == 0) {
+			return;
+		}
+
+		auto view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, m_fd, 0);
+		if (view != MAP_FAILED) {
+			m_view = static_cast<const char *>(view);
+			m_size = static_cast<uint64_t>(st.st_size);
+		}
+	}
+
+	JournalView::~JournalView()
+	{
+		if (m_view) {
+			::munmap(const_cast<char *>(m_view), static_cast<size_t>(m_size));
+		}
+		if (m_fd >= 0) {
+			::close(m_fd);
+		}
+	}
+#endif
+
+	HistoryJournal::HistoryJournal(const std::filesystem::path &path, size_t capacity, OUT std::vector<std::wstring> *records)
+		: m_path(path)
+		, m_capacity(capacity)
+	{
+		assert(capacity >= 1);
+		assert(records != nullptr);
+
+		// A temporary file left by a compaction which did not complete.
+		std::error_code ec;
+		std::filesystem::remove(temp_path(), ec);
+
+		auto validBytes = load(records);
+
+		if (validBytes < kHeaderBytes) {
+			std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+			write_header(out);
+			validBytes = kHeaderBytes;
+		}
+		else if (validBytes < std::filesystem::file_size(m_path, ec)) {
+			std::filesystem::resize_file(m_path, validBytes, ec);
+		}
+
+		m_stream.open(m_path, std::ios::binary | std::ios::app);
+		if (!m_stream) {
+			throw std::runtime_error("HistoryJournal failed to open its file.");
+		}
+		m_fileSize = validBytes;
+	}
+
+	HistoryJournal::~HistoryJournal()
+	{
+		wait_for_compaction();
+	}
+
+	uint64_t HistoryJournal::load(OUT std::vector<std::wstring> *records)
+	{
+		records->clear();
+
+		JournalView view(m_path);
+		auto data = view.data();
+		auto size = view.size();
+
+		JournalHeader header;
+		if (size < kHeaderBytes) {
+			return 0;
+		}
+		std::memcpy(&header, data, sizeof(header));
+		if (header.magic != kMagic || header.version != kVersion || header.charSize != sizeof(wchar_t)) {
+			return 0;
+		}
+
+		// record_at returns the size of the record starting at a position, or 0 if it is
+		// not intact. The end is the end of the valid part of the file.
+		auto record_at = [&](uint64_t pos, uint64_t end) -> uint64_t {
+			if (end - pos < kRecordOverhead) {
+				return 0;
+			}
+			auto length = read_u32(data + pos);
+			auto bytes = kRecordOverhead + uint64_t(length) * sizeof(wchar_t);
+			if (bytes > end - pos
+				|| read_u32(data + pos + bytes - sizeof(uint32_t)) != length
+				|| read_u32(data + pos + sizeof(uint32_t)) != record_checksum(length, data + pos + 2 * sizeof(uint32_t))) {
+				return 0;
+			}
+			return bytes;
+		};
+
+		auto text_at = [&](uint64_t pos) {
+			std::wstring text(read_u32(data + pos), L'\0');
+			std::memcpy(&text[0], data + pos + 2 * sizeof(uint32_t), text.length() * sizeof(wchar_t));
+			return text;
+		};
+
+		// Backwards from the end, with the trailing lengths.
+		auto pos = size;
+		while (records->size() < m_capacity && pos > kHeaderBytes) {
+			if (pos - kHeaderBytes < kRecordOverhead) {
+				break;
+			}
+			auto length = read_u32(data + pos - sizeof(uint32_t));
+			auto bytes = kRecordOverhead + uint64_t(length) * sizeof(wchar_t);
+			if (bytes > pos - kHeaderBytes || record_at(pos - bytes, pos) != bytes) {
+				break;
+			}
+
+			pos -= bytes;
+			records->push_back(text_at(pos));
+			m_recordBytes.push_front(bytes);
+			m_liveBytes += bytes;
+		}
+
+		// The scan stopped at a record which is not intact in the middle of the file: the
+		// records after it are kept, and the ones before it are lost.
+		if (records->size() == m_capacity || pos == kHeaderBytes || pos < size) {
+			std::reverse(records->begin(), records->end());
+			return size;
+		}
+
+		// The latest record is torn: forwards from the beginning, up to the first record which
+		// is not intact.
+		records->clear();
+		m_recordBytes.clear();
+		m_liveBytes = 0;
+
+		std::deque<std::wstring> latest;
+		pos = kHeaderBytes;
+		for (auto bytes = record_at(pos, size); bytes > 0; bytes = record_at(pos, size)) {
+			latest.push_back(text_at(pos));
+			track(bytes);
+			if (latest.size() > m_capacity) {
+				latest.pop_front();
+			}
+			pos += bytes;
+		}
+
+		records->assign(std::make_move_iterator(latest.begin()), std::make_move_iterator(latest.end()));
+		return pos;
+	}
+
+	void HistoryJournal::track(uint64_t recordBytes)
+	{
+		m_recordBytes.push_back(recordBytes);
+		m_liveBytes += recordBytes;
+
+		if (m_recordBytes.size() > m_capacity) {
+			m_liveBytes -= m_recordBytes.front();
+			m_recordBytes.pop_front();
+		}
+	}
+
+	void HistoryJournal::append(std::wstring_view line)
+	{
+		if (is_compacting() && m_compaction.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+			finish_compaction();
+		}
+
+		auto length = static_cast<uint32_t>(line.length());
+		auto checksum = record_checksum(length, line.data());
+		auto textBytes = line.length() * sizeof(wchar_t);
+
+		m_record.resize(kRecordOverhead + textBytes);
+		auto p = m_record.data();
+		std::memcpy(p, &length, sizeof(length));
+		std::memcpy(p + sizeof(uint32_t), &checksum, sizeof(checksum));
+		std::memcpy(p + 2 * sizeof(uint32_t), line.data(), textBytes);
+		std::memcpy(p + 2 * sizeof(uint32_t) + textBytes, &length, sizeof(length));
+
+		m_stream.write(m_record.data(), m_record.size());
+		m_stream.flush();
+		if (!m_stream) {
+			return;
+		}
+
+		m_fileSize += m_record.size();
+		track(m_record.size());
+
+		if (!is_compacting()
+			&& m_fileSize >= kMinCompactionBytes
+			&& m_fileSize > kCompactionRatio * (kHeaderBytes + m_liveBytes)) {
+			start_compaction();
+		}
+	}
+
+	void HistoryJournal::wait_for_compaction()
+	{
+		if (is_compacting()) {
+			finish_compaction();
+		}
+	}
+
+	void HistoryJournal::start_compaction()
+	{
+		assert(!is_compacting());
+
+		m_compactionStart = m_fileSize - m_liveBytes;
+		m_compactionEnd = m_fileSize;
+
+		m_compaction = std::async(std::launch::async, [path = m_path, temp = temp_path(), begin = m_compactionStart, end = m_compactionEnd]() {
+			std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+			write_header(out);
+			return copy_bytes(path, begin, end, out);
+		});
+	}
+
+	void HistoryJournal::finish_compaction()
+	{
+		auto copied = m_compaction.get();
+		auto temp = temp_path();
+		std::error_code ec;
+
+		// The records appended during the copy which are still live. If all the copied records
+		// are dead by now, they are kept anyway: the file is at most twice the live records.
+		auto tailStart = std::max(m_compactionEnd, m_fileSize - m_liveBytes);
+		if (copied) {
+			std::ofstream out(temp, std::ios::binary | std::ios::app);
+			copied = copy_bytes(m_path, tailStart, m_fileSize, out);
+		}
+
+		if (copied) {
+			m_stream.close();
+			std::filesystem::rename(temp, m_path, ec);
+			m_stream.open(m_path, std::ios::binary | std::ios::app);
+			if (!ec) {
+				m_fileSize = kHeaderBytes + (m_compactionEnd - m_compactionStart) + (m_fileSize - tailStart);
+			}
+		}
+
+		std::filesystem::remove(temp, ec);
+	}
+
+	std::filesystem::path HistoryJournal::temp_path() const
+	{
+		auto temp = m_path;
+		temp += ".tmp";
+		return temp;
+	}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define IN
+#define OUT
+#define OPTIONAL
+
+namespace dbgutils {
+
+	//							HISTORY JOURNAL
+	//
+	// The HistoryJournal makes the command lines of a ConsoleHistory survive a restart of
+	// the process. Every pushed line is appended to a file as a record, and the next start
+	// loads the latest lines back.
+	//
+	// FILE LAYOUT
+	//	header	magic, version and size of a character.
+	//	records	one per line, in push order:
+	//			[length][checksum][text][length]
+	//			The length (in characters) and the checksum (of the length and the text) are
+	//			32-bit integers. The trailing copy of the length lets the file be read backwards.
+	//
+	// LOADING
+	//	The file is mapped and read backwards from its end, up to the capacity of the history,
+	//	so loading costs O(capacity) whatever the size of the file. If the latest record is torn
+	//	(the process died while writing it), the file is read forwards once instead: the valid
+	//	records are kept, and the file is truncated after them. A record which is not intact in
+	//	the middle of the file ends the backward read: the records after it are kept, and the
+	//	file is left as it is.
+	//
+	// COMPACTION
+	//	Only the latest capacity records are live. When the file grows larger than
+	//	kCompactionRatio times the live records, a worker thread copies the live records into
+	//	a temporary file while the appends go on. The next call (append, wait_for_compaction or
+	//	the destructor) after the copy completes appends the live records written in the meantime
+	//	to the temporary file, and replaces the journal with it.
+	//
+	// REMARKS
+	//	The records are flushed one by one, so they survive a crash of the process.
+	//	The write errors are ignored: the history goes on without being persisted.
+	//	There is a single writer: the file must not be opened by two processes at once.
+	class HistoryJournal {
+	public:
+		// Size of the file, relative to the live records, above which it is compacted.
+		static constexpr size_t kCompactionRatio = 4;
+
+		// Size of a file below which it is never compacted.
+		static constexpr uint64_t kMinCompactionBytes = 64 * 1024;
+
+		// Opens or creates the journal, and loads its latest records. A file which is not
+		// a journal is reset.
+		//
+		// INPUT
+		//	capacity	maximum number of records to load: the capacity of the history.
+		//
+		// OUTPUT
+		//	records		the loaded records, from the oldest to the latest.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened.
+		HistoryJournal(const std::filesystem::path &path, size_t capacity, OUT std::vector<std::wstring> *records);
+		~HistoryJournal();
+
+		HistoryJournal(const HistoryJournal &) = delete;
+		HistoryJournal &operator=(const HistoryJournal &) = delete;
+
+		//		ACCESSORS
+		//
+
+		const std::filesystem::path &path() const { return m_path; }
+
+		// file_size returns the size of the journal, in bytes.
+		uint64_t file_size() const { return m_fileSize; }
+
+		// live_bytes returns the size of the latest capacity records, in bytes.
+		uint64_t live_bytes() const { return m_liveBytes; }
+
+		bool is_compacting() const { return m_compaction.valid(); }
+
+		//		MANIPULATORS
+		//
+
+		// append writes a record at the end of the journal.
+		void append(std::wstring_view line);
+
+		// wait_for_compaction waits for the running compaction, if any, and replaces the
+		// journal with the compacted file.
+		void wait_for_compaction();
+
+	private:
+		// load reads the latest records of the file, and returns the size of its valid part.
+		uint64_t load(OUT std::vector<std::wstring> *records);
+
+		// track adds the size of a new record to the live records.
+		void track(uint64_t recordBytes);
+
+		void start_compaction();
+		void finish_compaction();
+
+		std::filesystem::path temp_path() const;
+
+	private:
+		std::filesystem::path	m_path;
+		size_t					m_capacity;
+
+		std::ofstream			m_stream;
+		uint64_t				m_fileSize{ 0 };
+
+		// Sizes of the live records, from the oldest to the latest, and their sum.
+		// The live records are the last ones of the file.
+		std::deque<uint64_t>	m_recordBytes;
+		uint64_t				m_liveBytes{ 0 };
+
+		// The running compaction returns true iff the bytes [m_compactionStart, m_compactionEnd)
+		// of the file, the live records when it started, were copied into the temporary file.
+		std::future<bool>		m_compaction;
+		uint64_t				m_compactionStart{ 0 };
+		uint64_t				m_compactionEnd{ 0 };
+
+		// Buffer of the record being appended.
+		std::vector<char>		m_record;
+	};
+}
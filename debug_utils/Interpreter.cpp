@@ -5,50 +5,155 @@
 
 namespace dbgutils {
 
-	std::wstring Interpreter::execute(const std::wstring &input)
+	void ICommand::execute(const CmdArgViews &args, IOutputSink &out)
 	{
-		auto in = input;
-		wstr_trim(in);
+		out.write(execute(args));
+	}
+
+	std::wstring ICommand::execute(const CmdArgViews &args)
+	{
+		return execute(CmdArgs(args.begin(), args.end()));
+	}
 
-		std::wstring output;
+	std::wstring ICommand::output_of(const CmdArgs &args)
+	{
+		std::vector<std::wstring_view> views(args.begin(), args.end());
+
+		ChunkedText out;
+		execute(CmdArgViews(views.data(), views.size()), out);
+		return out.str();
+	}
 
-		for (auto &cmd : m_cmds) {
-			std::wstring cmdNames[] = { cmd->Alias(), cmd->Name() };
-			for (const auto &name : cmdNames) {
-				auto ok = try_cmd(cmd, name, input, &output);
-				if (ok) {// Success!
-					return output;
-				}
+	Interpreter::Interpreter(const CmdList &cmds)
+		: m_cmds(cmds)
+	{
+		for (const auto &cmd : m_cmds) {
+			index_command(cmd);
+		}
+	}
+
+	void Interpreter::InstallCommand(const std::shared_ptr<dbgutils::ICommand> &cmd)
+	{
+		m_cmds.push_back(cmd);
+		index_command(cmd);
+	}
+
+	void Interpreter::index_command(const std::shared_ptr<ICommand> &cmd)
+	{
+		assert(cmd != nullptr);
+
+		index_token(cmd->Name(), cmd, false);
+		index_token(cmd->Alias(), cmd, true);
+	}
+
+	void Interpreter::index_token(const std::wstring &token, const std::shared_ptr<ICommand> &cmd, bool isAlias)
+	{
+		if (token.length() == 0) {
+			return;
+		}
+
+		auto it = m_dispatch.find(token);
+		if (it != m_dispatch.end()) {
+			// A name always beats an alias.
+			if (isAlias && !it->second.isAlias) {
+				return;
 			}
+
+			// The key is a view on the string of the command being replaced
+			// so we have to rekey the entry on the new command's string.
+			m_dispatch.erase(it);
+		}
+
+		m_dispatch.emplace(std::wstring_view(token), DispatchEntry{ cmd, isAlias });
+	}
+
+	ICommand *Interpreter::find_command(std::wstring_view token) const
+	{
+		auto it = m_dispatch.find(token);
+		if (it == m_dispatch.end()) {
+			return nullptr;
 		}
 
-		// Failure
-		return L"Unknown command";
+		return it->second.cmd.get();
 	}
 
-	bool Interpreter::try_cmd(std::shared_ptr<ICommand> cmd, const std::wstring cmdName, const std::wstring &input, std::wstring *output)
+	std::shared_ptr<ICommand> Interpreter::find_command_in(std::wstring_view input) const
 	{
-		assert(output != nullptr);
+		// Extract the first token.
+		size_t begin = 0;
+		while (begin < input.length() && wstr_is_space(input[begin])) {
+			begin++;
+		}
 
-		if (cmdName.length() == 0) {
-			return false;
+		auto end = begin;
+		while (end < input.length() && !wstr_is_space(input[end])) {
+			end++;
 		}
 
-		// Look for the command name in the input string.
-		size_t i;
-		auto found = wstr_find_substr(input, cmdName, 0, &i);
-		if (!found) {
-			return false;
+		auto it = m_dispatch.find(input.substr(begin, end - begin));
+		if (it == m_dispatch.end()) {
+			return nullptr;
 		}
 
-		// Compute the command arguments.
-		auto rest = input.substr(i + cmdName.length());
-		wstr_ltrim(rest);
-		auto args = wstr_split(rest);
+		return it->second.cmd;
+	}
+
+	void Interpreter::run_command(ICommand &cmd, std::wstring_view input, IOutputSink &out, CommandStats *stats)
+	{
+		uint64_t t0 = stats ? CommandProfiler::steady_clock_ns() : 0;
+
+		std::vector<std::wstring_view> tokens;
+		wstr_tokenize(input, &tokens);
+		assert(!tokens.empty());
+
+		uint64_t t1 = stats ? CommandProfiler::steady_clock_ns() : 0;
+
+		cmd.execute(CmdArgViews(tokens.data() + 1, tokens.size() - 1), out);
+
+		if (stats) {
+			stats->record(t1 - t0, CommandProfiler::steady_clock_ns() - t1);
+		}
+	}
+
+	void Interpreter::execute(std::wstring_view input, IOutputSink &out)
+	{
+		const auto profiling = m_profiler.enabled();
+		uint64_t t0 = profiling ? CommandProfiler::steady_clock_ns() : 0;
+
+		wstr_tokenize(input, &m_tokens);
+		if (m_tokens.empty()) {
+			out.write(L"Unknown command");
+			return;
+		}
+
+		// The command name is the first token of the input.
+		auto *cmd = find_command(m_tokens[0]);
+		if (!cmd) {
+			// Failure
+			out.write(L"Unknown command");
+			return;
+		}
+
+		if (!profiling) {
+			// Execute it!
+			cmd->execute(CmdArgViews(m_tokens.data() + 1, m_tokens.size() - 1), out);
+			return;
+		}
+
+		auto *stats = m_profiler.stats_for(*cmd);
+		uint64_t t1 = CommandProfiler::steady_clock_ns();
 
 		// Execute it!
-		*output = cmd->execute(args);
+		cmd->execute(CmdArgViews(m_tokens.data() + 1, m_tokens.size() - 1), out);
+
+		stats->record(t1 - t0, CommandProfiler::steady_clock_ns() - t1);
+	}
+
+	std::wstring Interpreter::execute(std::wstring_view input)
+	{
+		ChunkedText output;
+		execute(input, output);
 
-		return true;
+		return output.str();
 	}
-}
\ No newline at end of file
+}
@@ -2,11 +2,38 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include "OutputSink.h"
+#include "CommandProfiler.h"
 
 namespace dbgutils {
 
 	using CmdArgs = std::vector<std::wstring>;
 
+	// CmdArgViews is a read-only view on a contiguous sequence of command arguments.
+	// The arguments are themselves views on the command line being executed so they
+	// must not be stored beyond the call to ICommand::execute.
+	class CmdArgViews {
+	public:
+		CmdArgViews(const std::wstring_view *data = nullptr, size_t size = 0)
+			: m_data(data)
+			, m_size(size)
+		{}
+
+		auto size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+
+		const std::wstring_view &operator[](size_t i) const { return m_data[i]; }
+
+		const std::wstring_view *begin() const { return m_data; }
+		const std::wstring_view *end() const { return m_data + m_size; }
+
+	private:
+		const std::wstring_view	*m_data;
+		size_t					m_size;
+	};
+
 	class ICommand {
 	public:
 		ICommand(const std::wstring &name, const std::wstring &alias = L"")
@@ -21,10 +48,32 @@ namespace dbgutils {
 		const auto &Name() const { return m_name; }
 		const auto &Alias() const { return m_alias; }
 
+		// is_async returns true iff the command wants to be executed on a worker thread
+		// by the console. Such a command must not touch the console and must support
+		// being executed by several threads at the same time.
+		virtual bool is_async() const { return false; }
+
 		//		MANIPULATORS
 		//
+
+		// A command implements the CmdArgs overload, and may override the two others
+		// as shortcuts.
+		//
+		// The interpreter calls the IOutputSink overload. By default it writes the string
+		// returned by the CmdArgViews overload into the sink. Commands producing large
+		// outputs should override it and write their output chunk by chunk instead.
+		//
+		// By default, the CmdArgViews overload copies the arguments and calls the CmdArgs
+		// overload. Commands which should not allocate anything override it.
+		virtual void execute(const CmdArgViews &args, IOutputSink &out);
+		virtual std::wstring execute(const CmdArgViews &args);
 		virtual std::wstring execute(const CmdArgs &args) = 0;
 
+	protected:
+		// output_of returns the output written by the IOutputSink overload. The commands
+		// overriding it can implement the CmdArgs overload with it.
+		std::wstring output_of(const CmdArgs &args);
+
 	private:
 		// The usual name e.g. print for a print command.
 		std::wstring	m_name;
@@ -39,34 +88,78 @@ namespace dbgutils {
 
 	class Interpreter {
 	public:
-		Interpreter(const CmdList &cmds = {})
-			: m_cmds(cmds)
-		{}
+		Interpreter(const CmdList &cmds = {});
 
 		//		ACCESSORS
 		//
 		
 		const auto &GetCommands() const { return m_cmds; }
 
+		// The profiler records the execution statistics of the commands.
+		// It is enabled by default.
+		const auto &profiler() const { return m_profiler; }
+		auto &profiler() { return m_profiler; }
+
+		// find_command returns the command whose name or alias is exactly equal to the token.
+		// It returns nullptr if no such command is installed.
+		//
+		// REMARKS
+		//	The lookup only hashes the token so its cost does not depend on the number
+		//	of installed commands. Commands whose names share a prefix (e.g. "ls" and "lsx")
+		//	never clash since a token must match a whole name. When a token is registered
+		//	several times, the tie is broken as follows:
+		//		(1) a name always beats an alias,
+		//		(2) between two names, or two aliases, the latest installed command wins.
+		ICommand *find_command(std::wstring_view token) const;
+
+		// find_command_in returns the command that a command line dispatches to.
+		// It returns nullptr if the first token of the line is not a command name.
+		std::shared_ptr<ICommand> find_command_in(std::wstring_view input) const;
+
+		// run_command executes a command with the arguments found in a command line,
+		// i.e. all its tokens but the first one. The execution is recorded into the
+		// statistics if they are not null.
+		//
+		// REMARKS
+		//	This function does not use any interpreter state so it can be called from any thread.
+		//	The statistics should be obtained beforehand from the interpreter's profiler.
+		static void run_command(ICommand &cmd, std::wstring_view input, IOutputSink &out, CommandStats *stats = nullptr);
+
 
 		//		MANIPULATORS
 		//
 		
-		void InstallCommand(const std::shared_ptr<dbgutils::ICommand> &cmd)
-		{
-			m_cmds.push_back(cmd);
-		}
+		void InstallCommand(const std::shared_ptr<dbgutils::ICommand> &cmd);
+
+		// execute runs a command line and writes the output of the command into a sink.
+		void execute(std::wstring_view input, IOutputSink &out);
 
-		std::wstring execute(const std::wstring &input);
+		// This overload returns the whole output as a single string.
+		std::wstring execute(std::wstring_view input);
 
 
 	private:
-		// try_cmd attempts to execute the command if its name matches the first token in the input.
-		// RETURN VALUE
-		//	Returns true iff the command name matched the first token of the input.
-		bool try_cmd(std::shared_ptr<ICommand> cmd, const std::wstring cmdName, const std::wstring &input, std::wstring *output);
+		// index_command adds the name and alias of a command to the dispatch table.
+		void index_command(const std::shared_ptr<ICommand> &cmd);
+		void index_token(const std::wstring &token, const std::shared_ptr<ICommand> &cmd, bool isAlias);
 
 	private:
 		CmdList		m_cmds;
+
+		// Tokens of the command line being executed.
+		// The vector is reused from one call to another to avoid allocations.
+		std::vector<std::wstring_view>	m_tokens;
+
+		CommandProfiler		m_profiler;
+
+		struct DispatchEntry {
+			std::shared_ptr<ICommand>	cmd;
+			bool						isAlias{ false };
+		};
+
+		// Dispatch table mapping command names and aliases to the commands.
+		// The keys are views on the strings owned by the commands themselves,
+		// which are kept alive by the entries.
+		std::unordered_map<std::wstring_view, DispatchEntry>	m_dispatch;
 	};
-}
\ No newline at end of file
+}
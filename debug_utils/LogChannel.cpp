@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "LogChannel.h"
+#include <algorithm>
+#include <cassert>
+
+namespace dbgutils {
+
+	static std::atomic<uint64_t> g_nextChannelId{ 0 };
+
+	LogChannel::LogChannel(size_t perThreadCapacity)
+		: m_id(g_nextChannelId.fetch_add(1))
+		, m_perThreadCapacity(perThreadCapacity)
+	{
+		assert(perThreadCapacity >= 1);
+	}
+
+	uint64_t LogChannel::dropped() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto n = m_droppedByReleasedRings;
+		for (const auto &ring : m_rings) {
+			n += ring->dropped();
+		}
+
+		return n;
+	}
+
+	size_t LogChannel::num_producers() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		return m_rings.size();
+	}
+
+	void LogChannel::log(std::wstring_view text)
+	{
+		auto &ring = producer_ring();
+
+		LogMessage msg;
+		msg.seq = m_nextSeq.fetch_add(1, std::memory_order_relaxed);
+		msg.text = text;
+
+		ring.push_back(msg);
+	}
+
+	LogChannel::Ring &LogChannel::producer_ring()
+	{
+		// Each thread caches the buffers it owns, one per channel it logs into.
+		struct CacheEntry {
+			uint64_t				channelId;
+			std::shared_ptr<Ring>	ring;
+		};
+		thread_local std::vector<CacheEntry> cache;
+
+		for (const auto &e : cache) {
+			if (e.channelId == m_id) {
+				return *e.ring;
+			}
+		}
+
+		// First message from this thread.
+		auto ring = std::make_shared<Ring>(m_perThreadCapacity);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_rings.push_back(ring);
+		}
+
+		// Forget the buffers of the channels that were destroyed.
+		cache.erase(std::remove_if(cache.begin(), cache.end(), [](const CacheEntry &e) {
+			return e.ring.use_count() == 1;
+		}), cache.end());
+
+		cache.push_back(CacheEntry{ m_id, ring });
+
+		return *ring;
+	}
+
+	size_t LogChannel::drain(std::vector<LogMessage> *batch)
+	{
+		assert(batch != nullptr);
+
+		const auto first = batch->size();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		LogMessage msg;
+		for (auto &ring : m_rings) {
+			while (ring->pop_front(&msg)) {
+				batch->push_back(std::move(msg));
+			}
+		}
+
+		// Release the buffers of the threads that exited.
+		// A buffer only referenced by the channel cannot receive messages anymore.
+		auto it = std::remove_if(m_rings.begin(), m_rings.end(), [this](const std::shared_ptr<Ring> &ring) {
+			if (ring.use_count() == 1 && ring->empty()) {
+				m_droppedByReleasedRings += ring->dropped();
+				return true;
+			}
+			return false;
+		});
+		m_rings.erase(it, m_rings.end());
+
+		// Each buffer gave its messages in order, so we merge them by sequence number.
+		std::sort(batch->begin() + first, batch->end(), [](const LogMessage &a, const LogMessage &b) {
+			return a.seq < b.seq;
+		});
+
+		return batch->size() - first;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SpscOvwRingBuf.h"
+
+namespace dbgutils {
+
+	// A message sent through a LogChannel.
+	struct LogMessage {
+		// Global sequence number, taken when the message is logged.
+		uint64_t		seq{ 0 };
+		std::wstring	text;
+	};
+
+	//							LOG CHANNEL
+	//
+	// A multi-producer/single-consumer channel carrying log messages from any thread
+	// to the thread owning the console, which drains them in batches (e.g. once per frame).
+	//
+	// Each producer thread gets its own SpscOvwRingBuf the first time it logs into the
+	// channel, so logging never blocks: when a producer's buffer is full, its oldest
+	// message is dropped.
+	//
+	// ORDERING GUARANTEES
+	//	(1) The messages of a given thread are received in the order they were logged.
+	//	(2) Every message gets a global sequence number when it is logged, and the
+	//		messages of a batch are sorted by sequence number.
+	//	A message logged just before a drain may however miss the batch and be received
+	//	with the next batch, after messages with greater sequence numbers.
+	class LogChannel {
+	public:
+		LogChannel(size_t perThreadCapacity = 1024);
+
+		LogChannel(const LogChannel &) = delete;
+		LogChannel &operator=(const LogChannel &) = delete;
+
+		//		ACCESSORS
+		//
+
+		// dropped returns the number of messages that were lost because
+		// a producer's buffer was full.
+		uint64_t dropped() const;
+
+		// num_producers returns the number of producer buffers.
+		size_t num_producers() const;
+
+		//		MANIPULATORS
+		//
+
+		// log sends a message. It can be called by any thread.
+		//
+		// REMARKS
+		//	The first call from a given thread allocates the thread's buffer.
+		void log(std::wstring_view text);
+
+		// drain appends all the available messages to a batch, sorted by sequence number.
+		// It must only be called by a single consumer thread.
+		//
+		// RETURN VALUE
+		//	Returns the number of messages appended.
+		size_t drain(std::vector<LogMessage> *batch);
+
+	private:
+		using Ring = SpscOvwRingBuf<LogMessage>;
+
+		// producer_ring returns the buffer of the calling thread.
+		Ring &producer_ring();
+
+	private:
+		// Identifies the channel in the per-thread buffer caches.
+		// Addresses cannot be used since a new channel may reuse the address of a dead one.
+		const uint64_t			m_id;
+
+		const size_t			m_perThreadCapacity;
+
+		std::atomic<uint64_t>	m_nextSeq{ 0 };
+
+		// The producers' buffers. The mutex is only taken when a thread logs for the first time
+		// and by drain. A buffer is shared with its thread's cache, and it is released once its
+		// thread has exited and it has been drained.
+		mutable std::mutex					m_mutex;
+		std::vector<std::shared_ptr<Ring>>	m_rings;
+
+		// Messages dropped by the buffers that were released.
+		uint64_t				m_droppedByReleasedRings{ 0 };
+	};
+}
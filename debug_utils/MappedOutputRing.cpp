@@ -0,0 +1,273 @@
+#include "pch.h"
+#include "MappedOutputRing.h"
+#include "Checksum.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace dbgutils {
+
+	static constexpr uint32_t kMagic = 0x4f474244;	// "DBGO"
+	static constexpr uint32_t kVersion = 1;
+
+	struct MappedOutputRing::Header {
+		uint32_t				magic;
+		uint32_t				version;
+		uint32_t				charSize;
+		uint32_t				generation;
+		uint64_t				numSlots;
+		uint64_t				dataCapacity;
+		uint32_t				checksum;
+
+		// Written for every record, on their own cache line.
+		alignas(64) std::atomic<uint64_t>	writeIndex;
+		std::atomic<uint64_t>				head;	// logical position in the data ring
+	};
+
+	struct MappedOutputRing::Slot {
+		uint64_t	number;
+		uint64_t	start;	// logical position of the text in the data ring
+		uint32_t	length;
+		uint32_t	generation;
+		uint32_t	checksum;
+		uint32_t	reserved;
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "The atomics of the header live in a shared file.");
+	static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "The atomics of the header live in a shared file.");
+
+	static uint32_t header_checksum(uint32_t magic, uint32_t version, uint32_t charSize,
+		uint32_t generation, uint64_t numSlots, uint64_t dataCapacity)
+	{
+		return Checksum().add(magic).add(version).add(charSize).add(generation)
+			.add(numSlots).add(dataCapacity).value();
+	}
+
+	static uint32_t slot_checksum(uint64_t number, uint64_t start, uint32_t length, uint32_t generation)
+	{
+		return Checksum().add(number).add(start).add(length).add(generation).value();
+	}
+
+	MappedOutputRing::MappedOutputRing(const std::filesystem::path &path, size_t dataBytes, size_t numSlots)
+		: m_dataCapacity(dataBytes / sizeof(wchar_t))
+		, m_numSlots(numSlots)
+	{
+		assert(m_dataCapacity >= 1);
+		assert(m_numSlots >= 1);
+
+		map_file(path, sizeof(Header) + m_numSlots * sizeof(Slot) + m_dataCapacity * sizeof(wchar_t));
+
+		auto &h = header();
+		auto sameRing = h.magic == kMagic
+			&& h.version == kVersion
+			&& h.charSize == sizeof(wchar_t)
+			&& h.numSlots == m_numSlots
+			&& h.dataCapacity == m_dataCapacity
+			&& h.checksum == header_checksum(h.magic, h.version, h.charSize, h.generation, h.numSlots, h.dataCapacity);
+
+		if (!sameRing) {
+			reset();
+			return;
+		}
+
+		h.generation++;
+		h.checksum = header_checksum(h.magic, h.version, h.charSize, h.generation, h.numSlots, h.dataCapacity);
+	}
+
+	MappedOutputRing::~MappedOutputRing()
+	{
+		unmap_file();
+	}
+
+	uint32_t MappedOutputRing::generation() const
+	{
+		return header().generation;
+	}
+
+	uint64_t MappedOutputRing::write_index() const
+	{
+		return header().writeIndex.load(std::memory_order_acquire);
+	}
+
+	std::vector<MappedOutputRecord> MappedOutputRing::records() const
+	{
+		const auto &h = header();
+		auto writeIndex = h.writeIndex.load(std::memory_order_acquire);
+		auto head = h.head.load(std::memory_order_relaxed);
+
+		// Walk back from the latest record until one is missing.
+		std::vector<MappedOutputRecord> records;
+		for (auto number = writeIndex; number > 0 && records.size() < m_numSlots; number--) {
+			const auto &s = slot(number - 1);
+			if (!is_valid(s, number - 1, head)) {
+				break;
+			}
+			records.push_back(MappedOutputRecord{ s.number, s.generation, std::wstring(data_at(s.start), s.length) });
+		}
+
+		std::reverse(records.begin(), records.end());
+
+		return records;
+	}
+
+	void MappedOutputRing::append(std::wstring_view text)
+	{
+		auto &h = header();
+		auto n = std::min(text.length(), m_dataCapacity);
+
+		// The text is kept contiguous: if it would cross the end of the ring,
+		// it starts at the beginning of the ring.
+		auto start = h.head.load(std::memory_order_relaxed);
+		auto offset = static_cast<size_t>(start % m_dataCapacity);
+		if (offset + n > m_dataCapacity) {
+			start += m_dataCapacity - offset;
+		}
+
+		// Move the head before overwriting the text of the oldest records, so that they
+		// are not recovered if the process dies during the copy. A crash is seen by the
+		// file like a signal by the thread, so a compiler fence is enough.
+		h.head.store(start + n, std::memory_order_relaxed);
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+
+		std::memcpy(data_at(start), text.data(), n * sizeof(wchar_t));
+
+		auto number = h.writeIndex.load(std::memory_order_relaxed);
+		auto &s = slot(number);
+		s.number = number;
+		s.start = start;
+		s.length = static_cast<uint32_t>(n);
+		s.generation = h.generation;
+		s.checksum = slot_checksum(s.number, s.start, s.length, s.generation);
+
+		// Publish the record.
+		h.writeIndex.store(number + 1, std::memory_order_release);
+	}
+
+	void MappedOutputRing::reset()
+	{
+		std::memset(m_view, 0, sizeof(Header) + m_numSlots * sizeof(Slot));
+
+		auto &h = header();
+		h.magic = kMagic;
+		h.version = kVersion;
+		h.charSize = sizeof(wchar_t);
+		h.generation = 1;
+		h.numSlots = m_numSlots;
+		h.dataCapacity = m_dataCapacity;
+		h.checksum = header_checksum(h.magic, h.version, h.charSize, h.generation, h.numSlots, h.dataCapacity);
+	}
+
+	MappedOutputRing::Header &MappedOutputRing::header() const
+	{
+		return *reinterpret_cast<Header *>(m_view);
+	}
+
+	MappedOutputRing::Slot &MappedOutputRing::slot(uint64_t number) const
+	{
+		auto slots = reinterpret_cast<Slot *>(m_view + sizeof(Header));
+
+		return slots[number % m_numSlots];
+	}
+
+	wchar_t *MappedOutputRing::data_at(uint64_t pos) const
+	{
+		auto data = reinterpret_cast<wchar_t *>(m_view + sizeof(Header) + m_numSlots * sizeof(Slot));
+
+		return data + pos % m_dataCapacity;
+	}
+
+	bool MappedOutputRing::is_valid(const Slot &s, uint64_t number, uint64_t head) const
+	{
+		return s.number == number
+			&& s.checksum == slot_checksum(s.number, s.start, s.length, s.generation)
+			&& s.length <= m_dataCapacity
+			&& s.start + s.length <= head
+			&& head - s.start <= m_dataCapacity;
+	}
+
+#ifdef _WIN32
+	void MappedOutputRing::map_file(const std::filesystem::path &path, size_t fileSize)
+	{
+		auto file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+			nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("MappedOutputRing failed to open its file.");
+		}
+		m_file = file;
+
+		// The mapping grows the file to its size if needed.
+		auto size = static_cast<uint64_t>(fileSize);
+		m_mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+		if (m_mapping == nullptr) {
+			unmap_file();
+			throw std::runtime_error("MappedOutputRing failed to map its file.");
+		}
+
+		m_view = static_cast<char *>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, fileSize));
+		if (m_view == nullptr) {
+			unmap_file();
+			throw std::runtime_error("MappedOutputRing failed to map its file.");
+		}
+		m_viewSize = fileSize;
+	}
+
+	void MappedOutputRing::unmap_file()
+	{
+		if (m_view) {
+			UnmapViewOfFile(m_view);
+			m_view = nullptr;
+		}
+		if (m_mapping) {
+			CloseHandle(m_mapping);
+			m_mapping = nullptr;
+		}
+		if (m_file) {
+			CloseHandle(m_file);
+			m_file = nullptr;
+		}
+	}
+#else
+	void MappedOutputRing::map_file(const std::filesystem::path &path, size_t fileSize)
+	{
+		m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+		if (m_fd < 0) {
+			throw std::runtime_error("MappedOutputRing failed to open its file.");
+		}
+
+		if (::ftruncate(m_fd, static_cast<off_t>(fileSize)) != 0) {
+			unmap_file();
+			throw std::runtime_error("MappedOutputRing failed to resize its file.");
+		}
+
+		auto view = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+		if (view == MAP_FAILED) {
+			unmap_file();
+			throw std::runtime_error("MappedOutputRing failed to map its file.");
+		}
+		m_view = static_cast<char *>(view);
+		m_viewSize = fileSize;
+	}
+
+	void MappedOutputRing::unmap_file()
+	{
+		if (m_view) {
+			::munmap(m_view, m_viewSize);
+			m_view = nullptr;
+		}
+		if (m_fd >= 0) {
+			::close(m_fd);
+			m_fd = -1;
+		}
+	}
+#endif
+}
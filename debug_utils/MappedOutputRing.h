@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dbgutils {
+
+	// A record recovered from a MappedOutputRing.
+	struct MappedOutputRecord {
+		// Number of the record, in append order. The numbering goes on across processes.
+		uint64_t		number{ 0 };
+
+		// Generation of the file when the record was appended (see MappedOutputRing).
+		uint32_t		generation{ 0 };
+
+		std::wstring	text;
+	};
+
+	//							MAPPED OUTPUT RING
+	//
+	// The MappedOutputRing keeps the latest console outputs in a memory-mapped file,
+	// so that they survive a crash of the process: the records are written in place in
+	// the mapping, and the operating system writes the pages back to the file even if
+	// the process dies. A post-mortem tool, or the next start of the process, recovers
+	// them by opening the file again. There is no explicit flush.
+	//
+	// FILE LAYOUT
+	//	header	magic, version and geometry, the generation, a checksum of these fields,
+	//			then the write index (number of records appended) and the head of the data.
+	//	slots	one slot per record: its number, position, length, generation and a checksum.
+	//	data	a ring of wide characters holding the text of the records, each one contiguous.
+	//
+	// The generation is incremented each time the file is opened, so the records of
+	// different runs can be told apart.
+	//
+	// Appending a record costs a memcpy of its text plus the slot, then a release store of
+	// the write index which publishes it. A record whose slot or text was overwritten, or
+	// whose append was interrupted by the crash, fails the checks and is not recovered.
+	//
+	// REMARKS
+	//	The data survives the crash of the process, not the crash of the operating system.
+	//	There is a single writer: the file must not be opened by two processes at once.
+	class MappedOutputRing {
+	public:
+		// Opens or creates the file. If the file holds a ring of the same geometry,
+		// its records are kept; otherwise the file is reset.
+		//
+		// INPUT
+		//	dataBytes	size of the ring holding the text of the records.
+		//	numSlots	maximum number of records.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened or mapped.
+		MappedOutputRing(const std::filesystem::path &path, size_t dataBytes, size_t numSlots);
+		~MappedOutputRing();
+
+		MappedOutputRing(const MappedOutputRing &) = delete;
+		MappedOutputRing &operator=(const MappedOutputRing &) = delete;
+
+		//		ACCESSORS
+		//
+
+		size_t data_bytes() const { return m_dataCapacity * sizeof(wchar_t); }
+		size_t num_slots() const { return m_numSlots; }
+
+		// generation returns the generation of the file for this process.
+		uint32_t generation() const;
+
+		// write_index returns the number of records appended to the file, by all generations.
+		uint64_t write_index() const;
+
+		// records returns the records that can be recovered, from the oldest to the latest.
+		std::vector<MappedOutputRecord> records() const;
+
+		//		MANIPULATORS
+		//
+
+		// append writes a record. A text longer than the data ring is truncated.
+		void append(std::wstring_view text);
+
+	private:
+		struct Header;
+		struct Slot;
+
+		void map_file(const std::filesystem::path &path, size_t fileSize);
+		void unmap_file();
+
+		// reset initializes an empty ring in the file.
+		void reset();
+
+		Header &header() const;
+		Slot &slot(uint64_t number) const;
+		wchar_t *data_at(uint64_t pos) const;
+
+		// is_valid returns true iff a slot holds an intact record that was not overwritten.
+		bool is_valid(const Slot &s, uint64_t number, uint64_t head) const;
+
+	private:
+		size_t		m_dataCapacity;	// in characters
+		size_t		m_numSlots;
+
+		// The mapping.
+		char		*m_view{ nullptr };
+		size_t		m_viewSize{ 0 };
+
+#ifdef _WIN32
+		void		*m_file{ nullptr };
+		void		*m_mapping{ nullptr };
+#else
+		int			m_fd{ -1 };
+#endif
+	};
+}
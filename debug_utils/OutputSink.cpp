@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "OutputSink.h"
+
+namespace dbgutils {
+
+	std::wstring ChunkedText::str() const
+	{
+		std::wstring s;
+		s.reserve(m_length);
+
+		for (const auto &c : m_chunks) {
+			s += c;
+		}
+
+		return s;
+	}
+
+	void ChunkedText::write(std::wstring_view chunk)
+	{
+		if (chunk.empty()) {
+			return;
+		}
+
+		m_length += chunk.length();
+
+		// Append to the last chunk if it has room left.
+		if (!m_chunks.empty()) {
+			auto &last = m_chunks.back();
+			if (last.length() + chunk.length() <= kChunkCapacity) {
+				last.append(chunk);
+				return;
+			}
+		}
+
+		// Big chunks are stored as they are.
+		if (chunk.length() >= kChunkCapacity) {
+			m_chunks.emplace_back(chunk);
+			return;
+		}
+
+		// Small chunks start a new chunk with enough room for the next ones.
+		m_chunks.emplace_back();
+		m_chunks.back().reserve(kChunkCapacity);
+		m_chunks.back().append(chunk);
+	}
+
+	void ChunkedText::clear()
+	{
+		m_chunks.clear();
+		m_length = 0;
+	}
+
+	bool operator==(const ChunkedText &lhs, std::wstring_view rhs)
+	{
+		if (lhs.length() != rhs.length()) {
+			return false;
+		}
+
+		size_t offset = 0;
+		for (const auto &c : lhs) {
+			if (rhs.substr(offset, c.length()) != c) {
+				return false;
+			}
+			offset += c.length();
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dbgutils {
+
+	// IOutputSink receives the output of a command chunk by chunk.
+	// A command can write as many chunks as it wants; the sink decides how
+	// to store them. A chunk is a view so it only has to live during the call.
+	class IOutputSink {
+	public:
+		virtual ~IOutputSink() = default;
+
+		virtual void write(std::wstring_view chunk) = 0;
+	};
+
+	//							CHUNKED TEXT
+	//
+	// ChunkedText is an output sink that stores a text as a list of chunks,
+	// so that a large output never has to be stored in a single contiguous string.
+	//
+	// Small chunks are appended to the last chunk until it reaches kChunkCapacity
+	// characters, so writing many small pieces does not cost one allocation each.
+	// Every character written is copied exactly once.
+	class ChunkedText : public IOutputSink {
+	public:
+		static constexpr size_t kChunkCapacity = 4096;
+
+		//		ACCESSORS
+		//
+
+		// length returns the total number of characters in the text.
+		auto length() const { return m_length; }
+		bool empty() const { return m_length == 0; }
+
+		auto num_chunks() const { return m_chunks.size(); }
+		const std::wstring &chunk(size_t i) const { return m_chunks[i]; }
+
+		auto begin() const { return m_chunks.begin(); }
+		auto end() const { return m_chunks.end(); }
+
+		// str concatenates all the chunks into a single string.
+		std::wstring str() const;
+
+		//		MANIPULATORS
+		//
+		void write(std::wstring_view chunk) override;
+
+		void clear();
+
+	private:
+		std::vector<std::wstring>	m_chunks;
+		size_t						m_length{ 0 };
+	};
+
+	bool operator==(const ChunkedText &lhs, std::wstring_view rhs);
+	inline bool operator==(std::wstring_view lhs, const ChunkedText &rhs) { return rhs == lhs; }
+}
@@ -0,0 +1,181 @@
+#include "pch.h"
+#include "OutputStore.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace dbgutils {
+
+	OutputStore::OutputStore(size_t byteBudget, size_t maxOutputs)
+		: m_arenaCapacity(byteBudget / sizeof(wchar_t))
+		, m_arena(new wchar_t[byteBudget / sizeof(wchar_t)])
+		, m_blocks(2 * maxOutputs)
+		, m_index(maxOutputs)
+	{
+		assert(m_arenaCapacity >= 1);
+	}
+
+	std::wstring_view OutputStore::get(uint64_t seq) const
+	{
+		assert(contains(seq));
+
+		const auto &e = entry(seq);
+		if (e.pending || e.length == 0) {
+			return std::wstring_view();
+		}
+
+		return std::wstring_view(at(e.start), e.length);
+	}
+
+	bool OutputStore::is_pending(uint64_t seq) const
+	{
+		assert(contains(seq));
+
+		return entry(seq).pending;
+	}
+
+	size_t OutputStore::memory_usage() const
+	{
+		return m_arenaCapacity * sizeof(wchar_t)
+			+ m_blocks.capacity() * sizeof(Block)
+			+ m_index.capacity() * sizeof(Entry);
+	}
+
+	uint64_t OutputStore::push(bool pending)
+	{
+		assert(!m_writing && "An output is being written.");
+
+		auto evicted = m_index.full();
+		m_index.push_back(Entry{ m_head, 0, pending });
+		if (evicted) {
+			drop_dead_blocks();
+		}
+
+		return m_endSeq++;
+	}
+
+	void OutputStore::begin_write(uint64_t seq)
+	{
+		assert(!m_writing && "An output is already being written.");
+
+		m_writing = true;
+		m_truncated = false;
+		m_open = Block{ m_head, 0, seq };
+
+		if (contains(seq)) {
+			entry(seq) = Entry{ m_head, 0, false };
+		}
+	}
+
+	void OutputStore::write(std::wstring_view chunk)
+	{
+		assert(m_writing);
+
+		if (m_truncated || !contains(m_open.seq)) {
+			return;
+		}
+
+		// Truncate the text to the size of the arena.
+		auto n = std::min(chunk.length(), m_arenaCapacity - m_open.length);
+		if (n == 0) {
+			return;
+		}
+
+		auto offset = static_cast<size_t>(m_open.start % m_arenaCapacity);
+		auto crossesEnd = offset + m_open.length + n > m_arenaCapacity;
+
+		// If the text would cross the end of the arena, the block is moved
+		// to the beginning of the arena, so that the text stays contiguous.
+		auto start = crossesEnd ? m_open.start + (m_arenaCapacity - offset) : m_open.start;
+		auto end = start + m_open.length + n;
+
+		if (!make_room(end)) {
+			m_truncated = true;
+			return;
+		}
+		assert(contains(m_open.seq));
+
+		if (crossesEnd) {
+			std::memmove(at(start), at(m_open.start), m_open.length * sizeof(wchar_t));
+			m_open.start = start;
+		}
+
+		std::memcpy(at(m_open.start + m_open.length), chunk.data(), n * sizeof(wchar_t));
+		m_open.length += n;
+		m_head = end;
+
+		auto &e = entry(m_open.seq);
+		e.start = m_open.start;
+		e.length = m_open.length;
+	}
+
+	void OutputStore::end_write()
+	{
+		assert(m_writing);
+
+		m_writing = false;
+
+		if (m_open.length > 0 && contains(m_open.seq)) {
+			if (m_blocks.full()) {
+				compact_blocks();
+			}
+			m_blocks.push_back(m_open);
+		}
+	}
+
+	bool OutputStore::make_room(uint64_t end)
+	{
+		auto overlaps = [this, end](const Block &b) { return end - b.start > m_arenaCapacity; };
+
+		// A late output must not evict the text of a newer one.
+		for (size_t i = 0; i < m_blocks.size() && overlaps(m_blocks.peek(i)); i++) {
+			const auto &b = m_blocks.peek(i);
+			if (b.seq > m_open.seq && is_live(b)) {
+				return false;
+			}
+		}
+
+		while (!m_blocks.empty() && overlaps(m_blocks.peek(0))) {
+			auto b = m_blocks.pop_front();
+
+			// The block may be dead, if its output was evicted or rewritten.
+			if (is_live(b)) {
+				evict_up_to(b.seq);
+			}
+		}
+
+		return true;
+	}
+
+	void OutputStore::evict_up_to(uint64_t seq)
+	{
+		auto evicted = false;
+		while (!m_index.empty() && first_seq() <= seq) {
+			m_index.pop_front();
+			evicted = true;
+		}
+
+		if (evicted) {
+			drop_dead_blocks();
+		}
+	}
+
+	void OutputStore::drop_dead_blocks()
+	{
+		while (!m_blocks.empty() && !is_live(m_blocks.peek(0))) {
+			m_blocks.pop_front();
+		}
+	}
+
+	void OutputStore::compact_blocks()
+	{
+		// At most maxOutputs - 1 blocks are live, since the output being written
+		// is live and its block is not in the ring yet: over half of the ring is freed.
+		for (auto n = m_blocks.size(); n > 0; n--) {
+			auto b = m_blocks.pop_front();
+			if (is_live(b)) {
+				m_blocks.push_back(b);
+			}
+		}
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include "OutputSink.h"
+#include "OvwRingBuf.h"
+
+namespace dbgutils {
+
+	//							OUTPUT STORE
+	//
+	// The OutputStore keeps the console outputs in a single ring of wide characters
+	// (the arena) plus an index of the outputs. Nothing is allocated per output.
+	//
+	// Memory is bounded by a byte budget, which sets the size of the arena,
+	// and by a maximum number of outputs, which sets the size of the index.
+	// When one of them is exceeded, the oldest outputs are evicted.
+	//
+	// Every output is numbered by a sequence number, in insertion order.
+	// The text of an output is always contiguous in the arena so it is exposed as a view.
+	// An output longer than the arena is truncated.
+	//
+	// WRITING
+	//	The text of an output is written by the IOutputSink interface, between calls
+	//	to begin_write and end_write. Only one output can be written at a time.
+	//
+	//		auto seq = store.push();
+	//		store.begin_write(seq);
+	//		store.write(L"hello, ");
+	//		store.write(L"world");
+	//		store.end_write();
+	//
+	//	An output can also be pushed without text, as a pending output, and written later.
+	//	Its text is then written at the head of the arena, after the text of newer outputs.
+	//	When the text of an output is evicted, all the older outputs are evicted along with it,
+	//	so that the store always holds the latest outputs. A late text never evicts a newer
+	//	output: it is truncated when the arena is full of newer text.
+	class OutputStore : public IOutputSink {
+	public:
+		OutputStore(size_t byteBudget, size_t maxOutputs);
+
+		OutputStore(const OutputStore &) = delete;
+		OutputStore &operator=(const OutputStore &) = delete;
+
+		//		ACCESSORS
+		//
+
+		// size returns the number of outputs.
+		auto size() const { return m_index.size(); }
+		bool empty() const { return m_index.empty(); }
+
+		// capacity returns the maximum number of outputs.
+		auto capacity() const { return m_index.capacity(); }
+
+		// byte_budget returns the size of the arena in bytes.
+		size_t byte_budget() const { return m_arenaCapacity * sizeof(wchar_t); }
+
+		// first_seq returns the sequence number of the oldest output.
+		// end_seq returns the sequence number of the next output to be pushed.
+		uint64_t first_seq() const { return m_endSeq - m_index.size(); }
+		uint64_t end_seq() const { return m_endSeq; }
+
+		// contains returns true iff the output with a given sequence number was not evicted.
+		bool contains(uint64_t seq) const { return first_seq() <= seq && seq < m_endSeq; }
+
+		// get returns the text of an output, given its sequence number.
+		// A pending output has no text.
+		std::wstring_view get(uint64_t seq) const;
+
+		bool is_pending(uint64_t seq) const;
+
+		// memory_usage returns the number of bytes allocated by the store.
+		// It does not change after the construction.
+		size_t memory_usage() const;
+
+		//		MANIPULATORS
+		//
+
+		// push inserts a new output with no text and returns its sequence number.
+		uint64_t push(bool pending = false);
+
+		// begin_write opens an output for writing. Its previous text is discarded.
+		void begin_write(uint64_t seq);
+
+		// write appends text to the output being written.
+		// If the output was evicted in the meantime, the text is ignored.
+		void write(std::wstring_view chunk) override;
+
+		void end_write();
+
+	private:
+		struct Entry {
+			uint64_t	start{ 0 };	// logical position of the text in the arena
+			size_t		length{ 0 };
+			bool		pending{ false };
+		};
+
+		// A block is a piece of the arena holding the text of an output.
+		// The blocks are kept in arena order, which may differ from the order of the outputs.
+		struct Block {
+			uint64_t	start;
+			size_t		length;
+			uint64_t	seq;
+		};
+
+		// make_room evicts blocks until the arena can hold the text up to a logical position.
+		// RETURN VALUE
+		//	Returns false, without evicting anything, if the text of an output newer than
+		//	the output being written would be evicted.
+		bool make_room(uint64_t end);
+
+		// evict_up_to evicts all the outputs up to a sequence number (included).
+		void evict_up_to(uint64_t seq);
+
+		// is_live returns false if the output of a block was evicted or rewritten.
+		bool is_live(const Block &b) const { return contains(b.seq) && entry(b.seq).start == b.start; }
+
+		// drop_dead_blocks pops the dead blocks at the front of the arena.
+		void drop_dead_blocks();
+
+		// compact_blocks removes all the dead blocks.
+		void compact_blocks();
+
+		wchar_t *at(uint64_t pos) { return &m_arena[pos % m_arenaCapacity]; }
+		const wchar_t *at(uint64_t pos) const { return &m_arena[pos % m_arenaCapacity]; }
+
+		Entry &entry(uint64_t seq) { return m_index.peek(seq - first_seq()); }
+		const Entry &entry(uint64_t seq) const { return m_index.peek(seq - first_seq()); }
+
+	private:
+		// The arena. Positions in the arena are logical: they grow forever and are
+		// reduced modulo the capacity to get an index in the array.
+		size_t						m_arenaCapacity;
+		std::unique_ptr<wchar_t[]>	m_arena;
+
+		// Logical position where the next block starts.
+		uint64_t					m_head{ 0 };
+
+		// The blocks, in arena order. A live output has at most one block, so twice as many
+		// blocks as outputs leaves room for the dead blocks between two compactions.
+		OvwRingBuf<Block>			m_blocks;
+
+		// The outputs, from the oldest one to the latest one.
+		OvwRingBuf<Entry>			m_index;
+		uint64_t					m_endSeq{ 0 };
+
+		// The block being written. When a chunk could not be written,
+		// the text is truncated and the next chunks are ignored.
+		bool						m_writing{ false };
+		bool						m_truncated{ false };
+		Block						m_open{ 0, 0, 0 };
+	};
+}
@@ -1,19 +1,109 @@
 #pragma once
 
-#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
 #include <cassert>
 
 namespace dbgutils {
 
 	//							OVERWRITING RING BUFFER
 	//
-	template <class T>
+	// The items are stored in raw aligned storage and only constructed when inserted,
+	// so T does not need to be default constructible, and move-only types are supported.
+	//
+	// When PowerOfTwo is true, the capacity must be a power of two and the slots are
+	// found with a bit mask instead of a modulo. See the Pow2OvwRingBuf alias below.
+	//
+	// The items can be walked with random-access iterators, from the front to the back,
+	// or as (at most) two contiguous spans of memory with spans().
+	template <class T, bool PowerOfTwo = false>
 	class OvwRingBuf {
 	public:
+		template <bool Const>
+		class Iterator;
+
+		using value_type = T;
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		// A contiguous sequence of items.
+		template <class U>
+		struct Span {
+			U		*data{ nullptr };
+			size_t	size{ 0 };
+
+			U *begin() const { return data; }
+			U *end() const { return data + size; }
+		};
+
+		// The items in order, split in two contiguous spans.
+		// The second span is empty unless the items wrap around the end of the storage.
+		template <class U>
+		struct Spans {
+			Span<U>	first;
+			Span<U>	second;
+		};
+
 		OvwRingBuf(size_t capacity)
 			: m_capacity(capacity)
+			, m_storage(new Storage[capacity])
 		{
 			assert(capacity >= 1);
+			assert(!PowerOfTwo || (capacity & (capacity - 1)) == 0);
+		}
+
+		OvwRingBuf(const OvwRingBuf &other)
+			: m_capacity(other.m_capacity)
+			, m_storage(new Storage[other.m_capacity])
+		{
+			for (size_t i = 0; i < other.size(); i++) {
+				push_back(other.peek(i));
+			}
+		}
+
+		OvwRingBuf(OvwRingBuf &&other) noexcept
+			: m_capacity(other.m_capacity)
+			, m_size(other.m_size)
+			, m_front(other.m_front)
+			, m_back(other.m_back)
+			, m_storage(std::move(other.m_storage))
+		{
+			other.reset_moved_from();
+		}
+
+		OvwRingBuf &operator=(const OvwRingBuf &other)
+		{
+			if (this != &other) {
+				OvwRingBuf copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		OvwRingBuf &operator=(OvwRingBuf &&other) noexcept
+		{
+			if (this != &other) {
+				clear();
+
+				m_capacity = other.m_capacity;
+				m_size = other.m_size;
+				m_front = other.m_front;
+				m_back = other.m_back;
+				m_storage = std::move(other.m_storage);
+
+				other.reset_moved_from();
+			}
+			return *this;
+		}
+
+		~OvwRingBuf()
+		{
+			clear();
 		}
 
 		//				ACCESSORS
@@ -35,30 +125,83 @@ namespace dbgutils {
 			return m_size == m_capacity;
 		}
 
+		const_iterator begin() const { return const_iterator(this, 0); }
+		const_iterator end() const { return const_iterator(this, m_size); }
+		iterator begin() { return iterator(this, 0); }
+		iterator end() { return iterator(this, m_size); }
+
+		// spans returns the items as contiguous memory spans.
+		// The items of the first span come before the items of the second one.
+		Spans<const T> spans() const
+		{
+			return make_spans<const T>(reinterpret_cast<const T *>(m_storage.get()));
+		}
+
+		Spans<T> spans()
+		{
+			return make_spans<T>(reinterpret_cast<T *>(m_storage.get()));
+		}
+
 		//				MANIPULATORS
 		//
 
 		// push_back inserts an item at the back of the buffer.
 		// If the buffer was full before the call, the front item is overwritten.
+		//
+		// REMARKS
+		//	Overwriting is done by assignment so that the front item's resources
+		//	can be reused, e.g. a std::wstring keeps its buffer if it is large enough.
 		void push_back(const T &item)
 		{
-			auto wasFull = full();
-
-			// Insert
-			if (m_back < m_buf.size()) {
-				m_buf[m_back] = item;
+			if (full()) {
+				*slot(m_back) = item;
+				overwrote_front();
 			}
 			else {
-				m_buf.push_back(item);
+				new (slot(m_back)) T(item);
+				inserted();
 			}
-			increment_ptr(&m_back);
+		}
 
-			if (wasFull) {
-				m_front = m_back;
+		void push_back(T &&item)
+		{
+			if (full()) {
+				*slot(m_back) = std::move(item);
+				overwrote_front();
 			}
 			else {
-				m_size++;
+				new (slot(m_back)) T(std::move(item));
+				inserted();
+			}
+		}
+
+		// emplace_back constructs an item at the back of the buffer from the arguments.
+		// If the buffer was full before the call, the front item is destroyed and the new
+		// item is constructed in its slot.
+		//
+		// RETURN VALUE
+		//	Returns the new item.
+		//
+		// EXCEPTIONS
+		//	If the construction of the new item throws, the buffer is left without it: if the
+		//	buffer was full, it holds one item fewer, as the front item was already destroyed.
+		template <class... Args>
+		T &emplace_back(Args&&... args)
+		{
+			auto *p = slot(m_back);
+
+			if (full()) {
+				// The back slot is the slot of the front item. The front item is removed
+				// first, so that its slot is never counted as live while it holds no item.
+				p->~T();
+				increment_ptr(&m_front);
+				m_size--;
 			}
+
+			new (p) T(std::forward<Args>(args)...);
+			inserted();
+
+			return *p;
 		}
 
 		// pop_front removes and returns the item at the front of the buffer.
@@ -67,10 +210,26 @@ namespace dbgutils {
 		{
 			assert(!empty());
 
+			auto *p = slot(m_front);
+			T item(std::move(*p));
+			p->~T();
+
 			increment_ptr(&m_front);
 			m_size--;
 
-			return m_buf[ptr_previous(m_front)];
+			return item;
+		}
+
+		// clear removes all the items.
+		void clear()
+		{
+			while (!empty()) {
+				slot(m_front)->~T();
+				increment_ptr(&m_front);
+				m_size--;
+			}
+
+			m_front = m_back = 0;
 		}
 
 		// peek inspects the item at a given index.
@@ -82,11 +241,84 @@ namespace dbgutils {
 			assert(!empty());
 			assert(0 <= i && i < size());
 
-			auto k = (m_front + i) % m_capacity;
-			return m_buf[k];
+			return *slot(wrap(m_front + i));
+		}
+
+		T &peek(size_t i)
+		{
+			assert(!empty());
+			assert(0 <= i && i < size());
+
+			return *slot(wrap(m_front + i));
 		}
 
 	private:
+		// wrap reduces an index in [0, 2 * capacity) to a slot index.
+		size_t wrap(size_t i) const
+		{
+			if constexpr (PowerOfTwo) {
+				return i & (m_capacity - 1);
+			}
+			else {
+				return i < m_capacity ? i : i - m_capacity;
+			}
+		}
+
+		template <class U>
+		Spans<U> make_spans(U *base) const
+		{
+			Spans<U> result;
+
+			auto firstSize = std::min(m_size, m_capacity - m_front);
+			result.first = Span<U>{ base + m_front, firstSize };
+			result.second = Span<U>{ base, m_size - firstSize };
+
+			return result;
+		}
+
+		// Uninitialized memory for one item.
+		struct Storage {
+			alignas(T) unsigned char	bytes[sizeof(T)];
+		};
+		static_assert(sizeof(Storage) == sizeof(T), "The slots must be laid out like an array of T.");
+
+		T *slot(size_t i)
+		{
+			assert(m_storage && "The buffer was moved from.");
+
+			return std::launder(reinterpret_cast<T *>(m_storage[i].bytes));
+		}
+
+		const T *slot(size_t i) const
+		{
+			assert(m_storage && "The buffer was moved from.");
+
+			return std::launder(reinterpret_cast<const T *>(m_storage[i].bytes));
+		}
+
+		// reset_moved_from leaves a buffer whose storage was moved away empty, with a capacity
+		// of 0: it can only be destroyed or assigned to.
+		void reset_moved_from()
+		{
+			m_capacity = 0;
+			m_size = 0;
+			m_front = m_back = 0;
+		}
+
+		// Pointer updates after an item was constructed at the back, in an empty slot...
+		void inserted()
+		{
+			increment_ptr(&m_back);
+			m_size++;
+		}
+
+		// ...or in the slot of the front item.
+		void overwrote_front()
+		{
+			increment_ptr(&m_back);
+			m_front = m_back;
+		}
+
 		//		Update functions for the front and back pointers.
 		//
 		void increment_ptr(size_t *i) const
@@ -107,24 +339,14 @@ namespace dbgutils {
 		{
 			assert(i < m_capacity);
 
-			if (i != 0) {
-				return i - 1;
-			}
-			else {
-				return m_capacity - 1;
-			}
+			return wrap(i + m_capacity - 1);
 		}
 
 		size_t ptr_next(size_t i) const
 		{
 			assert(i < m_capacity);
 
-			if (i + 1 < m_capacity) {
-				return i + 1;
-			}
-			else {
-				return 0;
-			}
+			return wrap(i + 1);
 		}
 
 	private:
@@ -138,7 +360,70 @@ namespace dbgutils {
 		size_t		m_front{ 0 };
 		size_t		m_back{ 0 };
 
-		// Underlying vector containing the items.
-		std::vector<T>	m_buf;
+		// Underlying storage of the items.
+		// Only the slots between the front and back pointers hold constructed items.
+		std::unique_ptr<Storage[]>	m_storage;
+
+	public:
+		//						RANDOM-ACCESS ITERATOR
+		//
+		// An iterator refers to an item by its index from the front,
+		// hence it is invalidated when the front item is removed or overwritten.
+		template <bool Const>
+		class Iterator {
+		public:
+			using Buf = std::conditional_t<Const, const OvwRingBuf, OvwRingBuf>;
+
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<Const, const T *, T *>;
+			using reference = std::conditional_t<Const, const T &, T &>;
+
+			Iterator(Buf *buf = nullptr, size_t i = 0)
+				: m_buf(buf)
+				, m_i(i)
+			{}
+
+			// An iterator converts to a const iterator.
+			template <bool C = Const, class = std::enable_if_t<!C>>
+			operator Iterator<true>() const { return Iterator<true>(m_buf, m_i); }
+
+			reference operator*() const { return m_buf->peek(m_i); }
+			pointer operator->() const { return &m_buf->peek(m_i); }
+			reference operator[](difference_type d) const { return m_buf->peek(m_i + d); }
+
+			Iterator &operator++() { ++m_i; return *this; }
+			Iterator &operator--() { --m_i; return *this; }
+			Iterator operator++(int) { auto it = *this; ++m_i; return it; }
+			Iterator operator--(int) { auto it = *this; --m_i; return it; }
+
+			Iterator &operator+=(difference_type d) { m_i += d; return *this; }
+			Iterator &operator-=(difference_type d) { m_i -= d; return *this; }
+
+			friend Iterator operator+(Iterator it, difference_type d) { return it += d; }
+			friend Iterator operator+(difference_type d, Iterator it) { return it += d; }
+			friend Iterator operator-(Iterator it, difference_type d) { return it -= d; }
+
+			friend difference_type operator-(const Iterator &a, const Iterator &b)
+			{
+				return static_cast<difference_type>(a.m_i) - static_cast<difference_type>(b.m_i);
+			}
+
+			friend bool operator==(const Iterator &a, const Iterator &b) { return a.m_i == b.m_i; }
+			friend bool operator!=(const Iterator &a, const Iterator &b) { return a.m_i != b.m_i; }
+			friend bool operator<(const Iterator &a, const Iterator &b) { return a.m_i < b.m_i; }
+			friend bool operator>(const Iterator &a, const Iterator &b) { return a.m_i > b.m_i; }
+			friend bool operator<=(const Iterator &a, const Iterator &b) { return a.m_i <= b.m_i; }
+			friend bool operator>=(const Iterator &a, const Iterator &b) { return a.m_i >= b.m_i; }
+
+		private:
+			Buf		*m_buf;
+			size_t	m_i;
+		};
 	};
-}
\ No newline at end of file
+
+	// An overwriting ring buffer whose capacity is a power of two.
+	template <class T>
+	using Pow2OvwRingBuf = OvwRingBuf<T, true>;
+}
@@ -0,0 +1,290 @@
+#include "pch.h"
+#include "PrefixIndex.h"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include "ConsoleHistory.h"
+
+namespace dbgutils {
+
+	bool PrefixIndex::less(const Key &key, const ConsoleHistory &history, uint64_t id)
+	{
+		auto c = key.text.compare(history.entry_by_id(id));
+
+		return c < 0 || (c == 0 && key.id < id);
+	}
+
+	int PrefixIndex::compare_to_range(std::wstring_view text, std::wstring_view prefix)
+	{
+		if (text.substr(0, prefix.length()) == prefix) {
+			return 0;
+		}
+
+		// The texts starting with the prefix follow the prefix, and are followed by the
+		// greater texts which do not start with it.
+		return text < prefix ? -1 : 1;
+	}
+
+	uint32_t PrefixIndex::new_node(uint64_t id)
+	{
+		m_random ^= m_random << 13;
+		m_random ^= m_random >> 17;
+		m_random ^= m_random << 5;
+
+		Node node{ id, id, id, m_random, kNil, kNil };
+
+		if (!m_free.empty()) {
+			auto t = m_free.back();
+			m_free.pop_back();
+			m_nodes[t] = node;
+			return t;
+		}
+
+		m_nodes.push_back(node);
+		return static_cast<uint32_t>(m_nodes.size() - 1);
+	}
+
+	void PrefixIndex::update(uint32_t t)
+	{
+		auto &n = m_nodes[t];
+		n.minId = n.id;
+		n.maxId = n.id;
+
+		for (auto child : { n.left, n.right }) {
+			if (child != kNil) {
+				n.minId = std::min(n.minId, m_nodes[child].minId);
+				n.maxId = std::max(n.maxId, m_nodes[child].maxId);
+			}
+		}
+	}
+
+	void PrefixIndex::split(const ConsoleHistory &history, uint32_t t, const Key &key, OUT uint32_t *left, OUT uint32_t *right)
+	{
+		if (t == kNil) {
+			*left = kNil;
+			*right = kNil;
+			return;
+		}
+
+		if (less(key, history, m_nodes[t].id)) {
+			split(history, m_nodes[t].left, key, left, &m_nodes[t].left);
+			*right = t;
+		}
+		else {
+			split(history, m_nodes[t].right, key, &m_nodes[t].right, right);
+			*left = t;
+		}
+		update(t);
+	}
+
+	uint32_t PrefixIndex::merge(uint32_t left, uint32_t right)
+	{
+		if (left == kNil) {
+			return right;
+		}
+		if (right == kNil) {
+			return left;
+		}
+
+		if (m_nodes[left].priority > m_nodes[right].priority) {
+			m_nodes[left].right = merge(m_nodes[left].right, right);
+			update(left);
+			return left;
+		}
+		else {
+			m_nodes[right].left = merge(left, m_nodes[right].left);
+			update(right);
+			return right;
+		}
+	}
+
+	uint32_t PrefixIndex::insert(const ConsoleHistory &history, uint32_t t, uint32_t n, const Key &key)
+	{
+		if (t == kNil) {
+			return n;
+		}
+
+		if (m_nodes[n].priority > m_nodes[t].priority) {
+			uint32_t left, right;
+			split(history, t, key, &left, &right);
+			m_nodes[n].left = left;
+			m_nodes[n].right = right;
+			update(n);
+			return n;
+		}
+
+		if (less(key, history, m_nodes[t].id)) {
+			auto left = insert(history, m_nodes[t].left, n, key);
+			m_nodes[t].left = left;
+		}
+		else {
+			auto right = insert(history, m_nodes[t].right, n, key);
+			m_nodes[t].right = right;
+		}
+		update(t);
+		return t;
+	}
+
+	uint32_t PrefixIndex::erase(const ConsoleHistory &history, uint32_t t, const Key &key)
+	{
+		assert(t != kNil && "The entry is not in the index.");
+
+		auto id = key.id;
+		if (m_nodes[t].id == id) {
+			m_free.push_back(t);
+			return merge(m_nodes[t].left, m_nodes[t].right);
+		}
+
+		// The oldest and the latest entries of a subtree are found without reading the texts,
+		// and the evicted entry is the oldest of the history.
+		const auto &n = m_nodes[t];
+		auto goLeft = n.left != kNil && (m_nodes[n.left].minId == id || m_nodes[n.left].maxId == id);
+		auto goRight = n.right != kNil && (m_nodes[n.right].minId == id || m_nodes[n.right].maxId == id);
+		if (!goLeft && !goRight) {
+			goLeft = less(key, history, n.id);
+		}
+
+		if (goLeft) {
+			auto left = erase(history, m_nodes[t].left, key);
+			m_nodes[t].left = left;
+		}
+		else {
+			auto right = erase(history, m_nodes[t].right, key);
+			m_nodes[t].right = right;
+		}
+		update(t);
+		return t;
+	}
+
+	void PrefixIndex::insert(const ConsoleHistory &history, uint64_t id)
+	{
+		auto n = new_node(id);
+		m_root = insert(history, m_root, n, Key{ history.entry_by_id(id), id });
+		m_version++;
+		m_size++;
+	}
+
+	void PrefixIndex::erase(const ConsoleHistory &history, uint64_t id)
+	{
+		m_root = erase(history, m_root, Key{ history.entry_by_id(id), id });
+		m_version++;
+		m_size--;
+	}
+
+	void PrefixIndex::clear()
+	{
+		m_nodes.clear();
+		m_free.clear();
+		m_root = kNil;
+		m_size = 0;
+		m_version++;
+	}
+
+	PrefixIndex::Navigation &PrefixIndex::navigate(const ConsoleHistory &history, std::wstring_view prefix) const
+	{
+		if (m_nav.version == m_version && m_nav.prefix == prefix) {
+			return m_nav;
+		}
+
+		m_nav.prefix = prefix;
+		m_nav.version = m_version;
+		m_nav.found.clear();
+		m_nav.heap.clear();
+		push_range(history, m_root, false, false);
+
+		return m_nav;
+	}
+
+	void PrefixIndex::push_range(const ConsoleHistory &history, uint32_t t, bool loIn, bool hiIn) const
+	{
+		if (t == kNil) {
+			return;
+		}
+
+		const auto &n = m_nodes[t];
+		if (loIn && hiIn) {
+			m_nav.heap.push_back(Item{ n.maxId, t, true });
+			std::push_heap(m_nav.heap.begin(), m_nav.heap.end());
+			return;
+		}
+
+		auto c = compare_to_range(history.entry_by_id(n.id), m_nav.prefix);
+		if (c < 0) {
+			push_range(history, n.right, loIn, hiIn);
+			return;
+		}
+		if (c > 0) {
+			push_range(history, n.left, loIn, hiIn);
+			return;
+		}
+
+		m_nav.heap.push_back(Item{ n.id, t, false });
+		std::push_heap(m_nav.heap.begin(), m_nav.heap.end());
+		push_range(history, n.left, loIn, true);
+		push_range(history, n.right, true, hiIn);
+	}
+
+	bool PrefixIndex::take_next() const
+	{
+		auto &heap = m_nav.heap;
+		while (!heap.empty()) {
+			std::pop_heap(heap.begin(), heap.end());
+			auto item = heap.back();
+			heap.pop_back();
+
+			if (!item.subtree) {
+				m_nav.found.push_back(item.maxId);
+				return true;
+			}
+
+			// The latest entry of the subtree is its root or in one of its subtrees.
+			const auto &n = m_nodes[item.node];
+			heap.push_back(Item{ n.id, item.node, false });
+			std::push_heap(heap.begin(), heap.end());
+			for (auto child : { n.left, n.right }) {
+				if (child != kNil) {
+					heap.push_back(Item{ m_nodes[child].maxId, child, true });
+					std::push_heap(heap.begin(), heap.end());
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool PrefixIndex::find_previous(const ConsoleHistory &history, std::wstring_view prefix, uint64_t before, OUT uint64_t *id) const
+	{
+		assert(id != nullptr);
+
+		auto &nav = navigate(history, prefix);
+		while ((nav.found.empty() || nav.found.back() >= before) && take_next()) {
+		}
+
+		// The first entry found before the given one.
+		auto it = std::upper_bound(nav.found.begin(), nav.found.end(), before, std::greater<uint64_t>());
+		if (it == nav.found.end()) {
+			return false;
+		}
+
+		*id = *it;
+		return true;
+	}
+
+	bool PrefixIndex::find_next(const ConsoleHistory &history, std::wstring_view prefix, uint64_t after, OUT uint64_t *id) const
+	{
+		assert(id != nullptr);
+
+		auto &nav = navigate(history, prefix);
+		while ((nav.found.empty() || nav.found.back() > after) && take_next()) {
+		}
+
+		// The last entry found after the given one.
+		auto it = std::lower_bound(nav.found.begin(), nav.found.end(), after, std::greater<uint64_t>());
+		if (it == nav.found.begin()) {
+			return false;
+		}
+
+		*id = *(it - 1);
+		return true;
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define IN
+#define OUT
+#define OPTIONAL
+
+namespace dbgutils {
+
+	class ConsoleHistory;
+
+	//							PREFIX INDEX
+	//
+	// The PrefixIndex finds the entries of a history which start with a prefix, in push order,
+	// for the prefix navigation of the console (see HISTORY_NAVIGATION). The entries are
+	// identified by their id (see ConsoleHistory::id_of), which increases in push order and
+	// does not change when an older entry is removed, and their text is read from the history.
+	//
+	// The index is a sorted view of the entries: a balanced binary tree (a treap) ordered by
+	// their text, then by their id, so the entries starting with a prefix form a range of
+	// the tree, in which the same texts are ordered from the oldest to the latest.
+	//
+	//		"git commit"	5
+	//		"git status"	2
+	//		"git status"	7
+	//		"make"			4
+	//
+	// Every node also keeps the lowest and the highest id of its subtree. A navigation
+	// splits the range of its prefix into O(log n) subtrees and nodes, which go into a heap
+	// ordered by their highest id. The entries of the range are then taken out from the
+	// latest to the oldest: a subtree taken out of the heap is replaced by its root and its
+	// two subtrees, so every step costs O(log n) operations on the heap, whatever the number
+	// of entries which do not start with the prefix. The entries found so far are kept, so
+	// going back towards the latest entries costs a binary search.
+	//
+	// The navigation is kept from one search to the next while the prefix is the same and
+	// the index does not change; a search from an older entry than the ones found so far
+	// takes out all the entries of the range in between.
+	//
+	// The nodes are in a pool and linked by their index, and the pool reuses the removed nodes.
+	class PrefixIndex {
+	public:
+		//		ACCESSORS
+		//
+
+		size_t size() const { return m_size; }
+
+		// memory_usage returns the number of bytes allocated by the index and its navigation.
+		size_t memory_usage() const
+		{
+			return m_nodes.capacity() * sizeof(Node)
+				+ m_nav.found.capacity() * sizeof(uint64_t) + m_nav.heap.capacity() * sizeof(Item);
+		}
+
+		// find_previous returns the latest entry before a given one which starts with a prefix.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		//
+		// REMARKS
+		//	The navigation of the prefix is updated (see above), so the index must not be
+		//	searched from several threads, although the function is const.
+		bool find_previous(const ConsoleHistory &history, std::wstring_view prefix, uint64_t before, OUT uint64_t *id) const;
+
+		// find_next returns the oldest entry after a given one which starts with a prefix.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		bool find_next(const ConsoleHistory &history, std::wstring_view prefix, uint64_t after, OUT uint64_t *id) const;
+
+		//		MANIPULATORS
+		//
+
+		// insert adds an entry, which must be in the history already.
+		void insert(const ConsoleHistory &history, uint64_t id);
+
+		// erase removes an entry, which must still be in the history.
+		void erase(const ConsoleHistory &history, uint64_t id);
+
+		void clear();
+
+	private:
+		static constexpr uint32_t kNil = UINT32_MAX;
+
+		struct Node {
+			uint64_t	id;
+			uint64_t	minId;		// of the subtree
+			uint64_t	maxId;		// of the subtree
+			uint32_t	priority;	// the parent of a node has a higher priority
+			uint32_t	left;
+			uint32_t	right;
+		};
+
+		// An entry being added or removed, and its text.
+		struct Key {
+			std::wstring_view	text;
+			uint64_t			id;
+		};
+
+		// An item of the heap of a navigation: a whole subtree, or only its root.
+		struct Item {
+			uint64_t	maxId;
+			uint32_t	node;
+			bool		subtree;
+
+			bool operator<(const Item &other) const { return maxId < other.maxId; }
+		};
+
+		// The navigation of a prefix: the entries found so far, from the latest to the oldest,
+		// and the heap of the subtrees and the nodes of the range which were not taken out.
+		// It is valid as long as the index is at the same version.
+		struct Navigation {
+			std::wstring			prefix;
+			uint64_t				version{ UINT64_MAX };
+			std::vector<uint64_t>	found;
+			std::vector<Item>		heap;
+		};
+
+		// less compares an entry being added or removed to an entry of the tree, by text,
+		// then by id.
+		static bool less(const Key &key, const ConsoleHistory &history, uint64_t id);
+
+		// compare_to_range returns -1 if a text is before the range of a prefix, 1 if it is
+		// after it, and 0 if it starts with the prefix.
+		static int compare_to_range(std::wstring_view text, std::wstring_view prefix);
+
+		uint32_t new_node(uint64_t id);
+		void update(uint32_t t);
+
+		// split divides a tree into the entries before an entry and the ones after it.
+		void split(const ConsoleHistory &history, uint32_t t, const Key &key, OUT uint32_t *left, OUT uint32_t *right);
+
+		// merge joins two trees; the entries of the left one are before the ones of the right one.
+		uint32_t merge(uint32_t left, uint32_t right);
+
+		uint32_t insert(const ConsoleHistory &history, uint32_t t, uint32_t n, const Key &key);
+		uint32_t erase(const ConsoleHistory &history, uint32_t t, const Key &key);
+
+		// navigate returns the navigation of a prefix, started over if needed.
+		Navigation &navigate(const ConsoleHistory &history, std::wstring_view prefix) const;
+
+		// push_range pushes the subtrees and the nodes of the range of a prefix into the heap.
+		// A subtree is known to be in the range if both its lower and its upper bounds are
+		// (loIn and hiIn).
+		void push_range(const ConsoleHistory &history, uint32_t t, bool loIn, bool hiIn) const;
+
+		// take_next takes the next entry of the range out of the heap, into the found ones.
+		//
+		// RETURN VALUE
+		//	Returns false iff all the entries of the range were found.
+		bool take_next() const;
+
+	private:
+		std::vector<Node>		m_nodes;
+		std::vector<uint32_t>	m_free;
+		uint32_t				m_root{ kNil };
+		size_t					m_size{ 0 };
+
+		// The version changes with every change of the index, which ends the navigation.
+		uint64_t				m_version{ 0 };
+		mutable Navigation		m_nav;
+
+		// State of the generator of the priorities (xorshift).
+		uint32_t				m_random{ 0x9e3779b9u };
+	};
+}
@@ -0,0 +1,457 @@
+#include "pch.h"
+#include "SharedHistory.h"
+#include "Checksum.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dbgutils {
+
+	static constexpr uint32_t kMagic = 0x53474244;	// "DBGS"
+	static constexpr uint16_t kVersion = 1;
+
+	struct SharedHistory::Header {
+		uint32_t				magic;
+		uint16_t				version;
+		uint16_t				charSize;
+
+		// Incremented by every append, by all the processes.
+		std::atomic<uint64_t>	generation;
+
+		char					reserved[48];
+	};
+
+	static constexpr uint64_t kHeaderBytes = 64;
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "The atomics of the header live in a shared file.");
+	static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "The atomics of the header live in a shared file.");
+
+	// Size of a record without its text: the length, the checksum, the writer and the trailing length.
+	static constexpr uint64_t kRecordOverhead = 4 * sizeof(uint32_t);
+
+	// Bytes read at the end of the file when it is loaded, doubled until they hold the records.
+	static constexpr uint64_t kLoadBlockBytes = 64 * 1024;
+
+	static uint32_t record_checksum(uint32_t length, uint32_t writer, const void *text)
+	{
+		return Checksum().add(length).add(writer).add(text, length * sizeof(wchar_t)).value();
+	}
+
+	static uint32_t read_u32(const char *p)
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	// record_at returns the size of the record starting at the beginning of the bytes, or 0
+	// if it is not intact.
+	static uint64_t record_at(const char *data, uint64_t size)
+	{
+		if (size < kRecordOverhead) {
+			return 0;
+		}
+
+		auto length = read_u32(data);
+		auto bytes = kRecordOverhead + uint64_t(length) * sizeof(wchar_t);
+		if (bytes > size
+			|| read_u32(data + bytes - sizeof(uint32_t)) != length
+			|| read_u32(data + sizeof(uint32_t)) != record_checksum(length, read_u32(data + 2 * sizeof(uint32_t)), data + 3 * sizeof(uint32_t))) {
+			return 0;
+		}
+
+		return bytes;
+	}
+
+	// record_before returns the size of the record ending at the end of the bytes, or 0 if it
+	// is not intact or does not fit in them.
+	static uint64_t record_before(const char *end, uint64_t size)
+	{
+		if (size < kRecordOverhead) {
+			return 0;
+		}
+
+		auto bytes = kRecordOverhead + uint64_t(read_u32(end - sizeof(uint32_t))) * sizeof(wchar_t);
+		if (bytes > size || record_at(end - bytes, bytes) != bytes) {
+			return 0;
+		}
+
+		return bytes;
+	}
+
+	static uint32_t writer_of(const char *record)
+	{
+		return read_u32(record + 2 * sizeof(uint32_t));
+	}
+
+	static std::wstring text_of(const char *record)
+	{
+		std::wstring text(read_u32(record), L'\0');
+		std::memcpy(&text[0], record + 3 * sizeof(uint32_t), text.length() * sizeof(wchar_t));
+		return text;
+	}
+
+	static bool is_valid_header(const char *p)
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t charSize;
+		std::memcpy(&magic, p, sizeof(magic));
+		std::memcpy(&version, p + 4, sizeof(version));
+		std::memcpy(&charSize, p + 6, sizeof(charSize));
+
+		return magic == kMagic && version == kVersion && charSize == sizeof(wchar_t);
+	}
+
+	SharedHistory::SharedHistory(const std::filesystem::path &path, size_t capacity, OUT std::vector<std::wstring> *records)
+		: m_path(path)
+		, m_capacity(capacity)
+		, m_writer(std::random_device()())
+	{
+		static_assert(sizeof(Header) == kHeaderBytes, "The header is mapped.");
+		assert(capacity >= 1);
+		assert(records != nullptr);
+
+		publish(false);
+		open_file();
+
+		if (file_size() < kHeaderBytes || !read_at(0, kHeaderBytes) || !is_valid_header(m_buf.data())) {
+			close_file();
+			publish(true);
+			open_file();
+			if (file_size() < kHeaderBytes) {
+				close_file();
+				throw std::runtime_error("SharedHistory failed to reset its file.");
+			}
+		}
+		map_header();
+
+		// The records appended from now on increment the generation again.
+		m_seenGeneration = generation();
+		m_readPos = load(records);
+	}
+
+	SharedHistory::~SharedHistory()
+	{
+		close_file();
+	}
+
+	void SharedHistory::publish(bool replace) const
+	{
+		auto temp = m_path;
+		temp += ".new" + std::to_string(m_writer);
+
+		{
+			char bytes[kHeaderBytes] = {};
+			auto charSize = static_cast<uint16_t>(sizeof(wchar_t));
+			std::memcpy(bytes, &kMagic, sizeof(kMagic));
+			std::memcpy(bytes + 4, &kVersion, sizeof(kVersion));
+			std::memcpy(bytes + 6, &charSize, sizeof(charSize));
+
+			std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+			out.write(bytes, sizeof(bytes));
+		}
+
+		// The link fails if the file exists, so the processes starting together create it once.
+		std::error_code ec;
+		if (replace) {
+			std::filesystem::rename(temp, m_path, ec);
+		}
+		else {
+			std::filesystem::create_hard_link(temp, m_path, ec);
+
+			// A file system without hard links.
+			if (ec && !std::filesystem::exists(m_path, ec)) {
+				std::filesystem::rename(temp, m_path, ec);
+			}
+		}
+		std::filesystem::remove(temp, ec);
+	}
+
+	SharedHistory::Header &SharedHistory::header() const
+	{
+		return *reinterpret_cast<Header *>(m_view);
+	}
+
+	uint64_t SharedHistory::generation() const
+	{
+		return header().generation.load(std::memory_order_acquire);
+	}
+
+	bool SharedHistory::read_at(uint64_t pos, size_t bytes)
+	{
+		m_buf.resize(bytes);
+		m_bytesRead += bytes;
+
+		for (size_t done = 0; done < bytes; ) {
+#ifdef _WIN32
+			OVERLAPPED overlapped{};
+			overlapped.Offset = static_cast<DWORD>(pos + done);
+			overlapped.OffsetHigh = static_cast<DWORD>((pos + done) >> 32);
+			DWORD n = 0;
+			auto chunk = static_cast<DWORD>(std::min<size_t>(bytes - done, 1u << 30));
+			if (!ReadFile(m_file, m_buf.data() + done, chunk, &n, &overlapped) || n == 0) {
+				return false;
+			}
+#else
+			auto n = ::pread(m_fd, m_buf.data() + done, bytes - done, static_cast<off_t>(pos + done));
+			if (n <= 0) {
+				return false;
+			}
+#endif
+			done += static_cast<size_t>(n);
+		}
+
+		return true;
+	}
+
+	uint64_t SharedHistory::load(OUT std::vector<std::wstring> *records)
+	{
+		auto end = file_size();
+		auto available = end - kHeaderBytes;
+		auto blockBytes = std::min(kLoadBlockBytes, available);
+
+		// The block is doubled until it holds the records, so the bytes read are at most twice
+		// the size of the latest capacity records, plus a block.
+		for (;;) {
+			records->clear();
+			auto lastEnd = kHeaderBytes;
+			auto blockStart = end - blockBytes;
+
+			if (!read_at(blockStart, static_cast<size_t>(blockBytes))) {
+				return end;
+			}
+			auto data = m_buf.data();
+
+			// Backwards from the end. The bytes which do not end an intact record are skipped
+			// one by one: they are a record being written or torn.
+			auto pos = blockBytes;
+			while (records->size() < m_capacity && pos > 0) {
+				auto bytes = record_before(data + pos, pos);
+				if (bytes == 0) {
+					pos--;
+					continue;
+				}
+
+				if (records->empty()) {
+					lastEnd = blockStart + pos;
+				}
+				pos -= bytes;
+				records->push_back(text_of(data + pos));
+			}
+
+			// The records may go on before the block.
+			if (records->size() == m_capacity || blockStart == kHeaderBytes) {
+				std::reverse(records->begin(), records->end());
+				return lastEnd;
+			}
+
+			blockBytes = std::min(2 * blockBytes, available);
+		}
+	}
+
+	void SharedHistory::append(std::wstring_view line)
+	{
+		auto length = static_cast<uint32_t>(line.length());
+		auto checksum = record_checksum(length, m_writer, line.data());
+		auto textBytes = line.length() * sizeof(wchar_t);
+
+		m_record.resize(kRecordOverhead + textBytes);
+		auto p = m_record.data();
+		std::memcpy(p, &length, sizeof(length));
+		std::memcpy(p + sizeof(uint32_t), &checksum, sizeof(checksum));
+		std::memcpy(p + 2 * sizeof(uint32_t), &m_writer, sizeof(m_writer));
+		std::memcpy(p + 3 * sizeof(uint32_t), line.data(), textBytes);
+		std::memcpy(p + 3 * sizeof(uint32_t) + textBytes, &length, sizeof(length));
+
+		if (write_record()) {
+			header().generation.fetch_add(1, std::memory_order_release);
+		}
+	}
+
+	size_t SharedHistory::poll(OUT std::vector<std::wstring> *lines)
+	{
+		assert(lines != nullptr);
+		lines->clear();
+
+		// Without a new append, there is nothing to read, unless a stalled record may be
+		// skipped by now.
+		auto gen = generation();
+		if (gen == m_seenGeneration
+			&& !(m_stallFollowed && std::chrono::steady_clock::now() - m_stallTime >= kTornRecordDelay)) {
+			return 0;
+		}
+		m_seenGeneration = gen;
+		auto now = std::chrono::steady_clock::now();
+
+		auto end = file_size();
+		if (end <= m_readPos || !read_at(m_readPos, static_cast<size_t>(end - m_readPos))) {
+			return 0;
+		}
+
+		auto data = m_buf.data();
+		auto size = end - m_readPos;
+		uint64_t pos = 0;
+		while (pos < size) {
+			auto bytes = record_at(data + pos, size - pos);
+			if (bytes > 0) {
+				if (writer_of(data + pos) != m_writer) {
+					lines->push_back(text_of(data + pos));
+				}
+				pos += bytes;
+				continue;
+			}
+
+			// The record is being written, or was torn by the crash of its writer.
+			if (m_readPos + pos != m_stallPos) {
+				m_stallPos = m_readPos + pos;
+				m_stallTime = now;
+			}
+
+			// It is torn if a record was appended after it, and it stayed incomplete for
+			// kTornRecordDelay: it is then skipped up to that record. An append may complete
+			// after a later one, so the later record alone does not tell.
+			auto next = pos + 1;
+			while (next < size && record_at(data + next, size - next) == 0) {
+				next++;
+			}
+			m_stallFollowed = next < size;
+			if (!m_stallFollowed || now - m_stallTime < kTornRecordDelay) {
+				break;
+			}
+			pos = next;
+			m_stallPos = UINT64_MAX;
+			m_stallFollowed = false;
+		}
+
+		m_readPos += pos;
+		return lines->size();
+	}
+
+#ifdef _WIN32
+	void SharedHistory::open_file()
+	{
+		const auto share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+
+		m_file = CreateFileW(m_path.c_str(), GENERIC_READ | GENERIC_WRITE, share,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE) {
+			m_file = nullptr;
+			throw std::runtime_error("SharedHistory failed to open its file.");
+		}
+
+		// Without FILE_WRITE_DATA, every write goes to the end of the file.
+		m_appendFile = CreateFileW(m_path.c_str(), FILE_APPEND_DATA | SYNCHRONIZE, share,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_appendFile == INVALID_HANDLE_VALUE) {
+			m_appendFile = nullptr;
+			close_file();
+			throw std::runtime_error("SharedHistory failed to open its file.");
+		}
+	}
+
+	void SharedHistory::map_header()
+	{
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(kHeaderBytes), nullptr);
+		if (m_mapping == nullptr) {
+			close_file();
+			throw std::runtime_error("SharedHistory failed to map its file.");
+		}
+
+		m_view = static_cast<char *>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(kHeaderBytes)));
+		if (m_view == nullptr) {
+			close_file();
+			throw std::runtime_error("SharedHistory failed to map its file.");
+		}
+	}
+
+	void SharedHistory::close_file()
+	{
+		if (m_view) {
+			UnmapViewOfFile(m_view);
+			m_view = nullptr;
+		}
+		if (m_mapping) {
+			CloseHandle(m_mapping);
+			m_mapping = nullptr;
+		}
+		if (m_appendFile) {
+			CloseHandle(m_appendFile);
+			m_appendFile = nullptr;
+		}
+		if (m_file) {
+			CloseHandle(m_file);
+			m_file = nullptr;
+		}
+	}
+
+	uint64_t SharedHistory::file_size() const
+	{
+		LARGE_INTEGER size;
+		return GetFileSizeEx(m_file, &size) ? static_cast<uint64_t>(size.QuadPart) : 0;
+	}
+
+	bool SharedHistory::write_record()
+	{
+		DWORD written = 0;
+		return WriteFile(m_appendFile, m_record.data(), static_cast<DWORD>(m_record.size()), &written, nullptr)
+			&& written == m_record.size();
+	}
+#else
+	void SharedHistory::open_file()
+	{
+		m_fd = ::open(m_path.c_str(), O_RDWR | O_APPEND);
+		if (m_fd < 0) {
+			throw std::runtime_error("SharedHistory failed to open its file.");
+		}
+	}
+
+	void SharedHistory::map_header()
+	{
+		auto view = ::mmap(nullptr, kHeaderBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+		if (view == MAP_FAILED) {
+			close_file();
+			throw std::runtime_error("SharedHistory failed to map its file.");
+		}
+		m_view = static_cast<char *>(view);
+	}
+
+	void SharedHistory::close_file()
+	{
+		if (m_view) {
+			::munmap(m_view, kHeaderBytes);
+			m_view = nullptr;
+		}
+		if (m_fd >= 0) {
+			::close(m_fd);
+			m_fd = -1;
+		}
+	}
+
+	uint64_t SharedHistory::file_size() const
+	{
+		struct stat st;
+		return ::fstat(m_fd, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+	}
+
+	bool SharedHistory::write_record()
+	{
+		// A single write: with O_APPEND, it is not interleaved with the writes of the other processes.
+		auto n = ::write(m_fd, m_record.data(), m_record.size());
+		return n == static_cast<ssize_t>(m_record.size());
+	}
+#endif
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define IN
+#define OUT
+#define OPTIONAL
+
+namespace dbgutils {
+
+	//							SHARED HISTORY
+	//
+	// The SharedHistory lets several processes share the command lines of their histories
+	// through one file, like a shell with a shared history: every process appends its lines
+	// to the file, and picks up the lines appended by the others.
+	//
+	// FILE LAYOUT
+	//	header	magic, version and size of a character, then the generation: the number of
+	//			records appended to the file, by all the processes. The header is mapped by
+	//			every process.
+	//	records	one per line, in append order:
+	//			[length][checksum][writer][text][length]
+	//			The length (in characters), the checksum (of the length, the writer and the
+	//			text) and the writer are 32-bit integers. The writer identifies the
+	//			SharedHistory which appended the record. The trailing copy of the length lets
+	//			the file be read backwards.
+	//
+	// APPENDING
+	//	A record is written with a single write to a file opened in append mode (O_APPEND, or
+	//	FILE_APPEND_DATA on Windows), so the records of concurrent writers are not interleaved.
+	//	The generation is incremented after the write.
+	//
+	// POLLING
+	//	poll compares the generation with the one it saw last: if it did not change, there is
+	//	nothing to read, which costs an atomic load (see TORN RECORDS for the exception). Otherwise it reads the file from the end
+	//	of the records it has read so far, so every process reads every byte of the file once.
+	//	The records of the SharedHistory itself are skipped.
+	//
+	// LOADING
+	//	The latest capacity records are read backwards from the end of the file, in blocks,
+	//	so opening costs O(capacity) whatever the size of the file.
+	//
+	// TORN RECORDS
+	//	A record which is not intact is either being written by another process, or was torn
+	//	by the crash of its writer. poll stops before it, and skips it only once an intact
+	//	record follows it and it is still not intact kTornRecordDelay after it was first seen:
+	//	an append may complete after a later one. Until then, the records after it wait, and
+	//	poll reads the file again once the delay expires. Loading skips it.
+	//
+	// REMARKS
+	//	The file is never compacted: it can be removed or truncated when no process has it open.
+	//	The write errors are ignored: the history goes on without being shared.
+	class SharedHistory {
+	public:
+		// The time given to a record being written to complete, before it is skipped as torn.
+		static constexpr std::chrono::milliseconds kTornRecordDelay{ 1000 };
+
+		// Opens or creates the shared file, and loads its latest records. A file which is not
+		// a shared history is reset.
+		//
+		// INPUT
+		//	capacity	maximum number of records to load: the capacity of the history.
+		//
+		// OUTPUT
+		//	records		the loaded records, from the oldest to the latest.
+		//
+		// EXCEPTIONS
+		//	Throws std::runtime_error if the file cannot be opened or mapped.
+		SharedHistory(const std::filesystem::path &path, size_t capacity, OUT std::vector<std::wstring> *records);
+		~SharedHistory();
+
+		SharedHistory(const SharedHistory &) = delete;
+		SharedHistory &operator=(const SharedHistory &) = delete;
+
+		//		ACCESSORS
+		//
+
+		const std::filesystem::path &path() const { return m_path; }
+
+		// writer returns the identifier of the records appended by this SharedHistory.
+		uint32_t writer() const { return m_writer; }
+
+		// generation returns the number of records appended to the file, by all the processes.
+		uint64_t generation() const;
+
+		// bytes_read returns the number of bytes of the file read since it was opened.
+		uint64_t bytes_read() const { return m_bytesRead; }
+
+		//		MANIPULATORS
+		//
+
+		// append writes a record at the end of the file.
+		void append(std::wstring_view line);
+
+		// poll reads the records appended by the other writers since the previous call.
+		//
+		// OUTPUT
+		//	lines	the new records, in append order. The previous content is cleared.
+		//
+		// RETURN VALUE
+		//	Returns the number of new records.
+		size_t poll(OUT std::vector<std::wstring> *lines);
+
+	private:
+		struct Header;
+
+		// publish writes an empty shared file under a temporary name, then moves it to the
+		// path: if replace is false, only if another process did not do it first.
+		void publish(bool replace) const;
+
+		void open_file();
+		void map_header();
+		void close_file();
+
+		uint64_t file_size() const;
+
+		// read_at reads the bytes [pos, pos + bytes) of the file into m_buf.
+		bool read_at(uint64_t pos, size_t bytes);
+
+		// write_record appends m_record to the file in a single write.
+		bool write_record();
+
+		Header &header() const;
+
+		// load reads the latest records of the file, and returns the end of the last intact one.
+		uint64_t load(OUT std::vector<std::wstring> *records);
+
+	private:
+		std::filesystem::path	m_path;
+		size_t					m_capacity;
+		uint32_t				m_writer;
+
+		// End of the records read, and the generation seen when they were read.
+		uint64_t				m_readPos{ 0 };
+		uint64_t				m_seenGeneration{ 0 };
+
+		// Position of a record which was not intact at the previous poll, or UINT64_MAX, when
+		// it was first seen, and whether an intact record follows it.
+		uint64_t				m_stallPos{ UINT64_MAX };
+		std::chrono::steady_clock::time_point	m_stallTime;
+		bool					m_stallFollowed{ false };
+
+		uint64_t				m_bytesRead{ 0 };
+
+		// Buffers of the bytes read, and of the record being appended.
+		std::vector<char>		m_buf;
+		std::vector<char>		m_record;
+
+		// The mapping of the header.
+		char					*m_view{ nullptr };
+
+#ifdef _WIN32
+		// The appends go through their own handle, opened with FILE_APPEND_DATA only.
+		void					*m_file{ nullptr };
+		void					*m_appendFile{ nullptr };
+		void					*m_mapping{ nullptr };
+#else
+		int						m_fd{ -1 };
+#endif
+	};
+}
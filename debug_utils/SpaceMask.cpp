@@ -0,0 +1,231 @@
+#include "pch.h"
+#include "SpaceMask.h"
+#include <cassert>
+#include "string_utils.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DBGUTILS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// The AVX2 kernel is compiled for AVX2 whatever the options of the build,
+// and only called if the CPU supports it.
+#if defined(DBGUTILS_X86) && !defined(_MSC_VER)
+#define DBGUTILS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DBGUTILS_TARGET_AVX2
+#endif
+
+namespace dbgutils {
+
+	static_assert(sizeof(wchar_t) == 2 || sizeof(wchar_t) == 4, "Unexpected size of wchar_t.");
+
+	// space_mask_scalar classifies the characters [begin, n) and writes the mask words
+	// from the one containing begin, which must be a multiple of 64.
+	static void space_mask_scalar(const wchar_t *s, size_t begin, size_t n, uint64_t *mask)
+	{
+		assert(begin % 64 == 0);
+
+		for (auto i = begin; i < n; i += 64) {
+			auto end = n - i < 64 ? n : i + 64;
+
+			uint64_t word = 0;
+			for (auto j = i; j < end; j++) {
+				word |= static_cast<uint64_t>(wstr_is_space(s[j])) << (j - i);
+			}
+			mask[i / 64] = word;
+		}
+	}
+
+#ifdef DBGUTILS_X86
+
+	// The kernels test c == ' ' || (c - '\t') <= ('\r' - '\t') as unsigned integers, which
+	// is the whole White_Space property for ASCII. The blocks of 64 characters holding
+	// non-ASCII characters are classified again by the scalar kernel.
+
+	static void space_mask_sse2(const wchar_t *s, size_t n, uint64_t *mask)
+	{
+		const auto space = sizeof(wchar_t) == 2 ? _mm_set1_epi16(0x20) : _mm_set1_epi32(0x20);
+		const auto tab = sizeof(wchar_t) == 2 ? _mm_set1_epi16(0x09) : _mm_set1_epi32(0x09);
+
+		size_t i = 0;
+		for (; i + 64 <= n; i += 64) {
+			uint64_t word = 0;
+
+			// Bits of all the characters of the block.
+			auto all = _mm_setzero_si128();
+
+			// 16 characters per step.
+			for (size_t j = 0; j < 64; j += 16) {
+				auto p = reinterpret_cast<const __m128i *>(s + i + j);
+				__m128i bytes;
+
+				if constexpr (sizeof(wchar_t) == 2) {
+					auto classify = [&](__m128i v) {
+						all = _mm_or_si128(all, v);
+						auto ctl = _mm_subs_epu16(_mm_sub_epi16(v, tab), _mm_set1_epi16(4));
+						return _mm_or_si128(_mm_cmpeq_epi16(v, space), _mm_cmpeq_epi16(ctl, _mm_setzero_si128()));
+					};
+					bytes = _mm_packs_epi16(classify(_mm_loadu_si128(p)), classify(_mm_loadu_si128(p + 1)));
+				}
+				else {
+					const auto bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+					const auto limit = _mm_set1_epi32(static_cast<int>(0x80000005u));
+					auto classify = [&](__m128i v) {
+						all = _mm_or_si128(all, v);
+						auto ctl = _mm_cmplt_epi32(_mm_xor_si128(_mm_sub_epi32(v, tab), bias), limit);
+						return _mm_or_si128(_mm_cmpeq_epi32(v, space), ctl);
+					};
+					auto lo = _mm_packs_epi32(classify(_mm_loadu_si128(p)), classify(_mm_loadu_si128(p + 1)));
+					auto hi = _mm_packs_epi32(classify(_mm_loadu_si128(p + 2)), classify(_mm_loadu_si128(p + 3)));
+					bytes = _mm_packs_epi16(lo, hi);
+				}
+
+				word |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(bytes))) << j;
+			}
+
+			// Any bit above the 7 lowest ones of a character means a non-ASCII character.
+			auto ascii = sizeof(wchar_t) == 2 ? _mm_set1_epi16(0x7f) : _mm_set1_epi32(0x7f);
+			auto nonAscii = _mm_andnot_si128(ascii, all);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAscii, _mm_setzero_si128())) != 0xffff) {
+				space_mask_scalar(s, i, i + 64, mask);
+				continue;
+			}
+
+			mask[i / 64] = word;
+		}
+
+		space_mask_scalar(s, i, n, mask);
+	}
+
+	DBGUTILS_TARGET_AVX2
+	static void space_mask_avx2(const wchar_t *s, size_t n, uint64_t *mask)
+	{
+		const auto space = sizeof(wchar_t) == 2 ? _mm256_set1_epi16(0x20) : _mm256_set1_epi32(0x20);
+		const auto tab = sizeof(wchar_t) == 2 ? _mm256_set1_epi16(0x09) : _mm256_set1_epi32(0x09);
+
+		size_t i = 0;
+		for (; i + 64 <= n; i += 64) {
+			uint64_t word = 0;
+
+			// Bits of all the characters of the block.
+			auto all = _mm256_setzero_si256();
+
+			// 32 characters per step.
+			for (size_t j = 0; j < 64; j += 32) {
+				auto p = reinterpret_cast<const __m256i *>(s + i + j);
+				__m256i bytes;
+
+				if constexpr (sizeof(wchar_t) == 2) {
+					all = _mm256_or_si256(all, _mm256_or_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)));
+					auto ctl0 = _mm256_subs_epu16(_mm256_sub_epi16(_mm256_loadu_si256(p), tab), _mm256_set1_epi16(4));
+					auto ctl1 = _mm256_subs_epu16(_mm256_sub_epi16(_mm256_loadu_si256(p + 1), tab), _mm256_set1_epi16(4));
+					auto m0 = _mm256_or_si256(_mm256_cmpeq_epi16(_mm256_loadu_si256(p), space), _mm256_cmpeq_epi16(ctl0, _mm256_setzero_si256()));
+					auto m1 = _mm256_or_si256(_mm256_cmpeq_epi16(_mm256_loadu_si256(p + 1), space), _mm256_cmpeq_epi16(ctl1, _mm256_setzero_si256()));
+
+					// The packing works within 128-bit lanes: put the quadwords back in order.
+					bytes = _mm256_permute4x64_epi64(_mm256_packs_epi16(m0, m1), 0xd8);
+				}
+				else {
+					const auto bias = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+					const auto limit = _mm256_set1_epi32(static_cast<int>(0x80000005u));
+					__m256i m[4];
+					for (int k = 0; k < 4; k++) {
+						auto v = _mm256_loadu_si256(p + k);
+						all = _mm256_or_si256(all, v);
+						auto ctl = _mm256_cmpgt_epi32(limit, _mm256_xor_si256(_mm256_sub_epi32(v, tab), bias));
+						m[k] = _mm256_or_si256(_mm256_cmpeq_epi32(v, space), ctl);
+					}
+
+					// The packing works within 128-bit lanes: put the doublewords back in order.
+					auto packed = _mm256_packs_epi16(_mm256_packs_epi32(m[0], m[1]), _mm256_packs_epi32(m[2], m[3]));
+					bytes = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+				}
+
+				word |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(bytes))) << j;
+			}
+
+			// Any bit above the 7 lowest ones of a character means a non-ASCII character.
+			auto ascii = sizeof(wchar_t) == 2 ? _mm256_set1_epi16(0x7f) : _mm256_set1_epi32(0x7f);
+			auto nonAscii = _mm256_andnot_si256(ascii, all);
+			if (!_mm256_testz_si256(nonAscii, nonAscii)) {
+				space_mask_scalar(s, i, i + 64, mask);
+				continue;
+			}
+
+			mask[i / 64] = word;
+		}
+
+		space_mask_scalar(s, i, n, mask);
+	}
+
+	static SIMD_LEVEL detect_simd_level()
+	{
+#ifdef _MSC_VER
+		int info[4];
+
+		__cpuid(info, 0);
+		auto maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		auto sse2 = (info[3] & (1 << 26)) != 0;
+		auto osxsave = (info[2] & (1 << 27)) != 0;
+		auto avx = (info[2] & (1 << 28)) != 0;
+
+		// AVX2 also needs the OS to save the YMM registers.
+		auto avx2 = false;
+		if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		auto sse2 = __builtin_cpu_supports("sse2") != 0;
+		auto avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+
+		if (avx2) {
+			return SIMD_LEVEL_AVX2;
+		}
+		if (sse2) {
+			return SIMD_LEVEL_SSE2;
+		}
+		return SIMD_LEVEL_SCALAR;
+	}
+
+#else
+
+	static SIMD_LEVEL detect_simd_level()
+	{
+		return SIMD_LEVEL_SCALAR;
+	}
+
+#endif
+
+	SIMD_LEVEL simd_level()
+	{
+		static const auto level = detect_simd_level();
+
+		return level;
+	}
+
+	void ComputeSpaceMask(const wchar_t *s, size_t n, uint64_t *mask)
+	{
+		ComputeSpaceMask(simd_level(), s, n, mask);
+	}
+
+	void ComputeSpaceMask(SIMD_LEVEL level, const wchar_t *s, size_t n, uint64_t *mask)
+	{
+		assert(level <= simd_level());
+
+		switch (level) {
+#ifdef DBGUTILS_X86
+		case SIMD_LEVEL_AVX2:	space_mask_avx2(s, n, mask); break;
+		case SIMD_LEVEL_SSE2:	space_mask_sse2(s, n, mask); break;
+#endif
+		default:				space_mask_scalar(s, 0, n, mask); break;
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dbgutils {
+
+	// Instruction sets used by the vectorized string kernels.
+	enum SIMD_LEVEL {
+		SIMD_LEVEL_SCALAR,
+		SIMD_LEVEL_SSE2,
+		SIMD_LEVEL_AVX2
+	};
+
+	// simd_level returns the best instruction set supported by both the build and the CPU.
+	// It is detected once, with the CPUID instruction.
+	SIMD_LEVEL simd_level();
+
+	// ComputeSpaceMask classifies a wide string into a bitmask: bit (i % 64) of mask[i / 64]
+	// is set iff s[i] is a whitespace character (see wstr_is_space).
+	// The bits past the end of the string are cleared.
+	//
+	// INPUT
+	//	mask
+	//		Array of at least (n + 63) / 64 words.
+	//
+	// REMARKS
+	//	The kernel is selected with simd_level. The overload taking a level is meant for
+	//	tests and benchmarks; the level must not be above simd_level().
+	void ComputeSpaceMask(const wchar_t *s, size_t n, uint64_t *mask);
+	void ComputeSpaceMask(SIMD_LEVEL level, const wchar_t *s, size_t n, uint64_t *mask);
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cassert>
+#include "OvwRingBuf.h"
+
+namespace dbgutils {
+
+	//					SINGLE-PRODUCER/SINGLE-CONSUMER OVERWRITING RING BUFFER
+	//
+	// A lock-free version of OvwRingBuf meant to pass items from one thread (the producer)
+	// to another one (the consumer). When the buffer is full, push_back evicts the item
+	// at the front, like OvwRingBuf does, and the evicted items are counted as dropped.
+	//
+	// The consumer does not peek at the items in place since the producer may overwrite
+	// them at any time. It pops them instead, e.g. with drain_into, which moves all the
+	// available items into an OvwRingBuf owned by the consumer thread.
+	//
+	// REMARKS
+	//	Each slot carries a sequence number telling whether it is empty or holds an item,
+	//	and which lap of the ring it belongs to. The consumer claims the front item by
+	//	advancing the front index with a CAS, and so does the producer when it evicts it.
+	//	Whoever wins the CAS owns the slot.
+	//
+	//	In the rare case where the producer wraps around onto the slot being read by the
+	//	consumer, it cannot wait without blocking, so it drops the new item instead.
+	template <class T>
+	class SpscOvwRingBuf {
+	public:
+		SpscOvwRingBuf(size_t capacity)
+			: m_capacity(capacity)
+			, m_slots(capacity)
+		{
+			assert(capacity >= 1);
+
+			for (size_t i = 0; i < capacity; i++) {
+				m_slots[i].seq.store(empty_seq(i), std::memory_order_relaxed);
+			}
+		}
+
+		SpscOvwRingBuf(const SpscOvwRingBuf &) = delete;
+		SpscOvwRingBuf &operator=(const SpscOvwRingBuf &) = delete;
+
+		//				ACCESSORS
+		//
+
+		// size returns the number of items in the buffer.
+		// It is only a snapshot when the other thread is running.
+		size_t size() const
+		{
+			auto front = m_front.value.load(std::memory_order_acquire);
+			auto back = m_back.value.load(std::memory_order_acquire);
+
+			return back > front ? back - front : 0;
+		}
+
+		// capacity returns the maximum number of items
+		// that can be stored in the buffer.
+		auto capacity() const { return m_capacity; }
+
+		bool empty() const { return size() == 0; }
+
+		// dropped returns the number of items that were lost, either because
+		// they were evicted or because they could not be inserted.
+		uint64_t dropped() const { return m_dropped.value.load(std::memory_order_relaxed); }
+
+		//				MANIPULATORS (producer thread)
+		//
+
+		// push_back inserts an item at the back of the buffer.
+		// If the buffer was full before the call, the front item is evicted.
+		// It never blocks.
+		//
+		// RETURN VALUE
+		//	Returns false iff the item itself was dropped.
+		bool push_back(const T &item)
+		{
+			auto pos = m_back.value.load(std::memory_order_relaxed);
+			auto &slot = m_slots[pos % m_capacity];
+			auto seq = slot.seq.load(std::memory_order_acquire);
+
+			if (seq != empty_seq(pos)) {
+				// The slot holds the item pushed one lap ago: the buffer is full.
+				// We evict this item if the consumer has not claimed it yet.
+				auto front = pos - m_capacity;
+				if (!m_front.value.compare_exchange_strong(front, front + 1, std::memory_order_acq_rel)) {
+					// The consumer is reading the slot.
+					m_dropped.value.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				m_dropped.value.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			slot.item = item;
+			slot.seq.store(full_seq(pos), std::memory_order_release);
+			m_back.value.store(pos + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		//				MANIPULATORS (consumer thread)
+		//
+
+		// pop_front removes the item at the front of the buffer.
+		//
+		// RETURN VALUE
+		//	Returns true iff an item was removed and stored in the output variable.
+		bool pop_front(T *item)
+		{
+			assert(item != nullptr);
+
+			auto front = m_front.value.load(std::memory_order_acquire);
+
+			for (;;) {
+				auto &slot = m_slots[front % m_capacity];
+				if (slot.seq.load(std::memory_order_acquire) != full_seq(front)) {
+					return false;// empty
+				}
+
+				// Claim the item. The CAS fails iff the producer evicted it meanwhile,
+				// in which case front is updated and we try again with the next item.
+				if (m_front.value.compare_exchange_weak(front, front + 1, std::memory_order_acq_rel)) {
+					*item = std::move(slot.item);
+					slot.seq.store(empty_seq(front + m_capacity), std::memory_order_release);
+					return true;
+				}
+			}
+		}
+
+		// drain_into pops all the available items and pushes them into a buffer.
+		//
+		// RETURN VALUE
+		//	Returns the number of items moved.
+		size_t drain_into(OvwRingBuf<T> &buf)
+		{
+			size_t n = 0;
+
+			T item;
+			while (pop_front(&item)) {
+				buf.push_back(std::move(item));
+				n++;
+			}
+
+			return n;
+		}
+
+	private:
+		static constexpr size_t kCacheLineSize = 64;
+
+		// The indices grow forever; they are reduced modulo the capacity to get a slot.
+		// Each one lives on its own cache line so that the producer and the consumer
+		// do not invalidate each other's cache when updating their own index.
+		struct alignas(kCacheLineSize) Index {
+			std::atomic<size_t>		value{ 0 };
+		};
+
+		struct alignas(kCacheLineSize) Counter {
+			std::atomic<uint64_t>	value{ 0 };
+		};
+
+		struct Slot {
+			// seq == empty_seq(pos)	the slot is empty and ready for the item at position pos.
+			// seq == full_seq(pos)		the slot holds the item at position pos.
+			std::atomic<size_t>		seq{ 0 };
+			T						item{};
+		};
+
+		// The two states of a position get distinct sequence numbers whatever the capacity:
+		// with pos and pos + 1, the item pushed one lap ago would look like an empty slot
+		// when the capacity is 1.
+		static size_t empty_seq(size_t pos) { return 2 * pos; }
+		static size_t full_seq(size_t pos) { return 2 * pos + 1; }
+
+	private:
+		size_t				m_capacity;
+		std::vector<Slot>	m_slots;
+
+		Index		m_front;	// written by the consumer, and by the producer when evicting
+		Index		m_back;		// written by the producer only
+		Counter		m_dropped;	// written by the producer only
+	};
+}
@@ -0,0 +1,243 @@
+#include "pch.h"
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <cassert>
+
+namespace dbgutils {
+
+	// A trigram packs three code units of 21 bits, which is enough for any wchar_t. The missing
+	// leading units of the shorter sequences are all ones, so that they do not clash with the
+	// trigrams of valid characters; a clash would only add candidates anyway.
+	static constexpr uint64_t kCharMask = (1u << 21) - 1;
+	static constexpr uint64_t kNoChars = (uint64_t(1) << 63) - 1;
+
+	// pack appends a character to a sequence, dropping its first one.
+	static uint64_t pack(uint64_t gram, wchar_t c)
+	{
+		return (gram << 21 | (static_cast<uint64_t>(c) & kCharMask)) & kNoChars;
+	}
+
+	void TrigramIndex::grams_of(std::wstring_view text, OUT std::vector<Gram> *grams)
+	{
+		grams->clear();
+
+		// The sequences of one, two and three characters ending at every character.
+		for (size_t i = 0; i < text.length(); i++) {
+			grams->push_back(pack(kNoChars, text[i]));
+			if (i >= 1) {
+				grams->push_back(pack(pack(kNoChars, text[i - 1]), text[i]));
+			}
+			if (i >= 2) {
+				grams->push_back(pack(pack(pack(kNoChars, text[i - 2]), text[i - 1]), text[i]));
+			}
+		}
+
+		std::sort(grams->begin(), grams->end());
+		grams->erase(std::unique(grams->begin(), grams->end()), grams->end());
+	}
+
+	void TrigramIndex::pattern_grams_of(std::wstring_view pattern, OUT std::vector<Gram> *grams)
+	{
+		grams->clear();
+
+		// A short pattern is a sequence of the index by itself.
+		if (pattern.length() < kGramLength) {
+			auto gram = kNoChars;
+			for (auto c : pattern) {
+				gram = pack(gram, c);
+			}
+			grams->push_back(gram);
+			return;
+		}
+
+		for (size_t i = 0; i + kGramLength <= pattern.length(); i++) {
+			grams->push_back(pack(pack(pack(kNoChars, pattern[i]), pattern[i + 1]), pattern[i + 2]));
+		}
+
+		std::sort(grams->begin(), grams->end());
+		grams->erase(std::unique(grams->begin(), grams->end()), grams->end());
+	}
+
+	size_t TrigramIndex::memory_usage() const
+	{
+		if (m_postings.empty()) {
+			return 0;
+		}
+
+		// A node of the map holds the key, the list and a link; a bucket holds a pointer.
+		auto bytes = m_postings.size() * (sizeof(Gram) + sizeof(Postings) + sizeof(void *))
+			+ m_postings.bucket_count() * sizeof(void *);
+
+		for (const auto &p : m_postings) {
+			bytes += p.second.seqs.capacity() * sizeof(uint32_t);
+		}
+
+		return bytes;
+	}
+
+	bool TrigramIndex::latest_below(const Postings &list, uint32_t bound, IN OUT size_t *cursor) const
+	{
+		// Gallop backwards from the cursor, then binary search the last step.
+		auto hi = *cursor;
+		size_t step = 1;
+		while (hi - list.head >= step && rank(list.seqs[hi - step]) >= bound) {
+			hi -= step;
+			step *= 2;
+		}
+		auto lo = hi - list.head >= step ? hi - step : list.head;
+
+		auto it = std::partition_point(list.seqs.begin() + lo, list.seqs.begin() + hi, [this, bound](uint32_t s) {
+			return rank(s) < bound;
+		});
+
+		*cursor = it - list.seqs.begin();
+		return *cursor > list.head;
+	}
+
+	bool TrigramIndex::find_candidate(std::wstring_view pattern, uint64_t before, OUT uint64_t *seq) const
+	{
+		return Search(*this, pattern).previous(before, seq);
+	}
+
+	TrigramIndex::Search::Search(const TrigramIndex &index, std::wstring_view pattern)
+		: m_index(&index)
+	{
+		assert(!pattern.empty());
+
+		std::vector<Gram> grams;
+		pattern_grams_of(pattern, &grams);
+
+		for (auto gram : grams) {
+			auto it = index.m_postings.find(gram);
+			if (it == index.m_postings.end()) {
+				m_cursors.clear();
+				return;
+			}
+			m_cursors.push_back(Cursor{ &it->second, it->second.seqs.size() });
+		}
+
+		// The rarest trigrams first, since they reject most of the candidates.
+		std::sort(m_cursors.begin(), m_cursors.end(), [](const Cursor &a, const Cursor &b) {
+			return a.list->seqs.size() - a.list->head < b.list->seqs.size() - b.list->head;
+		});
+	}
+
+	bool TrigramIndex::Search::previous(uint64_t before, OUT uint64_t *seq)
+	{
+		assert(seq != nullptr);
+
+		const auto &index = *m_index;
+		if (m_cursors.empty() || index.m_size == 0 || before <= index.m_first) {
+			return false;
+		}
+
+		// The rarest list proposes a candidate, and the other lists check it in order. A list
+		// without the candidate gives the bound of the next one: its latest entry below it.
+		auto bound = static_cast<uint32_t>(std::min(before, index.m_end) - index.m_first);
+		uint32_t candidate = 0;
+		for (size_t i = 0; i < m_cursors.size(); ) {
+			auto &c = m_cursors[i];
+			if (!index.latest_below(*c.list, bound, &c.pos)) {
+				return false;
+			}
+
+			auto r = index.rank(c.list->seqs[c.pos - 1]);
+			if (i == 0) {
+				candidate = r;
+				bound = r + 1;
+				i++;
+			}
+			else if (r == candidate) {
+				i++;
+			}
+			else {
+				bound = r + 1;
+				i = 0;
+			}
+		}
+
+		*seq = index.m_first + candidate;
+		return true;
+	}
+
+	void TrigramIndex::add(uint64_t seq, std::wstring_view text)
+	{
+		assert(m_size == 0 || seq >= m_end);
+
+		if (m_size == 0) {
+			m_first = seq;
+		}
+		m_end = seq + 1;
+		m_size++;
+
+		grams_of(text, &m_grams);
+		for (auto gram : m_grams) {
+			m_postings[gram].seqs.push_back(static_cast<uint32_t>(seq));
+		}
+	}
+
+	void TrigramIndex::remove(uint64_t seq, std::wstring_view text)
+	{
+		assert(m_size > 0 && m_first <= seq && seq < m_end);
+
+		grams_of(text, &m_grams);
+		for (auto gram : m_grams) {
+			auto it = m_postings.find(gram);
+			assert(it != m_postings.end());
+
+			auto &list = it->second;
+			assert(list.seqs[list.head] == static_cast<uint32_t>(seq));
+			list.head++;
+
+			if (list.head == list.seqs.size()) {
+				m_postings.erase(it);
+			}
+			else if (list.head * 2 >= list.seqs.size()) {
+				list.seqs.erase(list.seqs.begin(), list.seqs.begin() + list.head);
+				list.head = 0;
+			}
+		}
+
+		// The next entry is above the removed one.
+		m_first = seq + 1;
+		m_size--;
+	}
+
+	std::vector<uint32_t>::iterator TrigramIndex::find(Postings &list, uint64_t seq)
+	{
+		auto it = std::partition_point(list.seqs.begin() + list.head, list.seqs.end(), [this, seq](uint32_t s) {
+			return rank(s) < rank(seq);
+		});
+		assert(it != list.seqs.end() && *it == static_cast<uint32_t>(seq));
+
+		return it;
+	}
+
+	void TrigramIndex::erase(uint64_t seq, std::wstring_view text)
+	{
+		assert(m_size > 0 && m_first <= seq && seq < m_end);
+
+		grams_of(text, &m_grams);
+		for (auto gram : m_grams) {
+			auto it = m_postings.find(gram);
+			assert(it != m_postings.end());
+
+			auto &list = it->second;
+			list.seqs.erase(find(list, seq));
+
+			if (list.head == list.seqs.size()) {
+				m_postings.erase(it);
+			}
+		}
+
+		m_size--;
+	}
+
+	void TrigramIndex::clear()
+	{
+		m_postings.clear();
+		m_size = 0;
+		m_first = 0;
+		m_end = 0;
+	}
+}
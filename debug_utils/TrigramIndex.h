@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#define IN
+#define OUT
+#define OPTIONAL
+
+namespace dbgutils {
+
+	//							TRIGRAM INDEX
+	//
+	// The TrigramIndex finds the entries of a history whose text contains a pattern, from the
+	// latest to the oldest. The entries are identified by a number which increases in push
+	// order, with gaps where entries were removed (the ids of ConsoleHistory).
+	//
+	// Every sequence of three characters (trigram) of a text is a key of the index, which maps
+	// it to the posting list of the entries containing it, in increasing order:
+	//
+	//		L"git"	[ 3, 17, 42, 43 ]
+	//		L"it "	[ 3, 42, 43 ]
+	//
+	// The sequences of one and two characters are keys too, so that the patterns shorter than
+	// a trigram, i.e. the first keystrokes of a search, are found with their own list instead
+	// of scanning the entries.
+	//
+	// The entries containing every trigram of a pattern are found by intersecting their lists
+	// backwards: the rarest list proposes its latest entry below a bound, and the other lists,
+	// from the rarest, check it. A list without it lowers the bound to its latest entry below
+	// the candidate, and the rarest list proposes again. The cursors of the lists only move
+	// backwards, with galloping searches, so a search costs about the number of rejected
+	// candidates times the log of the skipped distance. The agreed entry holds
+	// all the trigrams but not necessarily the pattern: the caller checks it (see ConsoleHistory).
+	//
+	// The entries are added in increasing order and usually removed oldest first, so most
+	// changes are an append or a removal at the front of the posting lists. An entry removed
+	// from the middle (see erase) is erased from its lists: the numbers of the other entries
+	// do not change.
+	//
+	// MEMORY
+	//	The posting lists hold the numbers modulo 2^32: they are compared relative to the
+	//	oldest entry, so the index works as long as the numbers of its entries span less than
+	//	2^32.
+	//	The removed numbers are erased from a list once they take half of it.
+	class TrigramIndex {
+	public:
+		// Length of the longest indexed sequences. A longer pattern is searched with its trigrams.
+		static constexpr size_t kGramLength = 3;
+
+		//		ACCESSORS
+		//
+
+		// size returns the number of entries.
+		size_t size() const { return m_size; }
+
+		// num_grams returns the number of distinct sequences of the entries.
+		size_t num_grams() const { return m_postings.size(); }
+
+		// memory_usage returns an estimate of the number of bytes allocated by the index.
+		size_t memory_usage() const;
+
+		// find_candidate returns the latest entry before a given one which contains every
+		// trigram of a pattern, or the whole pattern if it is shorter. The pattern must not
+		// be empty.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		bool find_candidate(std::wstring_view pattern, uint64_t before, OUT uint64_t *seq) const;
+
+		// A Search goes through the candidates of a pattern from the latest to the oldest,
+		// keeping its place in the posting lists from one candidate to the next.
+		//
+		// REMARKS
+		//	The search is invalidated by the next call to a manipulator of the index.
+		class Search;
+
+		//		MANIPULATORS
+		//
+
+		// add indexes the text of a new entry. Its number is above the one of the latest entry.
+		void add(uint64_t seq, std::wstring_view text);
+
+		// remove drops the oldest entry, which has the given number and text.
+		void remove(uint64_t seq, std::wstring_view text);
+
+		// erase drops any entry, which has the given number and text.
+		void erase(uint64_t seq, std::wstring_view text);
+
+		void clear();
+
+	private:
+		using Gram = uint64_t;
+
+		// A posting list. The entries before head were removed.
+		struct Postings {
+			std::vector<uint32_t>	seqs;
+			size_t					head{ 0 };
+		};
+
+		// A position in a posting list: one past an entry.
+		struct Cursor {
+			const Postings	*list;
+			size_t			pos;
+		};
+
+		// grams_of returns the distinct sequences of one to three characters of a text, sorted.
+		static void grams_of(std::wstring_view text, OUT std::vector<Gram> *grams);
+
+		// pattern_grams_of returns the distinct keys searched for a pattern, sorted: its
+		// trigrams, or the pattern itself if it is shorter.
+		static void pattern_grams_of(std::wstring_view pattern, OUT std::vector<Gram> *grams);
+
+		// rank returns the position of an entry relative to the oldest one.
+		uint32_t rank(uint64_t seq) const { return static_cast<uint32_t>(seq - m_first); }
+
+		// latest_below moves the position of a cursor in a list backwards, to one past
+		// the latest entry below a rank.
+		//
+		// RETURN VALUE
+		//	Returns false iff all the entries of the list before the cursor are at or above the rank.
+		bool latest_below(const Postings &list, uint32_t bound, IN OUT size_t *cursor) const;
+
+		// find returns the position of an entry in the list of a trigram.
+		std::vector<uint32_t>::iterator find(Postings &list, uint64_t seq);
+
+	private:
+		std::unordered_map<Gram, Postings>	m_postings;
+
+		// Number of entries. The numbers of the entries are from m_first, which is at or below
+		// the number of the oldest one, to below m_end.
+		size_t		m_size{ 0 };
+		uint64_t	m_first{ 0 };
+		uint64_t	m_end{ 0 };
+
+		// Trigrams of the entry being added or removed.
+		std::vector<Gram>	m_grams;
+	};
+
+	class TrigramIndex::Search {
+	public:
+		Search(const TrigramIndex &index, std::wstring_view pattern);
+
+		// previous returns the latest candidate before a given entry. The entries must go
+		// down from one call to the next: the entry is usually the previous candidate.
+		//
+		// RETURN VALUE
+		//	Returns false iff there is no such entry.
+		bool previous(uint64_t before, OUT uint64_t *seq);
+
+	private:
+		const TrigramIndex		*m_index;
+
+		// The cursors of the lists of the keys of the pattern, rarest first. Empty if a key
+		// is not in the index.
+		std::vector<Cursor>		m_cursors;
+	};
+}
@@ -0,0 +1,59 @@
+#include "pch.h"
+#include <cassert>
+#include "WorkerPool.h"
+
+namespace dbgutils {
+
+	WorkerPool::WorkerPool(size_t numThreads)
+	{
+		assert(numThreads >= 1);
+
+		for (size_t i = 0; i < numThreads; i++) {
+			m_threads.emplace_back(&WorkerPool::worker_loop, this);
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_cv.notify_all();
+
+		for (auto &t : m_threads) {
+			t.join();
+		}
+	}
+
+	void WorkerPool::submit(Job job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.push_back(std::move(job));
+		}
+		m_cv.notify_one();
+	}
+
+	void WorkerPool::worker_loop()
+	{
+		for (;;) {
+			Job job;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_cv.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+
+				// The remaining jobs are still executed when stopping.
+				if (m_jobs.empty()) {
+					return;
+				}
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+}
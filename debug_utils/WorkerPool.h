@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace dbgutils {
+
+	//							WORKER POOL
+	//
+	// A fixed number of threads executing jobs in FIFO order.
+	// The destructor waits for all the submitted jobs to complete.
+	class WorkerPool {
+	public:
+		using Job = std::function<void()>;
+
+		WorkerPool(size_t numThreads);
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool &) = delete;
+		WorkerPool &operator=(const WorkerPool &) = delete;
+
+		//		ACCESSORS
+		//
+		auto num_threads() const { return m_threads.size(); }
+
+		//		MANIPULATORS
+		//
+
+		// submit queues a job. It never waits for a job to complete.
+		void submit(Job job);
+
+	private:
+		void worker_loop();
+
+	private:
+		std::vector<std::thread>	m_threads;
+
+		std::mutex					m_mutex;
+		std::condition_variable		m_cv;
+		std::deque<Job>				m_jobs;
+		bool						m_stopping{ false };
+	};
+}
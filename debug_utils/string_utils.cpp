@@ -2,9 +2,8 @@
 #include "string_utils.h"
 #include <sstream>
 #include <algorithm>
-#include <iterator>
-#include <cctype>
-#include <locale>
+#include <cassert>
+#include "CharClass.h"
 
 std::wstring wstr_concat(IN const std::vector<std::wstring> &strs, IN const std::wstring &sep)
 {
@@ -32,27 +31,84 @@ bool wstr_find_substr(IN const std::wstring &str, IN const std::wstring &substr,
 
 std::vector<std::wstring> wstr_split(IN const std::wstring &str)
 {
-	using namespace std;
+	std::vector<std::wstring_view> views;
+	wstr_tokenize(str, &views);
 
-	wistringstream iss(str);
-	vector<wstring> tokens{ istream_iterator<wstring, wchar_t>{iss}, istream_iterator<wstring, wchar_t>{} };
+	return std::vector<std::wstring>(views.begin(), views.end());
+}
+
+bool wstr_is_space(IN wchar_t c)
+{
+	return dbgutils::is_white_space(c);
+}
+
+void wstr_tokenize(IN std::wstring_view str, OUT std::vector<std::wstring_view> *tokens)
+{
+	assert(tokens != nullptr);
+
+	tokens->clear();
+
+	const auto n = str.length();
+	size_t i = 0;
+
+	while (i < n) {
+		// Skip the whitespaces before the token.
+		while (i < n && wstr_is_space(str[i])) {
+			i++;
+		}
+		if (i == n) {
+			break;
+		}
+
+		// Find the end of the token.
+		auto begin = i;
+		while (i < n && !wstr_is_space(str[i])) {
+			i++;
+		}
+
+		tokens->push_back(str.substr(begin, i - begin));
+	}
+}
+
+void wstr_split_lines(IN std::wstring_view str, OUT std::vector<std::wstring_view> *lines)
+{
+	assert(lines != nullptr);
+
+	lines->clear();
+
+	const auto n = str.length();
+	size_t begin = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (str[i] != L'\r' && str[i] != L'\n') {
+			continue;
+		}
+
+		lines->push_back(str.substr(begin, i - begin));
+
+		// "\r\n" is a single line break.
+		if (str[i] == L'\r' && i + 1 < n && str[i + 1] == L'\n') {
+			i++;
+		}
+		begin = i + 1;
+	}
 
-	return tokens;
+	lines->push_back(str.substr(begin));
 }
 
 // trim from start (in place)
 void wstr_ltrim(IN OUT std::wstring &s)
 {
-	s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) {
-		return !std::isspace(ch);
+	s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](wchar_t ch) {
+		return !wstr_is_space(ch);
 	}));
 }
 
 // trim from end (in place)
 void wstr_rtrim(IN OUT std::wstring &s)
 {
-	s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch) {
-		return !std::isspace(ch);
+	s.erase(std::find_if(s.rbegin(), s.rend(), [](wchar_t ch) {
+		return !wstr_is_space(ch);
 	}).base(), s.end());
 }
 
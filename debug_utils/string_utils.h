@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #define IN
@@ -19,8 +20,29 @@ bool wstr_find_substr(
 	OUT size_t *i
 );
 
+// wstr_split splits a string into whitespace-separated tokens (see wstr_tokenize).
 std::vector<std::wstring> wstr_split(IN const std::wstring &str);
 
+// wstr_is_space returns true iff c is a whitespace character, i.e. has the Unicode
+// White_Space property (see CharClass.h). It does not depend on the locale.
+bool wstr_is_space(IN wchar_t c);
+
+// wstr_tokenize splits a string into whitespace-separated tokens in a single pass.
+// The tokens are views on the input string. The tokens vector is cleared first
+// so it can be reused from one call to another without allocating.
+void wstr_tokenize(
+	IN std::wstring_view str,
+	OUT std::vector<std::wstring_view> *tokens
+);
+
+// wstr_split_lines splits a string into lines separated by "\r\n", "\n" or "\r".
+// A string with n line breaks gives n + 1 lines (the last one may be empty).
+// The lines are views on the input string. The lines vector is cleared first.
+void wstr_split_lines(
+	IN std::wstring_view str,
+	OUT std::vector<std::wstring_view> *lines
+);
+
 // trim from start (in place)
 void wstr_ltrim(IN OUT std::wstring &s);
 
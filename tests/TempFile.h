@@ -0,0 +1,24 @@
+#pragma once
+
+#include <filesystem>
+
+// A file in the temporary directory, deleted when the test ends.
+class TempFile {
+public:
+	TempFile(const char *name)
+		: m_path(std::filesystem::temp_directory_path() / name)
+	{
+		std::filesystem::remove(m_path);
+	}
+
+	~TempFile()
+	{
+		std::error_code ec;
+		std::filesystem::remove(m_path, ec);
+	}
+
+	const std::filesystem::path &path() const { return m_path; }
+
+private:
+	std::filesystem::path m_path;
+};
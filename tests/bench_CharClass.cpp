@@ -0,0 +1,110 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <cwctype>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "..\debug_utils\CharClass.h"
+#include "..\debug_utils\string_utils.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+static std::wstring make_text(size_t length)
+{
+	// Words of various lengths, some of them accented, separated by spaces and tabs.
+	const wchar_t *words[] = { L"spawn", L"unit", L"42", L"caf\u00e9", L"x", L"teleport", L"\u00e9t\u00e9", L"-1.5" };
+	const size_t n = sizeof(words) / sizeof(words[0]);
+
+	std::wstring s;
+	for (size_t i = 0; s.length() < length; i++) {
+		s += words[(i * 7) % n];
+		s += i % 5 == 0 ? L'\t' : L' ';
+	}
+	s.resize(length);
+
+	return s;
+}
+
+template <class F>
+static double ns_per_op(size_t numOps, size_t repeat, F f)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < repeat; i++) {
+		f();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / (repeat * numOps);
+}
+
+TEST(BenchCharClass, DISABLED_IsSpace)
+{
+	const size_t kLength = 64 * 1024;
+	const size_t kRepeat = 1000;
+
+	auto s = make_text(kLength);
+
+	size_t numSpaces = 0;
+	auto ns = ns_per_op(kLength, kRepeat, [&]() {
+		for (auto c : s) {
+			numSpaces += dbgutils::is_white_space(c);
+		}
+	});
+	std::printf("is_white_space         %6.3f ns/char\n", ns);
+
+	ns = ns_per_op(kLength, kRepeat, [&]() {
+		for (auto c : s) {
+			numSpaces += std::iswspace(static_cast<wint_t>(c)) != 0;
+		}
+	});
+	std::printf("iswspace               %6.3f ns/char\n", ns);
+
+	ns = ns_per_op(kLength, kRepeat, [&]() {
+		for (auto c : s) {
+			numSpaces += static_cast<int>(dbgutils::char_class(c));
+		}
+	});
+	std::printf("char_class             %6.3f ns/char  (%zu)\n", ns, numSpaces);
+}
+
+TEST(BenchCharClass, DISABLED_Split)
+{
+	const size_t kLength = 1024;
+	const size_t kRepeat = 20000;
+
+	auto s = make_text(kLength);
+
+	size_t numTokens = 0;
+	auto ns = ns_per_op(kLength, kRepeat, [&]() {
+		numTokens += wstr_split(s).size();
+	});
+	std::printf("wstr_split             %6.3f ns/char\n", ns);
+
+	// The former implementation, with a string stream.
+	ns = ns_per_op(kLength, kRepeat, [&]() {
+		std::wistringstream iss(s);
+		std::vector<std::wstring> tokens{ std::istream_iterator<std::wstring, wchar_t>{iss}, std::istream_iterator<std::wstring, wchar_t>{} };
+		numTokens += tokens.size();
+	});
+	std::printf("wistringstream         %6.3f ns/char  (%zu tokens)\n", ns, numTokens);
+}
+
+TEST(BenchCharClass, DISABLED_Trim)
+{
+	const size_t kRepeat = 1000000;
+
+	auto s = L"  \t " + make_text(64) + L" \t  ";
+
+	size_t length = 0;
+	auto ns = ns_per_op(1, kRepeat, [&]() {
+		auto copy = s;
+		wstr_trim(copy);
+		length += copy.length();
+	});
+	std::printf("wstr_trim              %6.3f ns/call  (%zu)\n", ns, length);
+}
@@ -0,0 +1,36 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "..\debug_utils\Console.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+TEST(BenchConsole, DISABLED_HistoryNavigation)
+{
+	// Hold the Up key through a full history of long lines, then come back down.
+	const size_t kNumEntries = 10000;
+	const size_t kLineLength = 1000;
+
+	dbgutils::Console cons(dbgutils::Interpreter(), kNumEntries);
+	for (size_t i = 0; i < kNumEntries; i++) {
+		cons.insert_text(std::to_wstring(i) + std::wstring(kLineLength, L'x'));
+		cons.handle_key(VK_RETURN);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	size_t numChars = 0;
+	while (cons.handle_key(VK_UP)) {
+		numChars += cons.cmdline().length();
+	}
+	while (cons.handle_key(VK_DOWN)) {
+		numChars += cons.cmdline().length();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto ns = std::chrono::duration<double, std::nano>(end - start).count() / (2 * kNumEntries);
+
+	std::printf("Up/Down through %zu entries  %8.1f ns/key  (%zu chars shown)\n", kNumEntries, ns, numChars);
+}
@@ -0,0 +1,297 @@
+#include "pch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "..\debug_utils\ConsoleHistory.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+// The former history: one string per entry, in a ring preallocated at the capacity.
+class StringRingHistory {
+public:
+	StringRingHistory(size_t capacity) : m_buf(capacity) {}
+
+	void push(std::wstring_view line)
+	{
+		m_buf[m_top].assign(line);
+		m_top = (m_top + 1) % m_buf.size();
+	}
+
+	// memory_usage counts the strings and the heap blocks of the long ones,
+	// without the overhead of the allocator.
+	size_t memory_usage() const
+	{
+		auto bytes = m_buf.capacity() * sizeof(std::wstring);
+		for (const auto &s : m_buf) {
+			if (s.capacity() * sizeof(wchar_t) >= sizeof(std::wstring)) {
+				bytes += (s.capacity() + 1) * sizeof(wchar_t);
+			}
+		}
+		return bytes;
+	}
+
+private:
+	std::vector<std::wstring>	m_buf;
+	size_t						m_top{ 0 };
+};
+
+template <class History>
+static void bench_push(const char *name, size_t numEntries)
+{
+	// Command lines of 20 to 60 characters.
+	std::vector<std::wstring> lines;
+	for (size_t i = 0; i < 64; i++) {
+		lines.push_back(L"spawn unit " + std::to_wstring(i) + std::wstring(10 + (i * 7) % 40, L'x'));
+	}
+
+	History history(numEntries);
+
+	// Fill the history, then push as many entries again, which evicts the oldest ones.
+	double ns[2];
+	for (int lap = 0; lap < 2; lap++) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < numEntries; i++) {
+			history.push(lines[(lap + i) % lines.size()]);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		ns[lap] = std::chrono::duration<double, std::nano>(end - start).count() / numEntries;
+	}
+
+	std::printf("%-18s %8zu entries  fill %6.1f ns/push  full %6.1f ns/push  %6.1f bytes/entry\n",
+		name, numEntries, ns[0], ns[1], static_cast<double>(history.memory_usage()) / numEntries);
+}
+
+TEST(BenchConsoleHistory, DISABLED_Push)
+{
+	for (size_t numEntries : { 10000, 100000, 1000000 }) {
+		bench_push<StringRingHistory>("vector<wstring>", numEntries);
+		bench_push<dbgutils::ConsoleHistory>("ConsoleHistory", numEntries);
+	}
+}
+
+// Command lines made of a few words, with numbers so that most of them are distinct.
+static std::wstring random_command(uint32_t &state)
+{
+	static const wchar_t *const words[] = {
+		L"spawn", L"unit", L"teleport", L"player", L"set", L"gravity", L"kill", L"all",
+		L"reload", L"shaders", L"texture", L"stats", L"fps", L"camera", L"free", L"toggle"
+	};
+
+	auto next = [&state]() { state = state * 1664525u + 1013904223u; return state >> 8; };
+
+	std::wstring line = words[next() % 16];
+	for (auto n = 1 + next() % 3; n > 0; n--) {
+		line += L' ';
+		line += words[next() % 16];
+	}
+	line += L' ';
+	line += std::to_wstring(next() % 100000);
+	return line;
+}
+
+TEST(BenchConsoleHistory, DISABLED_ReverseSearch)
+{
+	const size_t numEntries = 1000000;
+
+	dbgutils::ConsoleHistory history(numEntries);
+	uint32_t state = 1;
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < 2 * numEntries; i++) {
+		history.push(random_command(state));
+	}
+	auto end = std::chrono::steady_clock::now();
+	std::printf("%zu entries  push %6.1f ns  %6.1f bytes/entry without the trigram index\n", numEntries,
+		std::chrono::duration<double, std::nano>(end - start).count() / (2 * numEntries),
+		static_cast<double>(history.memory_usage()) / numEntries);
+
+	// The searches of every keystroke of a pattern, from the latest entry.
+	// The last patterns match a few entries, or none, and the very last one matches none
+	// from its first keystroke.
+	history.push(L"teleport player 123456 once");
+
+	// The first search builds the trigram index.
+	{
+		uint64_t seq;
+		auto start = std::chrono::steady_clock::now();
+		history.find_previous(L"x", history.end_seq(), &seq);
+		auto end = std::chrono::steady_clock::now();
+		std::printf("first search %8.1f ms  %6.1f bytes/entry with the trigram index\n",
+			std::chrono::duration<double, std::milli>(end - start).count(),
+			static_cast<double>(history.memory_usage()) / numEntries);
+	}
+
+	for (std::wstring pattern : { L"teleport player", L"shaders 4242", L"free camera 99999", L"stats 123456", L"teleport player 123456", L"#kill" }) {
+		size_t numFound = 0;
+		double worst = 0;
+		double total = 0;
+
+		for (size_t len = 1; len <= pattern.length(); len++) {
+			uint64_t seq;
+			auto start = std::chrono::steady_clock::now();
+			numFound += history.find_previous(std::wstring_view(pattern).substr(0, len), history.end_seq(), &seq);
+			auto end = std::chrono::steady_clock::now();
+
+			auto us = std::chrono::duration<double, std::micro>(end - start).count();
+			worst = std::max(worst, us);
+			total += us;
+		}
+
+		std::printf("%-24ls %2zu/%2zu keystrokes found  mean %8.1f us  worst %8.1f us\n",
+			pattern.c_str(), numFound, pattern.length(), total / pattern.length(), worst);
+	}
+}
+
+TEST(BenchConsoleHistory, DISABLED_PrefixNavigation)
+{
+	const size_t numEntries = 1000000;
+	const size_t numSteps = 5000;
+
+	dbgutils::ConsoleHistory history(numEntries);
+	uint32_t state = 1;
+	for (size_t i = 0; i < 2 * numEntries; i++) {
+		history.push(random_command(state));
+	}
+	history.push(L"teleport player 123456 once");
+	std::printf("%zu entries  %6.1f bytes/entry\n", numEntries, static_cast<double>(history.memory_usage()) / numEntries);
+
+	// The up arrow key pressed numSteps times, through the index and through the entries
+	// one by one, then the down arrow key pressed as many times. The last prefixes match
+	// a few entries, or none.
+	for (std::wstring prefix : { L"s", L"teleport", L"shaders 4", L"stats 12345", L"teleport player 123456" }) {
+		double indexed = 0;
+		double worst = 0;
+		double scanned = 0;
+		size_t numFound = 0;
+
+		auto before = history.end_seq();
+		for (size_t step = 0; step < numSteps; step++) {
+			uint64_t seq = 0;
+			auto start = std::chrono::steady_clock::now();
+			auto found = history.find_previous_with_prefix(prefix, before, &seq);
+			auto end = std::chrono::steady_clock::now();
+			auto us = std::chrono::duration<double, std::micro>(end - start).count();
+			indexed += us;
+			worst = std::max(worst, us);
+
+			uint64_t expected = 0;
+			auto expectedFound = false;
+			start = std::chrono::steady_clock::now();
+			for (auto s = before; s > history.begin_seq(); s--) {
+				if (history.entry(s - 1).substr(0, prefix.length()) == prefix) {
+					expected = s - 1;
+					expectedFound = true;
+					break;
+				}
+			}
+			end = std::chrono::steady_clock::now();
+			scanned += std::chrono::duration<double, std::micro>(end - start).count();
+
+			ASSERT_EQ(found, expectedFound);
+			ASSERT_EQ(seq, expected);
+			if (!found) {
+				break;
+			}
+			numFound++;
+			before = seq;
+		}
+
+		auto numSearches = std::min(numFound + 1, numSteps);
+
+		double back = 0;
+		for (size_t step = 1; step < numFound; step++) {
+			uint64_t seq = 0;
+			auto start = std::chrono::steady_clock::now();
+			history.find_next_with_prefix(prefix, before, &seq);
+			auto end = std::chrono::steady_clock::now();
+			back += std::chrono::duration<double, std::micro>(end - start).count();
+			before = seq;
+		}
+
+		std::printf("%-24ls %4zu found  up: index %6.2f us (worst %6.2f us)  scan %8.2f us  down: index %6.2f us\n",
+			prefix.c_str(), numFound, indexed / numSearches, worst, scanned / numSearches,
+			numFound > 1 ? back / (numFound - 1) : 0.0);
+	}
+}
+
+// Command lines where most commands repeat: 90% of them are drawn from a few favorite
+// ones, the most recent ones more likely, and the others are new.
+static std::wstring repeated_command(uint32_t &state, size_t i)
+{
+	auto next = [&state]() { state = state * 1664525u + 1013904223u; return state >> 8; };
+
+	if (next() % 10 == 0) {
+		return L"spawn unit " + std::to_wstring(i);
+	}
+
+	// Skewed towards the first favorites.
+	auto favorite = next() % 8 * (next() % 8) / 2;
+	return L"teleport player " + std::to_wstring(favorite) + L" gravity 0.5";
+}
+
+TEST(BenchConsoleHistory, DISABLED_PushRepeatedCommands)
+{
+	const size_t numPushes = 1000000;
+
+	for (size_t capacity : { 32, 1000, 100000 }) {
+		for (auto duplicates : { dbgutils::HISTORY_DUPLICATES_KEEP, dbgutils::HISTORY_DUPLICATES_ERASE_OLDER }) {
+			dbgutils::ConsoleHistory history(capacity);
+			history.set_duplicates(duplicates);
+			uint32_t state = 1;
+
+			// The commands are made beforehand, so that only the pushes are timed.
+			std::vector<std::wstring> lines;
+			for (size_t i = 0; i < numPushes; i++) {
+				lines.push_back(repeated_command(state, i));
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			for (const auto &line : lines) {
+				history.push(line);
+			}
+			auto end = std::chrono::steady_clock::now();
+
+			// The distinct commands reachable in the history.
+			std::vector<std::wstring> distinct;
+			for (auto seq = history.begin_seq(); seq < history.end_seq(); seq++) {
+				distinct.emplace_back(history.entry(seq));
+			}
+			std::sort(distinct.begin(), distinct.end());
+			auto numDistinct = std::unique(distinct.begin(), distinct.end()) - distinct.begin();
+
+			std::printf("%7zu entries  %-11s %6.1f ns/push  %6zu distinct  %6.1f bytes/entry\n",
+				capacity, duplicates == dbgutils::HISTORY_DUPLICATES_KEEP ? "keep" : "erase older",
+				std::chrono::duration<double, std::nano>(end - start).count() / numPushes,
+				static_cast<size_t>(numDistinct), static_cast<double>(history.memory_usage()) / history.size());
+		}
+	}
+}
+
+TEST(BenchConsoleHistory, DISABLED_RepeatAnOldEntry)
+{
+	const size_t numEntries = 1000000;
+
+	dbgutils::ConsoleHistory history(numEntries);
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	for (size_t i = 0; i < numEntries; i++) {
+		history.push(L"spawn unit " + std::to_wstring(i));
+	}
+
+	// The repeated entry is removed from the middle of the history: the later entries
+	// move down, and keep their ids in the indexes.
+	for (size_t i : { size_t(1), numEntries / 2, numEntries - 2 }) {
+		auto line = L"spawn unit " + std::to_wstring(i);
+
+		auto start = std::chrono::steady_clock::now();
+		history.push(line);
+		auto end = std::chrono::steady_clock::now();
+
+		std::printf("repeat of the entry %7zu  %8.3f ms\n", i,
+			std::chrono::duration<double, std::milli>(end - start).count());
+	}
+}
@@ -0,0 +1,162 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include "..\debug_utils\EditBox.h"
+#include "..\debug_utils\GapBuffer.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+static const size_t kLineLength = 100 * 1024 / sizeof(wchar_t);	// 100 KB
+static const size_t kNumBursts = 2000;
+
+// bench_edits moves to a random position, then types and erases a burst of characters
+// there, like an operator fixing a long pasted command line. burst = 1 is the worst case
+// of the gap buffer: every edit moves the gap.
+template <class Text, class Insert, class Erase>
+static void bench_edits(const char *name, size_t burst, Insert insert, Erase erase)
+{
+	Text text(std::wstring(kLineLength, L'x'));
+	std::mt19937 rng(42);
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < kNumBursts; i++) {
+		auto pos = std::uniform_int_distribution<size_t>(0, kLineLength)(rng);
+		for (size_t j = 0; j < burst; j++) {
+			insert(text, pos + j, L'a');
+		}
+		erase(text, pos, burst);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto ns = std::chrono::duration<double, std::nano>(end - start).count() / (kNumBursts * 2 * burst);
+
+	std::printf("%-12s burst %3zu  %8.1f ns/edit\n", name, burst, ns);
+}
+
+TEST(BenchEditBox, DISABLED_RandomCaretEdits)
+{
+	for (size_t burst : { 1, 16, 64 }) {
+		bench_edits<std::wstring>("wstring", burst,
+			[](std::wstring &s, size_t pos, wchar_t c) { s.insert(pos, 1, c); },
+			[](std::wstring &s, size_t pos, size_t n) {
+				// One character at a time, as backspace does.
+				for (size_t k = n; k > 0; k--) {
+					s.erase(pos + k - 1, 1);
+				}
+			});
+
+		bench_edits<dbgutils::GapBuffer>("GapBuffer", burst,
+			[](dbgutils::GapBuffer &b, size_t pos, wchar_t c) { b.insert(pos, c); },
+			[](dbgutils::GapBuffer &b, size_t pos, size_t n) {
+				for (size_t k = n; k > 0; k--) {
+					b.erase(pos + k - 1, 1);
+				}
+			});
+	}
+}
+
+// bench_type_in_the_middle types and erases through the EditBox, with the caret in the middle
+// of the line, and reads the line after every key as the console does to draw it.
+template <class Read>
+static void bench_type_in_the_middle(const char *name, Read read)
+{
+	const size_t kNumKeys = 100000;
+
+	dbgutils::EditBox ed(std::wstring(kLineLength, L'x'));
+	for (size_t i = 0; i < kLineLength / 2; i++) {
+		ed.handle_key(VK_LEFT);
+	}
+
+	size_t checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < kNumKeys; i++) {
+		ed.handle_character(L'a');
+		checksum += read(ed);
+		ed.handle_key(VK_BACK);
+		checksum += read(ed);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto ns = std::chrono::duration<double, std::nano>(end - start).count() / (kNumKeys * 2);
+
+	std::printf("EditBox %-12s %10.1f ns/key  (checksum %zu)\n", name, ns, checksum);
+}
+
+TEST(BenchEditBox, DISABLED_TypeInTheMiddle)
+{
+	bench_type_in_the_middle("no read", [](const dbgutils::EditBox &) { return size_t(0); });
+
+	// The console reads the segments of the gap buffer; content copies them.
+	bench_type_in_the_middle("segments()", [](const dbgutils::EditBox &ed) {
+		auto segs = ed.segments();
+		return segs.first.length() + segs.second.length();
+	});
+	bench_type_in_the_middle("content()", [](const dbgutils::EditBox &ed) { return ed.content().length(); });
+}
+
+TEST(BenchEditBox, DISABLED_CtrlArrowNavigation)
+{
+	// Ctrl+Left then Ctrl+Right with the caret in the middle of lines of words
+	// of various lengths. The cost should not depend on the length of the line.
+	const size_t kNumKeys = 100000;
+
+	for (size_t numWords : { 100, 1000, 10000, 100000 }) {
+		std::wstring line;
+		for (size_t i = 0; i < numWords; i++) {
+			line += L"word ";
+		}
+
+		auto ctrl = ModKeyState{ true, false };
+
+		dbgutils::EditBox ed(line);
+		for (size_t i = 0; i < numWords / 2; i++) {
+			ed.handle_key(VK_LEFT, ctrl);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < kNumKeys / 2; i++) {
+			ed.handle_key(VK_LEFT, ctrl);
+			ed.handle_key(VK_RIGHT, ctrl);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		auto ns = std::chrono::duration<double, std::nano>(end - start).count() / kNumKeys;
+
+		std::printf("%7zu chars  %8.1f ns/key\n", line.length(), ns);
+	}
+}
+
+TEST(BenchEditBox, DISABLED_UndoRedo)
+{
+	// Undo then redo a typed word in the middle of lines of various lengths.
+	// The cost should depend on the size of the edit, not on the length of the line.
+	const size_t kNumKeys = 100000;
+
+	for (size_t length : { 1000, 10000, 100000 }) {
+		dbgutils::EditBox ed(std::wstring(length, L'x'));
+		for (size_t i = 0; i < length / 2; i++) {
+			ed.handle_key(VK_LEFT);
+		}
+		for (auto c : std::wstring(L"word")) {
+			ed.handle_character(c);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < kNumKeys / 2; i++) {
+			ed.undo();
+			ed.redo();
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		auto ns = std::chrono::duration<double, std::nano>(end - start).count() / kNumKeys;
+
+		std::printf("%7zu chars  %8.1f ns/undo  (%zu bytes of log)\n", length, ns, ed.edit_log().memory_usage());
+	}
+}
@@ -0,0 +1,72 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "..\debug_utils\FrecencyRanking.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+// Command lines of a session: a few favorite ones, skewed towards the first ones, and
+// many others used once.
+static std::wstring session_command(uint32_t &state, size_t i)
+{
+	static const wchar_t *const favorites[] = {
+		L"teleport player 0 0 0", L"set gravity 0.5", L"reload shaders", L"stats fps",
+		L"toggle camera free", L"spawn unit tank", L"kill all", L"set gravity 9.81"
+	};
+
+	auto next = [&state]() { state = state * 1664525u + 1013904223u; return state >> 8; };
+
+	if (next() % 4 == 0) {
+		return L"spawn unit " + std::to_wstring(i);
+	}
+	return favorites[next() % 8 * (next() % 8) / 8];
+}
+
+TEST(BenchFrecencyRanking, DISABLED_LongSession)
+{
+	const size_t numLaps = 4;
+	const size_t numAdds = 1000000;
+
+	dbgutils::FrecencyRanking ranking;
+	uint32_t state = 1;
+
+	// The memory stays the same from a lap to the next.
+	for (size_t lap = 0; lap < numLaps; lap++) {
+		std::vector<std::wstring> lines;
+		for (size_t i = 0; i < numAdds; i++) {
+			lines.push_back(session_command(state, lap * numAdds + i));
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (const auto &line : lines) {
+			ranking.add(line);
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		std::printf("%zu adds  %6.1f ns/add  %zu commands  %zu bytes\n", (lap + 1) * numAdds,
+			std::chrono::duration<double, std::nano>(end - start).count() / numAdds,
+			ranking.size(), ranking.memory_usage());
+	}
+
+	// The suggestions of every keystroke of a command line.
+	for (std::wstring line : { L"set gravity 9.81", L"spawn unit 3999999", L"unknown command" }) {
+		const int numRepeats = 1000;
+		std::wstring_view command;
+		size_t numFound = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int k = 0; k < numRepeats; k++) {
+			numFound = 0;
+			for (size_t len = 1; len <= line.length(); len++) {
+				numFound += ranking.suggest(std::wstring_view(line).substr(0, len), &command);
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		std::printf("%-20ls %2zu/%2zu keystrokes suggested  %6.1f ns/keystroke\n", line.c_str(), numFound, line.length(),
+			std::chrono::duration<double, std::nano>(end - start).count() / (numRepeats * line.length()));
+	}
+}
@@ -0,0 +1,73 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "..\debug_utils\HistoryJournal.h"
+#include "TempFile.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+static std::wstring command_line(size_t i)
+{
+	return L"spawn unit " + std::to_wstring(i) + std::wstring(10 + (i * 7) % 40, L'x');
+}
+
+// The journals are written directly (no compaction), to get files of any size.
+static void write_journal(const std::filesystem::path &path, size_t numRecords)
+{
+	std::filesystem::remove(path);
+
+	std::vector<std::wstring> records;
+	dbgutils::HistoryJournal journal(path, numRecords, &records);
+	for (size_t i = 0; i < numRecords; i++) {
+		journal.append(command_line(i));
+	}
+}
+
+TEST(BenchHistoryJournal, DISABLED_Load)
+{
+	TempFile file("dbgutils_bench_journal_load.bin");
+	const size_t capacity = 1000;
+
+	for (size_t numRecords : { 1000, 10000, 100000, 1000000 }) {
+		write_journal(file.path(), numRecords);
+
+		const int reps = 20;
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < reps; r++) {
+			std::vector<std::wstring> records;
+			dbgutils::HistoryJournal journal(file.path(), capacity, &records);
+			ASSERT_EQ(records.size(), capacity);
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		std::printf("load %zu of %8zu records (%9llu bytes)  %8.1f us\n",
+			capacity, numRecords, static_cast<unsigned long long>(std::filesystem::file_size(file.path())),
+			std::chrono::duration<double, std::micro>(end - start).count() / reps);
+	}
+}
+
+TEST(BenchHistoryJournal, DISABLED_Append)
+{
+	TempFile file("dbgutils_bench_journal_append.bin");
+
+	for (size_t capacity : { 100, 10000 }) {
+		std::filesystem::remove(file.path());
+		std::vector<std::wstring> records;
+		dbgutils::HistoryJournal journal(file.path(), capacity, &records);
+
+		const size_t numAppends = 100000;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < numAppends; i++) {
+			journal.append(command_line(i));
+		}
+		journal.wait_for_compaction();
+		auto end = std::chrono::steady_clock::now();
+
+		std::printf("capacity %6zu  append %6.2f us/record  file %9llu bytes\n",
+			capacity, std::chrono::duration<double, std::micro>(end - start).count() / numAppends,
+			static_cast<unsigned long long>(journal.file_size()));
+	}
+}
@@ -0,0 +1,65 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include "..\debug_utils\Interpreter.h"
+#include "CommandEcho.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+// A command that does nothing so that the benchmark only measures the dispatch.
+class CommandNop : public dbgutils::ICommand {
+public:
+	CommandNop(const std::wstring &name)
+		: dbgutils::ICommand(name)
+	{}
+
+	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		return L"";
+	}
+};
+
+TEST(BenchInterpreter, DISABLED_DispatchLatency)
+{
+	const size_t kIterations = 200000;
+
+	for (size_t n : { 10, 100, 1000, 10000, 100000 }) {
+		dbgutils::Interpreter interp;
+		for (size_t i = 0; i < n; i++) {
+			interp.InstallCommand(std::make_shared<CommandNop>(L"cmd" + std::to_wstring(i)));
+		}
+
+		// The echo command is installed last, which was the worst case
+		// for the former linear dispatch.
+		interp.InstallCommand(std::make_shared<CommandEcho>());
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < kIterations; i++) {
+			interp.execute(L"echo");
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		auto ns = std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+		std::printf("%7zu commands: %8.1f ns/dispatch\n", n, ns);
+	}
+}
+
+TEST(BenchInterpreter, DISABLED_ProfilerOverhead)
+{
+	const size_t kIterations = 1000000;
+
+	for (auto enabled : { false, true }) {
+		dbgutils::Interpreter interp({ std::make_shared<CommandNop>(L"nop") });
+		interp.profiler().set_enabled(enabled);
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < kIterations; i++) {
+			interp.execute(L"nop a b");
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		auto ns = std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+		std::printf("profiler %s: %8.1f ns/dispatch\n", enabled ? "on " : "off", ns);
+	}
+}
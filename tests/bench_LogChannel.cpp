@@ -0,0 +1,57 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "..\debug_utils\LogChannel.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+TEST(BenchLogChannel, DISABLED_SixteenProducers)
+{
+	const size_t kNumThreads = 16;
+	const size_t kNumMessages = 100000;
+
+	dbgutils::LogChannel channel(4096);
+	std::atomic<size_t> running{ kNumThreads };
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> producers;
+	for (size_t t = 0; t < kNumThreads; t++) {
+		producers.emplace_back([&channel, &running] {
+			for (size_t i = 0; i < kNumMessages; i++) {
+				channel.log(L"entity 1234 moved to sector 56");
+			}
+			running--;
+		});
+	}
+
+	// The consumer drains in batches, like the console does once per frame.
+	std::vector<dbgutils::LogMessage> batch;
+	size_t received = 0;
+	size_t numBatches = 0;
+	for (;;) {
+		auto finished = running.load() == 0;
+
+		batch.clear();
+		received += channel.drain(&batch);
+		numBatches++;
+
+		if (finished) {
+			break;
+		}
+	}
+
+	for (auto &p : producers) {
+		p.join();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto s = std::chrono::duration<double>(end - start).count();
+
+	std::printf("%zu producers: %6.2f Mmsg/s logged, %llu received, %llu dropped, %zu batches\n",
+		kNumThreads, kNumThreads * kNumMessages / s / 1e6,
+		(unsigned long long)received, (unsigned long long)channel.dropped(), numBatches);
+}
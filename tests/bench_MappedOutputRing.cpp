@@ -0,0 +1,57 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "..\debug_utils\MappedOutputRing.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+template <class Append>
+static void bench_append(const char *name, size_t length, Append append)
+{
+	const size_t kNumAppends = 1000000;
+	const std::wstring payload(length, L'x');
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < kNumAppends; i++) {
+		append(payload);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto ns = std::chrono::duration<double, std::nano>(end - start).count() / kNumAppends;
+
+	std::printf("%-20s %4zu chars  %6.1f ns/append\n", name, length, ns);
+}
+
+TEST(BenchMappedOutputRing, DISABLED_Append)
+{
+	const size_t kDataBytes = 1024 * 1024;
+	const size_t kNumSlots = 4096;
+
+	auto path = std::filesystem::temp_directory_path() / "dbgutils_bench_ring.bin";
+
+	for (size_t length : { 16, 256, 4096 }) {
+		// The floor: a memcpy into a ring of the same size.
+		std::vector<wchar_t> ring(kDataBytes / sizeof(wchar_t));
+		size_t pos = 0;
+		bench_append("memcpy", length, [&](const std::wstring &payload) {
+			if (pos + payload.length() > ring.size()) {
+				pos = 0;
+			}
+			std::memcpy(&ring[pos], payload.data(), payload.length() * sizeof(wchar_t));
+			pos += payload.length();
+		});
+
+		dbgutils::MappedOutputRing mapped(path, kDataBytes, kNumSlots);
+		bench_append("MappedOutputRing", length, [&](const std::wstring &payload) {
+			mapped.append(payload);
+		});
+	}
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,78 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "..\debug_utils\OutputStore.h"
+#include "..\debug_utils\OvwRingBuf.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+static const size_t kNumOutputs = 4096;
+static const size_t kNumPushes = 1000000;
+static const size_t kOutputLength = 64;
+
+// StringRing is the former output store: one string per output.
+class StringRing {
+public:
+	StringRing(size_t capacity) : m_buf(capacity) {}
+
+	void push(const std::wstring &text) { m_buf.emplace_back(text); }
+
+	// memory_usage counts the strings and the heap blocks of the long ones.
+	// The allocator headers are not counted.
+	size_t memory_usage() const
+	{
+		auto bytes = m_buf.capacity() * sizeof(std::wstring);
+		for (const auto &s : m_buf) {
+			if (s.capacity() > std::wstring().capacity()) {
+				bytes += (s.capacity() + 1) * sizeof(wchar_t);
+			}
+		}
+		return bytes;
+	}
+
+private:
+	dbgutils::OvwRingBuf<std::wstring>	m_buf;
+};
+
+// bench_push pushes outputs until the store is full many times over, and reports
+// the time per push and the memory per output once full.
+template <class Store, class Push>
+static void bench_push(const char *name, Store &store, Push push)
+{
+	const std::wstring payload(kOutputLength, L'x');
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < kNumPushes; i++) {
+		push(payload);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto ns = std::chrono::duration<double, std::nano>(end - start).count() / kNumPushes;
+
+	std::printf("%-24s %6.1f ns/push  %6.1f bytes/output\n", name, ns,
+		static_cast<double>(store.memory_usage()) / kNumOutputs);
+}
+
+TEST(BenchOutputStore, DISABLED_Push)
+{
+	{
+		StringRing ring(kNumOutputs);
+
+		bench_push("OvwRingBuf<wstring>", ring, [&ring](const std::wstring &payload) {
+			ring.push(payload);
+		});
+	}
+
+	{
+		dbgutils::OutputStore store(kNumOutputs * kOutputLength * sizeof(wchar_t), kNumOutputs);
+
+		bench_push("OutputStore", store, [&store](const std::wstring &payload) {
+			store.begin_write(store.push());
+			store.write(payload);
+			store.end_write();
+		});
+	}
+}
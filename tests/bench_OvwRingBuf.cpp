@@ -0,0 +1,145 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "..\debug_utils\OvwRingBuf.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+// An allocator counting the allocations of the payloads, so that the global allocation
+// functions of the test program are left alone.
+static size_t g_numAllocations = 0;
+
+template <class T>
+struct CountingAllocator {
+	using value_type = T;
+
+	CountingAllocator() = default;
+	template <class U>
+	CountingAllocator(const CountingAllocator<U> &) {}
+
+	T *allocate(size_t n)
+	{
+		g_numAllocations++;
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T *p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+	template <class U>
+	bool operator==(const CountingAllocator<U> &) const { return true; }
+	template <class U>
+	bool operator!=(const CountingAllocator<U> &) const { return false; }
+};
+
+using Payload = std::basic_string<wchar_t, std::char_traits<wchar_t>, CountingAllocator<wchar_t>>;
+
+// bench_push pushes wstring payloads into a buffer, from empty to many times full,
+// and reports the allocations and time per push, payload construction included.
+// One allocation per push means the buffer itself does not allocate.
+template <class Push>
+static void bench_push(const char *name, Push push)
+{
+	const size_t kCapacity = 1024;
+	const size_t kNumPushes = 1000000;
+	const Payload kPayload(64, L'x');
+
+	dbgutils::OvwRingBuf<Payload> buf(kCapacity);
+
+	auto allocsBefore = g_numAllocations;
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < kNumPushes; i++) {
+		push(buf, kPayload);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto allocs = g_numAllocations - allocsBefore;
+	auto ns = std::chrono::duration<double, std::nano>(end - start).count() / kNumPushes;
+
+	std::printf("%-28s %6.3f allocations/push  %6.1f ns/push\n", name, double(allocs) / kNumPushes, ns);
+}
+
+TEST(BenchOvwRingBuf, DISABLED_WStringPayloads)
+{
+	// The payload is built by the caller for every push, as a command output would be.
+	// Copying allocates a second string; moving hands over the caller's buffer.
+	bench_push("push_back(const T &)", [](auto &buf, const Payload &payload) {
+		Payload s(payload);
+		buf.push_back(s);
+	});
+
+	bench_push("push_back(T &&)", [](auto &buf, const Payload &payload) {
+		Payload s(payload);
+		buf.push_back(std::move(s));
+	});
+
+	// The string is constructed directly in the slot.
+	bench_push("emplace_back(args...)", [](auto &buf, const Payload &payload) {
+		buf.emplace_back(payload);
+	});
+}
+
+// bench_walk sums all the items of a full buffer many times, the way a renderer
+// walks the console output every frame.
+template <class Buf, class Walk>
+static void bench_walk(const char *name, Walk walk)
+{
+	const size_t kCapacity = 4096;
+	const size_t kNumWalks = 2000;
+
+	Buf buf(kCapacity);
+	for (size_t i = 0; i < kCapacity + kCapacity / 2; i++) {
+		buf.push_back(static_cast<int>(i));
+	}
+
+	long long sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < kNumWalks; i++) {
+		sum += walk(buf);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	auto ns = std::chrono::duration<double, std::nano>(end - start).count() / (kNumWalks * kCapacity);
+
+	std::printf("%-28s %6.2f ns/item  (checksum %lld)\n", name, ns, sum);
+}
+
+TEST(BenchOvwRingBuf, DISABLED_Walk)
+{
+	auto peekLoop = [](const auto &buf) {
+		long long sum = 0;
+		for (size_t i = 0; i < buf.size(); i++) {
+			sum += buf.peek(i);
+		}
+		return sum;
+	};
+
+	auto iterators = [](const auto &buf) {
+		long long sum = 0;
+		for (auto x : buf) {
+			sum += x;
+		}
+		return sum;
+	};
+
+	auto spans = [](const auto &buf) {
+		long long sum = 0;
+		auto parts = buf.spans();
+		for (auto x : parts.first) {
+			sum += x;
+		}
+		for (auto x : parts.second) {
+			sum += x;
+		}
+		return sum;
+	};
+
+	bench_walk<dbgutils::OvwRingBuf<int>>("peek", peekLoop);
+	bench_walk<dbgutils::Pow2OvwRingBuf<int>>("peek (power of two)", peekLoop);
+	bench_walk<dbgutils::Pow2OvwRingBuf<int>>("iterators (power of two)", iterators);
+	bench_walk<dbgutils::OvwRingBuf<int>>("spans", spans);
+}
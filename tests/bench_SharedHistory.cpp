@@ -0,0 +1,78 @@
+#include "pch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "..\debug_utils\SharedHistory.h"
+#include "TempFile.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+TEST(BenchSharedHistory, DISABLED_Merge)
+{
+	const size_t capacity = 1000;
+	const size_t numPolls = 1000;
+
+	TempFile file("dbgutils_bench_shared.bin");
+	std::vector<std::wstring> records;
+	dbgutils::SharedHistory writer(file.path(), capacity, &records);
+	dbgutils::SharedHistory reader(file.path(), capacity, &records);
+
+	size_t numRecords = 0;
+	for (size_t fileRecords : { 10000, 100000, 1000000 }) {
+		auto start = std::chrono::steady_clock::now();
+		for (; numRecords < fileRecords; numRecords++) {
+			writer.append(L"spawn unit " + std::to_wstring(numRecords) + L" at player");
+		}
+		auto end = std::chrono::steady_clock::now();
+		auto appendNs = std::chrono::duration<double, std::nano>(end - start).count() / fileRecords;
+		reader.poll(&records);
+		records = std::vector<std::wstring>();
+
+		// A poll without new records, then with one.
+		start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < numPolls; i++) {
+			reader.poll(&records);
+		}
+		end = std::chrono::steady_clock::now();
+		auto idleNs = std::chrono::duration<double, std::nano>(end - start).count() / numPolls;
+
+		double mergeUs = 0;
+		auto bytesRead = reader.bytes_read();
+		for (size_t i = 0; i < numPolls; i++, numRecords++) {
+			writer.append(L"spawn unit " + std::to_wstring(numRecords) + L" at player");
+
+			start = std::chrono::steady_clock::now();
+			reader.poll(&records);
+			end = std::chrono::steady_clock::now();
+			mergeUs += std::chrono::duration<double, std::micro>(end - start).count();
+			ASSERT_EQ(records.size(), 1);
+		}
+		bytesRead = reader.bytes_read() - bytesRead;
+
+		// Opening the file, which reads the latest records, and reading the whole file again.
+		// The fastest of a few opens is kept: the first one after the appends also waits for
+		// the file system. The loaded records are freed out of the timings.
+		double openUs = 0;
+		for (int k = 0; k < 5; k++) {
+			std::vector<std::wstring> loaded;
+			start = std::chrono::steady_clock::now();
+			dbgutils::SharedHistory opened(file.path(), capacity, &loaded);
+			end = std::chrono::steady_clock::now();
+			auto us = std::chrono::duration<double, std::micro>(end - start).count();
+			openUs = k == 0 ? us : std::min(openUs, us);
+		}
+
+		std::vector<std::wstring> all;
+		start = std::chrono::steady_clock::now();
+		dbgutils::SharedHistory reread(file.path(), numRecords, &all);
+		end = std::chrono::steady_clock::now();
+		auto rereadUs = std::chrono::duration<double, std::micro>(end - start).count();
+
+		std::printf("%8zu records  append %6.0f ns  idle poll %5.1f ns  poll of 1 record %6.2f us (%4.0f bytes)  open %7.0f us  whole file %9.0f us\n",
+			numRecords, appendNs, idleNs, mergeUs / numPolls, static_cast<double>(bytesRead) / numPolls, openUs, rereadUs);
+	}
+}
@@ -0,0 +1,103 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include "..\debug_utils\SpscOvwRingBuf.h"
+#include "..\debug_utils\CommandProfiler.h"// LatencyHistogram
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+// The mutex-wrapped OvwRingBuf that SpscOvwRingBuf replaces.
+template <class T>
+class MutexOvwRingBuf {
+public:
+	MutexOvwRingBuf(size_t capacity)
+		: m_buf(capacity)
+	{}
+
+	uint64_t dropped() const { return m_dropped; }
+
+	bool push_back(const T &item)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_buf.full()) {
+			m_dropped++;
+		}
+		m_buf.push_back(item);
+		return true;
+	}
+
+	bool pop_front(T *item)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_buf.empty()) {
+			return false;
+		}
+		*item = m_buf.pop_front();
+		return true;
+	}
+
+private:
+	std::mutex					m_mutex;
+	dbgutils::OvwRingBuf<T>		m_buf;
+	uint64_t					m_dropped{ 0 };
+};
+
+// run_two_threads sends timestamps from a producer thread to a consumer thread.
+// The consumer records the latency of each item it receives.
+template <class Buf>
+static void run_two_threads(const char *name, Buf &buf)
+{
+	const uint64_t kNumItems = 2000000;
+
+	dbgutils::LatencyHistogram latency;
+	std::atomic<bool> done{ false };
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::thread producer([&] {
+		for (uint64_t i = 0; i < kNumItems; i++) {
+			buf.push_back(dbgutils::CommandProfiler::steady_clock_ns());
+		}
+		done.store(true);
+	});
+
+	uint64_t received = 0;
+	for (;;) {
+		auto finished = done.load();
+
+		uint64_t sent;
+		while (buf.pop_front(&sent)) {
+			latency.record(dbgutils::CommandProfiler::steady_clock_ns() - sent);
+			received++;
+		}
+
+		if (finished) {
+			break;
+		}
+	}
+	producer.join();
+
+	auto end = std::chrono::steady_clock::now();
+	auto s = std::chrono::duration<double>(end - start).count();
+
+	std::printf("%-8s %6.1f Mitems/s  received %8llu  dropped %8llu  p50 %8.1f us  p99 %8.1f us\n",
+		name, kNumItems / s / 1e6,
+		(unsigned long long)received, (unsigned long long)buf.dropped(),
+		latency.percentile(0.5) / 1000., latency.percentile(0.99) / 1000.);
+}
+
+TEST(BenchSpscOvwRingBuf, DISABLED_TwoThreads)
+{
+	for (size_t capacity : { 64, 4096 }) {
+		std::printf("capacity %zu\n", capacity);
+
+		MutexOvwRingBuf<uint64_t> mutexBuf(capacity);
+		run_two_threads("mutex", mutexBuf);
+
+		dbgutils::SpscOvwRingBuf<uint64_t> spscBuf(capacity);
+		run_two_threads("spsc", spscBuf);
+	}
+}
@@ -0,0 +1,76 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+#include "..\debug_utils\EditBox.h"
+#include "..\debug_utils\SpaceMask.h"
+
+// The benchmarks are disabled by default.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=Bench*
+
+static std::wstring make_command_line(size_t length)
+{
+	// Entity ids separated by spaces, as in a long pasted command line.
+	std::wstring s;
+	for (size_t i = 0; s.length() < length; i++) {
+		s += std::to_wstring(1000000 + i * 7919) + L' ';
+	}
+	s.resize(length);
+
+	return s;
+}
+
+static std::wstring make_script_line(size_t length)
+{
+	// Calls with punctuation between the words, which split the runs of non-spaces.
+	std::wstring s;
+	for (size_t i = 0; s.length() < length; i++) {
+		s += L"unit[" + std::to_wstring(i) + L"].pos=(" + std::to_wstring(i * 7) + L",0.5); ";
+	}
+	s.resize(length);
+
+	return s;
+}
+
+template <class F>
+static double ns_per_char(size_t length, size_t repeat, F f)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < repeat; i++) {
+		f();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / (repeat * length);
+}
+
+TEST(BenchStringRanges, DISABLED_SpaceMask)
+{
+	const size_t kLength = 100 * 1024;
+	const size_t kRepeat = 1000;
+	const char *names[] = { "scalar", "SSE2", "AVX2" };
+
+	auto s = make_command_line(kLength);
+	std::vector<uint64_t> mask((kLength + 63) / 64);
+
+	for (int level = dbgutils::SIMD_LEVEL_SCALAR; level <= dbgutils::simd_level(); level++) {
+		auto ns = ns_per_char(kLength, kRepeat, [&]() {
+			dbgutils::ComputeSpaceMask(static_cast<dbgutils::SIMD_LEVEL>(level), s.data(), s.length(), mask.data());
+		});
+		std::printf("ComputeSpaceMask (%-6s)  %6.3f ns/char\n", names[level], ns);
+	}
+
+	// The words of the script line are split at the punctuation, past the reserved ranges.
+	const std::pair<const char *, std::wstring> lines[] = { { "ids", s }, { "script", make_script_line(kLength) } };
+	for (const auto &line : lines) {
+		size_t numRanges = 0;
+		auto ns = ns_per_char(kLength, kRepeat / 10, [&]() {
+			numRanges += dbgutils::ComputeStringRanges(line.second).size();
+		});
+		std::printf("ComputeStringRanges (%-6s) %6.3f ns/char  (%zu ranges)\n", line.first, ns, numRanges / (kRepeat / 10));
+	}
+}
@@ -1,5 +1,8 @@
 #include "pch.h"
 #include "../debug_utils/EditBox.h"
+#include "../debug_utils/SpaceMask.h"
+#include "../debug_utils/string_utils.h"
+#include "../debug_utils/CharClass.h"
 
 TEST(StringRanges, EmptyString)
 {
@@ -70,4 +73,202 @@ TEST(StringRanges, String1)
 	};
 
 	EXPECT_EQ(got, expected);
-}
\ No newline at end of file
+}
+
+TEST(StringRanges, PunctuationAndIdeographsSplitTheWords)
+{
+	using StrRange = dbgutils::StringRange;
+
+	auto s = L"a.b_1 \u4e00\u4e8c x";
+
+	auto got = dbgutils::ComputeStringRanges(s);
+
+	std::vector<StrRange> expected = {
+		StrRange::MakeWordRange(0, 1),
+		StrRange::MakeWordRange(1, 1),
+		StrRange::MakeWordRange(2, 3),
+		StrRange::MakeSpaceRange(5, 1),
+		StrRange::MakeWordRange(6, 1),
+		StrRange::MakeWordRange(7, 1),
+		StrRange::MakeSpaceRange(8, 1),
+		StrRange::MakeWordRange(9, 1)
+	};
+
+	EXPECT_EQ(got, expected);
+}
+
+// expect_index_matches checks the index of a text against ComputeStringRanges.
+static void expect_index_matches(const dbgutils::StringRangeIndex &index, const dbgutils::GapBuffer &text)
+{
+	std::wstring s;
+	text.copy_to(&s);
+
+	auto expected = dbgutils::ComputeStringRanges(s);
+
+	ASSERT_EQ(index.size(), expected.size()) << "text: \"" << std::string(s.begin(), s.end()) << "\"";
+	for (size_t i = 0; i < expected.size(); i++) {
+		EXPECT_EQ(index[i], expected[i]) << "range " << i;
+	}
+}
+
+TEST(StringRangeIndex, Reset)
+{
+	dbgutils::GapBuffer text(L"ab  cd e");
+	dbgutils::StringRangeIndex index(text);
+
+	expect_index_matches(index, text);
+}
+
+TEST(StringRangeIndex, Find)
+{
+	dbgutils::GapBuffer text(L"ab  cd");
+	dbgutils::StringRangeIndex index(text);
+
+	EXPECT_EQ(index.find(0), 0);
+	EXPECT_EQ(index.find(1), 0);
+	EXPECT_EQ(index.find(2), 1);
+	EXPECT_EQ(index.find(5), 2);
+	EXPECT_EQ(index.find(6), 3);// end of the text
+}
+
+TEST(StringRangeIndex, InsertMergesAndSplitsRanges)
+{
+	dbgutils::GapBuffer text(L"ab cd");
+	dbgutils::StringRangeIndex index(text);
+
+	// Replace the space by a letter: the words merge.
+	text.erase(2, 1);
+	index.update(text, 2, 1, 0);
+	text.insert(2, L'x');
+	index.update(text, 2, 0, 1);
+	expect_index_matches(index, text);
+
+	// Insert a space in the word: it splits.
+	text.insert(1, L' ');
+	index.update(text, 1, 0, 1);
+	expect_index_matches(index, text);
+}
+
+TEST(StringRangeIndex, MatchesComputeStringRangesUnderRandomEdits)
+{
+	dbgutils::GapBuffer text(L"echo hello   world");
+	dbgutils::StringRangeIndex index(text);
+
+	unsigned seed = 777;
+	auto next = [&seed](size_t n) {
+		seed = seed * 1103515245u + 12345u;
+		return n == 0 ? 0 : (seed >> 8) % n;
+	};
+
+	const wchar_t alphabet[] = L"ab \t.\u4e00";
+	for (int i = 0; i < 3000; i++) {
+		auto pos = next(text.length() + 1);
+		if (next(3) != 0 || text.empty()) {
+			std::wstring s;
+			for (size_t k = 1 + next(3); k > 0; k--) {
+				s += alphabet[next(6)];
+			}
+			text.insert(pos, s);
+			index.update(text, pos, 0, s.length());
+		}
+		else {
+			pos = std::min(pos, text.length() - 1);
+			auto count = std::min<size_t>(1 + next(4), text.length() - pos);
+			text.erase(pos, count);
+			index.update(text, pos, count, 0);
+		}
+
+		expect_index_matches(index, text);
+		if (HasFailure()) {
+			return;
+		}
+	}
+}
+
+// reference_string_ranges is the former implementation of ComputeStringRanges:
+// a state machine looking at each character and the previous one.
+// It splits the words at the word breaks like the current one.
+static std::vector<dbgutils::StringRange> reference_string_ranges(const std::wstring &s)
+{
+	std::vector<dbgutils::StringRange> ranges;
+	if (s.empty()) {
+		return ranges;
+	}
+
+	size_t begin = 0;
+	for (size_t i = 1; i <= s.length(); i++) {
+		auto prevSpace = wstr_is_space(s[i - 1]);
+		if (i < s.length() && !dbgutils::is_word_break(s[i - 1], s[i])) {
+			continue;
+		}
+
+		ranges.push_back(prevSpace
+			? dbgutils::StringRange::MakeSpaceRange(begin, i - begin)
+			: dbgutils::StringRange::MakeWordRange(begin, i - begin));
+		begin = i;
+	}
+
+	return ranges;
+}
+
+// random_text returns a text mixing words, ASCII and non-ASCII spaces, characters
+// whose low bits look like spaces, punctuation and ideographs.
+static std::wstring random_text(size_t length, unsigned seed)
+{
+	const wchar_t alphabet[] = { L'a', L' ', L'\t', L'\n', L'\r', L'\v', L'\f', 0x0109, 0x2020, 0xff20, 0x0008, 0x000e, 0x00a0, 0x3000, 0x2028, L'x', L'y', L'.', L'_', 0x4e00 };
+	const size_t n = sizeof(alphabet) / sizeof(alphabet[0]);
+
+	std::wstring s;
+	for (size_t i = 0; i < length; i++) {
+		seed = seed * 1103515245u + 12345u;
+		// Make runs of various lengths.
+		auto c = alphabet[(seed >> 8) % n];
+		auto run = 1 + (seed >> 20) % 9;
+		for (size_t k = 0; k < run && s.length() < length; k++) {
+			s += c;
+		}
+	}
+	s.resize(length);
+
+	return s;
+}
+
+TEST(StringRanges, MatchesTheReferenceImplementation)
+{
+	for (size_t length = 0; length < 300; length++) {
+		auto s = random_text(length, static_cast<unsigned>(length));
+
+		ASSERT_EQ(dbgutils::ComputeStringRanges(s), reference_string_ranges(s)) << "length " << length;
+	}
+}
+
+TEST(StringRanges, LongRunsAcrossMaskWords)
+{
+	auto s = std::wstring(100, L'a') + std::wstring(64, L' ') + std::wstring(63, L'b') + L" ";
+
+	EXPECT_EQ(dbgutils::ComputeStringRanges(s), reference_string_ranges(s));
+}
+
+TEST(SpaceMask, AllKernelsClassifyEveryCharacterLikeTheScalarTest)
+{
+	// Every 16-bit character, shifted by an offset to exercise the tails.
+	std::wstring s;
+	for (uint32_t c = 0; c < 0x10000; c++) {
+		s += static_cast<wchar_t>(c);
+	}
+
+	for (int level = dbgutils::SIMD_LEVEL_SCALAR; level <= dbgutils::simd_level(); level++) {
+		for (size_t offset : { 0, 1, 37 }) {
+			auto n = s.length() - offset;
+			std::vector<uint64_t> mask((n + 63) / 64, ~uint64_t(0));
+
+			dbgutils::ComputeSpaceMask(static_cast<dbgutils::SIMD_LEVEL>(level), s.data() + offset, n, mask.data());
+
+			for (size_t i = 0; i < mask.size() * 64; i++) {
+				auto bit = (mask[i / 64] >> (i % 64)) & 1;
+				auto expected = i < n && wstr_is_space(s[offset + i]);
+				ASSERT_EQ(bit != 0, expected) << "level " << level << ", character " << std::hex << (i + offset);
+			}
+		}
+	}
+}
@@ -0,0 +1,86 @@
+#include "pch.h"
+#include <string>
+#include <vector>
+#include "..\debug_utils\CharClass.h"
+#include "..\debug_utils\string_utils.h"
+
+using dbgutils::char_class;
+
+TEST(CharClass, WhiteSpaceOfTheWholeBmp)
+{
+	// The characters with the White_Space property (PropList.txt).
+	auto isWhiteSpace = [](uint32_t c) {
+		return (c >= 0x09 && c <= 0x0d) || c == 0x20 || c == 0x85 || c == 0xa0 || c == 0x1680
+			|| (c >= 0x2000 && c <= 0x200a) || c == 0x2028 || c == 0x2029 || c == 0x202f
+			|| c == 0x205f || c == 0x3000;
+	};
+
+	for (uint32_t c = 0; c <= 0xffff; c++) {
+		ASSERT_EQ(dbgutils::is_white_space(static_cast<wchar_t>(c)), isWhiteSpace(c)) << "U+" << std::hex << c;
+	}
+}
+
+TEST(CharClass, Classes)
+{
+	EXPECT_EQ(char_class(L'A'), dbgutils::CHAR_CLASS_LETTER);
+	EXPECT_EQ(char_class(L'z'), dbgutils::CHAR_CLASS_LETTER);
+	EXPECT_EQ(char_class(0x00e9), dbgutils::CHAR_CLASS_LETTER);		// e acute
+	EXPECT_EQ(char_class(0x0416), dbgutils::CHAR_CLASS_LETTER);		// Cyrillic Zhe
+	EXPECT_EQ(char_class(L'0'), dbgutils::CHAR_CLASS_DIGIT);
+	EXPECT_EQ(char_class(0x0661), dbgutils::CHAR_CLASS_DIGIT);		// Arabic-Indic one
+	EXPECT_EQ(char_class(L'_'), dbgutils::CHAR_CLASS_CONNECTOR);
+	EXPECT_EQ(char_class(L','), dbgutils::CHAR_CLASS_PUNCT);
+	EXPECT_EQ(char_class(L'+'), dbgutils::CHAR_CLASS_PUNCT);
+	EXPECT_EQ(char_class(0x4e00), dbgutils::CHAR_CLASS_IDEOGRAPH);
+	EXPECT_EQ(char_class(0x3042), dbgutils::CHAR_CLASS_IDEOGRAPH);	// Hiragana a
+	EXPECT_EQ(char_class(0x3000), dbgutils::CHAR_CLASS_SPACE);
+	EXPECT_EQ(char_class(0x00a0), dbgutils::CHAR_CLASS_SPACE);
+	EXPECT_EQ(char_class(0x0000), dbgutils::CHAR_CLASS_OTHER);
+	EXPECT_EQ(char_class(0x200b), dbgutils::CHAR_CLASS_OTHER);		// zero width space
+}
+
+TEST(CharClass, WordBreaks)
+{
+	using dbgutils::is_word_break;
+
+	EXPECT_FALSE(is_word_break(L'a', L'b'));
+	EXPECT_FALSE(is_word_break(L'a', L'1'));
+	EXPECT_FALSE(is_word_break(L'_', L'a'));
+	EXPECT_FALSE(is_word_break(L'a', 0x200d));				// zero width joiner
+	EXPECT_FALSE(is_word_break(L'.', L','));
+	EXPECT_FALSE(is_word_break(L' ', 0x3000));
+
+	EXPECT_TRUE(is_word_break(L'a', L' '));
+	EXPECT_TRUE(is_word_break(L'a', L'.'));
+	EXPECT_TRUE(is_word_break(L'.', L'a'));
+	EXPECT_TRUE(is_word_break(0x4e00, 0x4e8c));
+	EXPECT_TRUE(is_word_break(L'a', 0x4e00));
+	EXPECT_TRUE(is_word_break(0x4e00, L'.'));
+}
+
+TEST(CharClass, TrimNonAsciiSpaces)
+{
+	std::wstring s = L" \u3000\u00a0abc def\u2003 \u00a0";
+
+	wstr_trim(s);
+
+	EXPECT_EQ(s, L"abc def");
+}
+
+TEST(CharClass, SplitOnIdeographicSpace)
+{
+	auto got = wstr_split(L"\u3000spawn\u3000unit 42\u00a0");
+	auto expected = std::vector<std::wstring>{ L"spawn", L"unit", L"42" };
+
+	EXPECT_EQ(got, expected);
+}
+
+TEST(CharClass, TrimKeepsCharactersWithSpaceLowBits)
+{
+	// The low byte of U+0120 and U+0D09 are a space and a tab.
+	std::wstring s = L"\u0120x\u0d09";
+
+	wstr_trim(s);
+
+	EXPECT_EQ(s, L"\u0120x\u0d09");
+}
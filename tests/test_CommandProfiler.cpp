@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "..\debug_utils\CommandProfiler.h"
+#include "..\debug_utils\Interpreter.h"
+#include "CommandEcho.h"
+
+TEST(LatencyHistogram, Empty)
+{
+	dbgutils::LatencyHistogram h;
+
+	EXPECT_EQ(h.count(), 0);
+	EXPECT_EQ(h.percentile(0.5), 0);
+	EXPECT_EQ(h.max(), 0);
+}
+
+TEST(LatencyHistogram, BucketsCoverAllDurations)
+{
+	using H = dbgutils::LatencyHistogram;
+
+	for (uint64_t ns : { 0ull, 1ull, 3ull, 4ull, 7ull, 8ull, 1000ull, 123456789ull, ~0ull }) {
+		auto i = H::bucket_index(ns);
+		ASSERT_LT(i, H::kNumBuckets);
+
+		// The duration is in the bucket...
+		EXPECT_LE(ns, H::bucket_upper_bound(i));
+		// ...and not in the previous one.
+		if (i > 0) {
+			EXPECT_GT(ns, H::bucket_upper_bound(i - 1));
+		}
+	}
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+	dbgutils::LatencyHistogram h;
+
+	for (uint64_t ns = 1; ns <= 1000; ns++) {
+		h.record(ns * 1000);
+	}
+
+	EXPECT_EQ(h.count(), 1000);
+	EXPECT_EQ(h.max(), 1000000);
+
+	// The relative error is bounded by the number of sub-buckets.
+	auto p50 = h.percentile(0.5);
+	EXPECT_GE(p50, 500000);
+	EXPECT_LE(p50, 500000 + 500000 / dbgutils::LatencyHistogram::kSubBuckets);
+
+	auto p99 = h.percentile(0.99);
+	EXPECT_GE(p99, 990000);
+	EXPECT_LE(p99, 1000000);
+}
+
+TEST(CommandProfiler, InterpreterRecordsExecutions)
+{
+	auto echo = std::make_shared<CommandEcho>();
+	dbgutils::Interpreter interp({ echo });
+
+	interp.execute(L"echo a");
+	interp.execute(L"echo b");
+	interp.execute(L"unknown");
+
+	const auto *stats = interp.profiler().find_stats(*echo);
+	ASSERT_NE(stats, nullptr);
+	EXPECT_EQ(stats->exec.count(), 2);
+}
+
+TEST(CommandProfiler, Disabled)
+{
+	auto echo = std::make_shared<CommandEcho>();
+	dbgutils::Interpreter interp({ echo });
+	interp.profiler().set_enabled(false);
+
+	interp.execute(L"echo a");
+
+	EXPECT_EQ(interp.profiler().find_stats(*echo), nullptr);
+}
+
+TEST(CommandProfiler, Report)
+{
+	dbgutils::Interpreter interp({ std::make_shared<CommandEcho>() });
+	interp.execute(L"echo a");
+
+	dbgutils::ChunkedText out;
+	interp.profiler().report(out);
+
+	auto str = out.str();
+	EXPECT_NE(str.find(L"p99"), std::wstring::npos);
+	EXPECT_NE(str.find(L"echo"), std::wstring::npos);
+}
+
+// A command clearing the profiler while it is being profiled, like the demo's "stats clear".
+class CommandClearStats : public dbgutils::ICommand {
+public:
+	CommandClearStats(dbgutils::Interpreter *interp)
+		: dbgutils::ICommand(L"clear")
+		, m_interp(interp)
+	{}
+
+	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		m_interp->profiler().clear();
+		return L"";
+	}
+
+private:
+	dbgutils::Interpreter *m_interp;
+};
+
+TEST(CommandProfiler, CommandClearsTheProfiler)
+{
+	auto echo = std::make_shared<CommandEcho>();
+	dbgutils::Interpreter interp({ echo });
+	auto clear = std::make_shared<CommandClearStats>(&interp);
+	interp.InstallCommand(clear);
+
+	interp.execute(L"echo a");
+	interp.execute(L"clear");
+
+	// The statistics were reset, then the execution of the clear command was recorded.
+	const auto *echoStats = interp.profiler().find_stats(*echo);
+	ASSERT_NE(echoStats, nullptr);
+	EXPECT_EQ(echoStats->exec.count(), 0);
+	EXPECT_EQ(echoStats->exec.max(), 0);
+
+	const auto *clearStats = interp.profiler().find_stats(*clear);
+	ASSERT_NE(clearStats, nullptr);
+	EXPECT_EQ(clearStats->exec.count(), 1);
+
+	// The report lists the commands executed since.
+	dbgutils::ChunkedText out;
+	interp.profiler().report(out);
+	EXPECT_EQ(out.str().find(L"echo"), std::wstring::npos);
+	EXPECT_NE(out.str().find(L"clear"), std::wstring::npos);
+}
@@ -1,6 +1,10 @@
 #include "pch.h"
 #include "..\debug_utils\Console.h"
 #include "CommandEcho.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 TEST(Console, OneChar)
 {
@@ -94,6 +98,26 @@ TEST(Console, CharEnterCharUpDown)
 	EXPECT_EQ(got, expected);
 }
 
+TEST(Console, CtrlZUndoesTheEditOfTheCurrentCommandLine)
+{
+	dbgutils::Console cons;
+
+	cons.handle_character('a');
+	cons.handle_key(VK_RETURN);
+	cons.handle_key(VK_UP);// a
+	cons.handle_character('b');// ab
+
+	EXPECT_TRUE(cons.handle_key('Z', ModKeyState{ true, false }));
+	EXPECT_EQ(cons.cmdline(), L"a");
+
+	// The entry from the history is not an edit.
+	EXPECT_FALSE(cons.handle_key('Z', ModKeyState{ true, false }));
+	EXPECT_EQ(cons.cmdline(), L"a");
+
+	EXPECT_TRUE(cons.handle_key('Y', ModKeyState{ true, false }));
+	EXPECT_EQ(cons.cmdline(), L"ab");
+}
+
 //										UTILITY FUNCTIONS
 //
 
@@ -138,4 +162,512 @@ TEST(Console, GetSpecificOutput)
 	EXPECT_EQ(cons.get_output(0), L"latest");
 	EXPECT_EQ(cons.get_output(1), L"middle");
 	EXPECT_EQ(cons.get_output(2), L"oldest");
-}
\ No newline at end of file
+}
+
+// A command writing its output in many chunks.
+class CommandCount : public dbgutils::ICommand {
+public:
+	CommandCount()
+		: dbgutils::ICommand(L"count")
+	{}
+
+	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		return output_of(args);
+	}
+
+	void execute(const dbgutils::CmdArgViews &args, dbgutils::IOutputSink &out) override
+	{
+		for (int i = 0; i < 5000; i++) {
+			out.write(std::to_wstring(i % 10));
+		}
+	}
+};
+
+TEST(Console, RecalledEntriesAreEditedSeparately)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, std::vector<std::wstring>{ L"echo a", L"echo b" });
+
+	cons.handle_character(L'x');// new command line
+	cons.handle_key(VK_UP);// echo b
+	EXPECT_EQ(cons.cmdline(), L"echo b");
+	EXPECT_EQ(cons.caret(), 6);
+
+	cons.handle_key(VK_UP);// echo a
+	cons.handle_character(L'2');
+	EXPECT_EQ(cons.cmdline(), L"echo a2");
+
+	// The edits are kept while going up and down.
+	cons.handle_key(VK_DOWN);
+	EXPECT_EQ(cons.cmdline(), L"echo b");
+	cons.handle_key(VK_DOWN);
+	EXPECT_EQ(cons.cmdline(), L"x");
+	EXPECT_FALSE(cons.handle_key(VK_DOWN));
+	cons.handle_key(VK_UP);
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo a2");
+	EXPECT_FALSE(cons.handle_key(VK_UP));
+
+	cons.handle_key(VK_RETURN);
+	EXPECT_EQ(cons.get_output(0), L"a2");
+	EXPECT_EQ(cons.cmdline(), L"");
+}
+
+TEST(Console, KeysWhichDoNotEditARecalledEntryDoNotCopyIt)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, std::vector<std::wstring>{ L"echo a" });
+
+	// The command line of a recalled entry is a view of the history until it is edited.
+	cons.handle_key(VK_UP);
+	const auto *entry = cons.cmdline().data();
+
+	auto ctrl = ModKeyState{ true, false };
+	EXPECT_FALSE(cons.handle_key(VK_SHIFT));
+	EXPECT_FALSE(cons.handle_key(VK_CONTROL, ctrl));
+	EXPECT_FALSE(cons.handle_key('Z', ctrl));
+	EXPECT_FALSE(cons.handle_key('Y', ctrl));
+	EXPECT_FALSE(cons.handle_key(VK_END));
+	EXPECT_FALSE(cons.handle_key(VK_RIGHT));
+	EXPECT_EQ(cons.cmdline().data(), entry);
+
+	// Moving the caret does.
+	EXPECT_TRUE(cons.handle_key(VK_LEFT));
+	EXPECT_NE(cons.cmdline().data(), entry);
+	EXPECT_EQ(cons.cmdline(), L"echo a");
+	EXPECT_EQ(cons.caret(), 5);
+}
+
+TEST(Console, ExecuteARecalledEntryWithoutEditingIt)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, std::vector<std::wstring>{ L"echo a", L"echo b" });
+
+	cons.handle_key(VK_UP);
+	cons.handle_key(VK_UP);
+	EXPECT_TRUE(cons.handle_key(VK_RETURN));
+
+	EXPECT_EQ(cons.last_cmdline(), L"echo a");
+	EXPECT_EQ(cons.get_output(0), L"a");
+
+	// It became the latest entry.
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo a");
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo b");
+}
+
+TEST(Console, InsertTextJoinsTheLines)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+
+	EXPECT_TRUE(cons.insert_text(L"echo a\nb"));
+
+	EXPECT_EQ(cons.cmdline(), L"echo a b");
+	EXPECT_EQ(cons.caret(), 8);
+	EXPECT_EQ(cons.output_size(), 0);
+}
+
+TEST(Console, InsertTextSubmitsTheLines)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	cons.handle_character(L'e');
+
+	EXPECT_TRUE(cons.insert_text(L"cho a\r\necho b\n\necho c", dbgutils::LINE_BREAK_MODE_SUBMIT));
+
+	// The empty line is not executed; the last line stays in the command line.
+	ASSERT_EQ(cons.output_size(), 2);
+	EXPECT_EQ(cons.get_output(0), L"b");
+	EXPECT_EQ(cons.get_output(1), L"a");
+	EXPECT_EQ(cons.cmdline(), L"echo c");
+}
+
+TEST(Console, StreamedOutput)
+{
+	dbgutils::Console cons(dbgutils::Interpreter({ std::make_shared<CommandCount>() }));
+
+	console_write_string_and_execute(cons, L"count");
+
+	auto output = cons.get_output_view(0);
+	EXPECT_EQ(output.length(), 5000);
+
+	auto str = cons.get_output(0);
+	EXPECT_EQ(str.substr(0, 12), L"012345678901");
+}
+
+TEST(Console, OutputOverwrittenWhenFull)
+{
+	dbgutils::Console cons(make_testing_interpreter(), 32, 2);
+
+	console_execute_commands(cons, { L"echo a", L"echo b", L"echo c" });
+
+	EXPECT_EQ(cons.output_size(), 2);
+	EXPECT_EQ(cons.get_output_view(0), L"c");
+	EXPECT_EQ(cons.get_output_view(1), L"b");
+}
+
+TEST(Console, OutputEvictedWhenOverBudget)
+{
+	// Room for 8000 characters: each output of 5000 characters evicts the previous one.
+	dbgutils::Console cons(
+		dbgutils::Interpreter({ std::make_shared<CommandCount>() }), 32, 32, 8000 * sizeof(wchar_t));
+
+	console_execute_commands(cons, { L"count", L"count", L"count" });
+
+	EXPECT_EQ(cons.output_size(), 1);
+	EXPECT_EQ(cons.get_output_view(0).length(), 5000);
+}
+
+// A fake slow command executed asynchronously.
+// It blocks until the test releases it, then outputs its arguments.
+class CommandSlow : public dbgutils::ICommand {
+public:
+	CommandSlow()
+		: dbgutils::ICommand(L"slow")
+	{}
+
+	bool is_async() const override { return true; }
+
+	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		return output_of(args);
+	}
+
+	void execute(const dbgutils::CmdArgViews &args, dbgutils::IOutputSink &out) override
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this] { return m_released; });
+		}
+
+		for (const auto &arg : args) {
+			out.write(arg);
+		}
+	}
+
+	void release()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_released = true;
+		}
+		m_cv.notify_all();
+	}
+
+private:
+	std::mutex				m_mutex;
+	std::condition_variable	m_cv;
+	bool					m_released{ false };
+};
+
+// wait_for_async_outputs calls update until all the asynchronous commands are collected.
+static void wait_for_async_outputs(dbgutils::Console &cons)
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+	while (cons.num_pending_outputs() > 0 && std::chrono::steady_clock::now() < deadline) {
+		cons.update();
+		std::this_thread::yield();
+	}
+}
+
+TEST(Console, AsyncCommandDoesNotBlock)
+{
+	auto slow = std::make_shared<CommandSlow>();
+	dbgutils::Console cons(dbgutils::Interpreter({ slow, std::make_shared<CommandEcho>() }));
+
+	console_write_string_and_execute(cons, L"slow a");
+
+	// The editor is still responsive.
+	cons.handle_character(L'x');
+	EXPECT_EQ(cons.cmdline(), L"x");
+
+	// A placeholder holds the slot of the slow command.
+	EXPECT_EQ(cons.output_size(), 1);
+	EXPECT_TRUE(cons.is_output_pending(0));
+	EXPECT_EQ(cons.get_output(0), dbgutils::Console::kPendingOutputText);
+	EXPECT_FALSE(cons.update());
+
+	slow->release();
+	wait_for_async_outputs(cons);
+
+	EXPECT_FALSE(cons.is_output_pending(0));
+	EXPECT_EQ(cons.get_output(0), L"a");
+}
+
+TEST(Console, AsyncOutputsStayInSubmissionOrder)
+{
+	auto slow = std::make_shared<CommandSlow>();
+	dbgutils::Console cons(dbgutils::Interpreter({ slow, std::make_shared<CommandEcho>() }));
+
+	console_execute_commands(cons, { L"slow first", L"echo second", L"slow third", L"echo fourth" });
+
+	EXPECT_EQ(cons.get_output(0), L"fourth");
+	EXPECT_TRUE(cons.is_output_pending(1));
+	EXPECT_EQ(cons.get_output(2), L"second");
+	EXPECT_TRUE(cons.is_output_pending(3));
+
+	slow->release();
+	wait_for_async_outputs(cons);
+
+	EXPECT_EQ(cons.get_output(0), L"fourth");
+	EXPECT_EQ(cons.get_output(1), L"third");
+	EXPECT_EQ(cons.get_output(2), L"second");
+	EXPECT_EQ(cons.get_output(3), L"first");
+}
+
+TEST(Console, AsyncOutputOverwrittenBeforeCompletion)
+{
+	auto slow = std::make_shared<CommandSlow>();
+	dbgutils::Console cons(dbgutils::Interpreter({ slow, std::make_shared<CommandEcho>() }), 32, 2);
+
+	console_execute_commands(cons, { L"slow first", L"echo second", L"echo third" });
+
+	slow->release();
+	wait_for_async_outputs(cons);
+
+	EXPECT_EQ(cons.output_size(), 2);
+	EXPECT_EQ(cons.get_output(0), L"third");
+	EXPECT_EQ(cons.get_output(1), L"second");
+}
+
+TEST(Console, CtrlRSearchesTheHistoryBackwards)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, { L"echo alpha", L"echo beta", L"echo alphabet", L"echo gamma" });
+
+	const ModKeyState ctrl{ true, false };
+	EXPECT_TRUE(cons.handle_key('R', ctrl));
+	EXPECT_TRUE(cons.is_searching());
+	EXPECT_EQ(cons.cmdline(), L"");
+
+	// Each character narrows the search from the shown entry.
+	cons.handle_character(L'a');
+	EXPECT_EQ(cons.cmdline(), L"echo gamma");
+	cons.handle_character(L'l');
+	EXPECT_EQ(cons.cmdline(), L"echo alphabet");
+	for (auto c : std::wstring(L"pha")) {
+		cons.handle_character(c);
+	}
+	EXPECT_EQ(cons.search_pattern(), L"alpha");
+	EXPECT_EQ(cons.cmdline(), L"echo alphabet");
+
+	// Ctrl+R again: the previous match.
+	cons.handle_key('R', ctrl);
+	EXPECT_EQ(cons.cmdline(), L"echo alpha");
+	EXPECT_FALSE(cons.search_failed());
+
+	// No older match: the shown entry stays.
+	cons.handle_key('R', ctrl);
+	EXPECT_TRUE(cons.search_failed());
+	EXPECT_EQ(cons.cmdline(), L"echo alpha");
+
+	// Enter executes the shown entry.
+	cons.handle_key(VK_RETURN);
+	EXPECT_FALSE(cons.is_searching());
+	EXPECT_EQ(cons.get_output(0), L"alpha");
+	EXPECT_EQ(cons.cmdline(), L"");
+}
+
+TEST(Console, CtrlRBackspaceAndFailedSearch)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, { L"echo one", L"echo two" });
+
+	cons.handle_key('R', ModKeyState{ true, false });
+	for (auto c : std::wstring(L"onx")) {
+		cons.handle_character(c);
+	}
+	EXPECT_TRUE(cons.search_failed());
+	EXPECT_EQ(cons.cmdline(), L"echo one");
+
+	cons.handle_key(VK_BACK);
+	EXPECT_FALSE(cons.search_failed());
+	EXPECT_EQ(cons.search_pattern(), L"on");
+	EXPECT_EQ(cons.cmdline(), L"echo one");
+
+	// The modifier keys and the key presses of the characters are ignored.
+	EXPECT_FALSE(cons.handle_key(VK_CONTROL));
+	EXPECT_FALSE(cons.handle_key('X'));
+	EXPECT_TRUE(cons.is_searching());
+}
+
+TEST(Console, EscapeCancelsTheSearch)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, { L"echo one", L"echo two" });
+
+	for (auto c : std::wstring(L"draft")) {
+		cons.handle_character(c);
+	}
+	cons.handle_key('R', ModKeyState{ true, false });
+	cons.handle_character(L'o');
+	EXPECT_EQ(cons.cmdline(), L"echo two");
+
+	EXPECT_TRUE(cons.handle_key(VK_ESCAPE));
+	EXPECT_FALSE(cons.is_searching());
+	EXPECT_EQ(cons.cmdline(), L"draft");
+}
+
+TEST(Console, CaretKeysAcceptTheMatch)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, { L"echo one", L"echo two", L"echo three" });
+
+	cons.handle_key('R', ModKeyState{ true, false });
+	for (auto c : std::wstring(L"two")) {
+		cons.handle_character(c);
+	}
+
+	// The search ends on the match, which can be edited.
+	EXPECT_TRUE(cons.handle_key(VK_END));
+	EXPECT_FALSE(cons.is_searching());
+	cons.handle_character(L'!');
+	EXPECT_EQ(cons.cmdline(), L"echo two!");
+
+	// The history navigation goes on from the match.
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo one");
+}
+
+TEST(Console, PrefixNavigation)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	EXPECT_EQ(cons.history_navigation(), dbgutils::HISTORY_NAVIGATION_ALL);
+	cons.set_history_navigation(dbgutils::HISTORY_NAVIGATION_PREFIX);
+	console_execute_commands(cons, { L"echo one", L"reset", L"echo two", L"reset" });
+
+	for (auto c : std::wstring(L"echo")) {
+		cons.handle_character(c);
+	}
+
+	// Up goes through the entries starting with the typed command line.
+	EXPECT_TRUE(cons.handle_key(VK_UP));
+	EXPECT_EQ(cons.cmdline(), L"echo two");
+	EXPECT_TRUE(cons.handle_key(VK_UP));
+	EXPECT_EQ(cons.cmdline(), L"echo one");
+	EXPECT_FALSE(cons.handle_key(VK_UP));
+	EXPECT_EQ(cons.cmdline(), L"echo one");
+
+	// Down goes back to the typed command line after the latest match.
+	EXPECT_TRUE(cons.handle_key(VK_DOWN));
+	EXPECT_EQ(cons.cmdline(), L"echo two");
+	EXPECT_TRUE(cons.handle_key(VK_DOWN));
+	EXPECT_EQ(cons.cmdline(), L"echo");
+	EXPECT_FALSE(cons.handle_key(VK_DOWN));
+}
+
+TEST(Console, PrefixNavigationWithoutPrefix)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	cons.set_history_navigation(dbgutils::HISTORY_NAVIGATION_PREFIX);
+	console_execute_commands(cons, { L"echo one", L"reset" });
+
+	// An empty command line browses all the entries.
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"reset");
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo one");
+
+	// Without a match, the command line stays.
+	cons.handle_key(VK_DOWN);
+	cons.handle_key(VK_DOWN);
+	cons.handle_character(L'x');
+	EXPECT_FALSE(cons.handle_key(VK_UP));
+	EXPECT_EQ(cons.cmdline(), L"x");
+}
+
+TEST(Console, EraseOlderDuplicates)
+{
+	dbgutils::Console cons(make_testing_interpreter(), 3);
+	EXPECT_EQ(cons.history_duplicates(), dbgutils::HISTORY_DUPLICATES_KEEP);
+	console_execute_commands(cons, { L"echo a", L"echo b", L"echo a" });
+
+	// The duplicates were kept: "echo b" is in the middle.
+	cons.handle_key(VK_UP);
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo b");
+
+	// The navigation goes back to the new command line.
+	cons.set_history_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	EXPECT_EQ(cons.cmdline(), L"");
+
+	// A recalled entry moves to the top when it is executed again.
+	console_execute_commands(cons, { L"echo c" });
+	cons.handle_key(VK_UP);
+	cons.handle_key(VK_UP);
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo b");
+	cons.handle_key(VK_RETURN);
+
+	for (auto expected : { L"echo b", L"echo c", L"echo a" }) {
+		cons.handle_key(VK_UP);
+		EXPECT_EQ(cons.cmdline(), expected);
+	}
+	EXPECT_FALSE(cons.handle_key(VK_UP));
+}
+
+TEST(Console, SuggestionCompletesTheCommandLine)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, { L"echo one", L"echo two", L"echo two", L"reset" });
+	EXPECT_EQ(cons.suggestion(), L"");
+
+	for (auto c : std::wstring(L"ec")) {
+		cons.handle_character(c);
+	}
+	EXPECT_EQ(cons.suggestion(), L"ho two");
+
+	// Only at the end of the command line.
+	cons.handle_key(VK_LEFT);
+	EXPECT_EQ(cons.suggestion(), L"");
+	cons.handle_key(VK_RIGHT);
+	EXPECT_EQ(cons.cmdline(), L"ec");
+
+	// The right arrow key accepts it. No longer command starts with the accepted one.
+	EXPECT_TRUE(cons.handle_key(VK_RIGHT));
+	EXPECT_EQ(cons.cmdline(), L"echo two");
+	EXPECT_EQ(cons.caret(), 8);
+	EXPECT_EQ(cons.suggestion(), L"");
+	EXPECT_FALSE(cons.handle_key(VK_END));
+
+	// No suggestion for the recalled entries.
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.suggestion(), L"");
+}
+
+TEST(Console, SuggestionReadsTheCommandLineInPlace)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, { L"echo one", L"echo two", L"echo two" });
+
+	// "ech", edited before the "h": the gap of the edit box stays there when the caret moves.
+	cons.handle_character(L'e');
+	cons.handle_character(L'h');
+	cons.handle_key(VK_LEFT);
+	cons.handle_character(L'c');
+	cons.handle_key(VK_RIGHT);
+
+	auto segs = cons.cmdline_segments();
+	EXPECT_EQ(segs.first, L"ec");
+	EXPECT_EQ(segs.second, L"h");
+	EXPECT_EQ(cons.cmdline(), L"ech");
+	EXPECT_EQ(cons.suggestion(), L"o two");
+
+	// A recalled entry is a single segment.
+	cons.handle_key(VK_UP);
+	segs = cons.cmdline_segments();
+	EXPECT_EQ(segs.first, L"echo two");
+	EXPECT_EQ(segs.second, L"");
+}
+
+TEST(Console, EndKeyAcceptsTheSuggestion)
+{
+	dbgutils::Console cons(make_testing_interpreter());
+	console_execute_commands(cons, { L"echo one" });
+
+	cons.handle_character(L'e');
+	EXPECT_TRUE(cons.handle_key(VK_END));
+	EXPECT_EQ(cons.cmdline(), L"echo one");
+}
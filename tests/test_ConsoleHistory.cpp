@@ -1,4 +1,5 @@
 #include "pch.h"
+#include <algorithm>
 #include "../debug_utils/ConsoleHistory.h"
 
 TEST(ConsoleHistory, Ctor)
@@ -59,7 +60,7 @@ static std::vector<std::wstring> collect(size_t n, dbgutils::ConsoleHistory &his
 	for (size_t i = 0; i < n; i++) {
 		history.go_to_previous();
 
-		entries.push_back(history.get());
+		entries.emplace_back(history.get());
 	}
 
 	return entries;
@@ -129,7 +130,7 @@ static std::vector<std::wstring> do_actions_and_collect(std::vector<Action> &act
 			default: break;
 		}
 
-		entries.push_back(history.get());
+		entries.emplace_back(history.get());
 	}
 
 	return entries;
@@ -145,4 +146,306 @@ TEST(ConsoleHistory, PushOne_PrevNext)
 	auto got = do_actions_and_collect(actions, history);
 	auto expected = std::vector<std::wstring>{ L"a",L"" };
 	EXPECT_EQ(got, expected);
-}
\ No newline at end of file
+}
+TEST(ConsoleHistory, WrapAroundManyTimes)
+{
+	const size_t kCapacity = 100;
+	dbgutils::ConsoleHistory history(kCapacity);
+
+	// Lines of various lengths, so that the arena is compacted at various points.
+	auto line = [](size_t i) { return std::to_wstring(i) + std::wstring(i % 37, L'x'); };
+	for (size_t i = 0; i < 10000; i++) {
+		history.push(line(i));
+	}
+
+	EXPECT_EQ(history.size(), kCapacity);
+
+	auto got = collect(kCapacity + 1, history);
+	for (size_t i = 0; i < kCapacity; i++) {
+		ASSERT_EQ(got[i], line(10000 - 1 - i));
+	}
+	EXPECT_EQ(got[kCapacity], line(10000 - kCapacity));
+}
+
+TEST(ConsoleHistory, EmptyEntries)
+{
+	dbgutils::ConsoleHistory history(2);
+
+	history.push(L"");
+	history.push(L"a");
+	history.push(L"");
+
+	auto got = collect(3, history);
+	auto expected = std::vector<std::wstring>{ {L"", L"a", L"a"} };
+	EXPECT_EQ(got, expected);
+}
+
+TEST(ConsoleHistory, MemoryIsBoundedByTheLiveEntries)
+{
+	dbgutils::ConsoleHistory history(10);
+
+	// A large capacity costs nothing until it is filled.
+	EXPECT_EQ(dbgutils::ConsoleHistory(1000000).memory_usage(), 0);
+
+	for (size_t i = 0; i < 100000; i++) {
+		history.push(std::wstring(100, L'x'));
+	}
+
+	// 10 entries of 100 characters, as much dead text before a compaction, and the
+	// slack of the vectors: it does not depend on the number of pushes.
+	EXPECT_LE(history.memory_usage(), 8 * 10 * 100 * sizeof(wchar_t) + 10 * 2 * sizeof(size_t));
+}
+
+TEST(ConsoleHistory, LongLinesThenShortOnes)
+{
+	dbgutils::ConsoleHistory history(4);
+
+	for (size_t i = 0; i < 8; i++) {
+		history.push(std::wstring(10000, static_cast<wchar_t>(L'a' + i)));
+	}
+	auto longLines = history.memory_usage();
+
+	// The arena shrinks when the head laps after the long lines are evicted.
+	for (size_t i = 0; i < 100000; i++) {
+		history.push(std::to_wstring(i));
+	}
+	EXPECT_LT(history.memory_usage(), longLines / 10);
+
+	auto got = collect(4, history);
+	auto expected = std::vector<std::wstring>{ {L"99999", L"99998", L"99997", L"99996"} };
+	EXPECT_EQ(got, expected);
+}
+
+// find_all returns the entries containing a pattern, from the latest to the oldest.
+static std::vector<std::wstring> find_all(const dbgutils::ConsoleHistory &history, std::wstring_view pattern)
+{
+	std::vector<std::wstring> found;
+	uint64_t seq;
+	for (auto before = history.end_seq(); history.find_previous(pattern, before, &seq); before = seq) {
+		found.emplace_back(history.entry(seq));
+	}
+	return found;
+}
+
+TEST(ConsoleHistory, EntriesAreNumberedInPushOrder)
+{
+	dbgutils::ConsoleHistory history(3);
+	for (auto line : { L"a", L"b", L"c", L"d" }) {
+		history.push(line);
+	}
+
+	EXPECT_EQ(history.begin_seq(), 1);
+	EXPECT_EQ(history.end_seq(), 4);
+	EXPECT_EQ(history.entry(1), L"b");
+	EXPECT_EQ(history.entry(3), L"d");
+
+	history.go_to(2);
+	EXPECT_EQ(history.get(), L"c");
+	history.go_to_next();
+	EXPECT_EQ(history.get(), L"d");
+}
+
+TEST(ConsoleHistory, FindPrevious)
+{
+	dbgutils::ConsoleHistory history(4);
+	for (auto line : { L"git status", L"make all", L"git commit", L"make clean", L"abcd bcde" }) {
+		history.push(line);
+	}
+
+	// The oldest entry was evicted, with its trigrams.
+	EXPECT_EQ(find_all(history, L"git"), (std::vector<std::wstring>{ L"git commit" }));
+	EXPECT_EQ(find_all(history, L"make"), (std::vector<std::wstring>{ L"make clean", L"make all" }));
+	EXPECT_EQ(find_all(history, L"status"), (std::vector<std::wstring>{}));
+
+	// The short patterns are indexed too.
+	EXPECT_EQ(find_all(history, L"c"), (std::vector<std::wstring>{ L"abcd bcde", L"make clean", L"git commit" }));
+	EXPECT_EQ(find_all(history, L"ke"), (std::vector<std::wstring>{ L"make clean", L"make all" }));
+	EXPECT_EQ(find_all(history, L"st"), (std::vector<std::wstring>{}));
+	EXPECT_EQ(find_all(history, L""), (std::vector<std::wstring>{ L"abcd bcde", L"make clean", L"git commit", L"make all" }));
+
+	// A candidate holding the trigrams out of order does not match.
+	EXPECT_EQ(find_all(history, L"abcde"), (std::vector<std::wstring>{}));
+}
+
+TEST(ConsoleHistory, FindPreviousAfterWrapAround)
+{
+	dbgutils::ConsoleHistory history(100);
+	for (size_t i = 0; i < 10000; i++) {
+		history.push(L"line " + std::to_wstring(i));
+	}
+
+	auto found = find_all(history, L"line 99");
+	ASSERT_EQ(found.size(), 100);
+	EXPECT_EQ(found.front(), L"line 9999");
+	EXPECT_EQ(found.back(), L"line 9900");
+
+	EXPECT_EQ(find_all(history, L"99 "), (std::vector<std::wstring>{}));
+	EXPECT_EQ(find_all(history, L"e 12"), (std::vector<std::wstring>{}));
+	EXPECT_EQ(find_all(history, L"9950"), (std::vector<std::wstring>{ L"line 9950" }));
+}
+
+TEST(ConsoleHistory, TheFirstSearchBuildsTheTrigramIndex)
+{
+	dbgutils::ConsoleHistory history(4);
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	for (auto line : { L"git status", L"make all", L"git commit", L"make all", L"make clean", L"ls" }) {
+		history.push(line);
+	}
+
+	// The trigrams cost nothing until the first search, and neither does the empty pattern.
+	auto unindexed = history.memory_usage();
+	EXPECT_EQ(find_all(history, L"").size(), 4);
+	EXPECT_EQ(history.memory_usage(), unindexed);
+
+	// The index is built from the entries left by the evictions and the removals.
+	EXPECT_EQ(find_all(history, L"git"), (std::vector<std::wstring>{ L"git commit" }));
+	EXPECT_EQ(find_all(history, L"make"), (std::vector<std::wstring>{ L"make clean", L"make all" }));
+	EXPECT_GT(history.memory_usage(), unindexed);
+
+	// It then follows the changes of the history.
+	history.push(L"git push");
+	history.push(L"make all");
+	EXPECT_EQ(find_all(history, L"git"), (std::vector<std::wstring>{ L"git push" }));
+	EXPECT_EQ(find_all(history, L"make"), (std::vector<std::wstring>{ L"make all", L"make clean" }));
+	EXPECT_EQ(find_all(history, L"status"), (std::vector<std::wstring>{}));
+}
+
+// find_all_with_prefix returns the entries starting with a prefix, from the latest to the oldest.
+static std::vector<uint64_t> find_all_with_prefix(const dbgutils::ConsoleHistory &history, std::wstring_view prefix)
+{
+	std::vector<uint64_t> seqs;
+	uint64_t seq;
+	for (auto before = history.end_seq(); history.find_previous_with_prefix(prefix, before, &seq); before = seq) {
+		seqs.push_back(seq);
+	}
+	return seqs;
+}
+
+TEST(ConsoleHistory, FindWithPrefixFollowsTheEvictions)
+{
+	dbgutils::ConsoleHistory history(50);
+
+	// Few distinct texts, so that the same texts are kept in push order.
+	uint32_t state = 7;
+	for (size_t i = 0; i < 2000; i++) {
+		state = state * 1103515245 + 12345;
+		history.push(L"cmd " + std::to_wstring((state >> 16) % 23));
+
+		if (i % 97 != 0) {
+			continue;
+		}
+		for (std::wstring prefix : { L"cmd 1", L"cmd 2", L"cmd 22", L"c", L"x" }) {
+			std::vector<uint64_t> expected;
+			for (auto seq = history.end_seq(); seq > history.begin_seq(); seq--) {
+				if (history.entry(seq - 1).substr(0, prefix.length()) == prefix) {
+					expected.push_back(seq - 1);
+				}
+			}
+			ASSERT_EQ(find_all_with_prefix(history, prefix), expected);
+
+			// Forwards from the oldest match.
+			for (size_t k = expected.size(); k > 1; k--) {
+				uint64_t seq;
+				ASSERT_TRUE(history.find_next_with_prefix(prefix, expected[k - 1], &seq));
+				ASSERT_EQ(seq, expected[k - 2]);
+			}
+			uint64_t seq;
+			EXPECT_FALSE(history.find_next_with_prefix(prefix, history.end_seq() - 1, &seq));
+		}
+	}
+}
+
+// entries returns the entries of a history, from the oldest to the latest.
+static std::vector<std::wstring> entries(const dbgutils::ConsoleHistory &history)
+{
+	std::vector<std::wstring> lines;
+	for (auto seq = history.begin_seq(); seq < history.end_seq(); seq++) {
+		lines.emplace_back(history.entry(seq));
+	}
+	return lines;
+}
+
+TEST(ConsoleHistory, EraseOlderDuplicates)
+{
+	dbgutils::ConsoleHistory history(4);
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	EXPECT_EQ(history.duplicates(), dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+
+	for (auto line : { L"a", L"b", L"c", L"a", L"c", L"c" }) {
+		history.push(line);
+	}
+	EXPECT_EQ(entries(history), (std::vector<std::wstring>{ L"b", L"a", L"c" }));
+	EXPECT_EQ(history.end_seq() - history.begin_seq(), 3);
+
+	// The distinct entries fill the history.
+	history.push(L"d");
+	history.push(L"e");
+	EXPECT_EQ(entries(history), (std::vector<std::wstring>{ L"a", L"c", L"d", L"e" }));
+
+	// The iteration goes through the moved entries.
+	history.push(L"a");
+	EXPECT_EQ(collect(4, history), (std::vector<std::wstring>{ L"a", L"e", L"d", L"c" }));
+}
+
+TEST(ConsoleHistory, EraseOlderDuplicatesOfTheExistingEntries)
+{
+	dbgutils::ConsoleHistory history(8);
+	for (auto line : { L"a", L"b", L"a", L"c", L"b", L"a" }) {
+		history.push(line);
+	}
+
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	EXPECT_EQ(entries(history), (std::vector<std::wstring>{ L"c", L"b", L"a" }));
+
+	// Back to keeping the duplicates.
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_KEEP);
+	history.push(L"c");
+	EXPECT_EQ(entries(history), (std::vector<std::wstring>{ L"c", L"b", L"a", L"c" }));
+}
+
+TEST(ConsoleHistory, EraseOlderDuplicatesKeepsTheIndexes)
+{
+	// Most commands repeat, and the texts are long enough to wrap the arena around.
+	dbgutils::ConsoleHistory history(40);
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	std::vector<std::wstring> model;
+
+	uint32_t state = 11;
+	for (size_t i = 0; i < 3000; i++) {
+		state = state * 1103515245 + 12345;
+		auto n = (state >> 16) % 64;
+		auto line = L"cmd " + std::to_wstring(n) + std::wstring(n, L'.');
+		history.push(line);
+
+		model.erase(std::remove(model.begin(), model.end(), line), model.end());
+		model.push_back(line);
+		if (model.size() > history.capacity()) {
+			model.erase(model.begin());
+		}
+
+		ASSERT_EQ(entries(history), model);
+		if (i % 37 != 0) {
+			continue;
+		}
+
+		for (std::wstring pattern : { L"cmd 1", L"d 2", L"3..", L"c" }) {
+			std::vector<std::wstring> expected;
+			std::vector<std::wstring> expectedPrefix;
+			for (auto it = model.rbegin(); it != model.rend(); ++it) {
+				if (it->find(pattern) != std::wstring::npos) {
+					expected.push_back(*it);
+				}
+				if (it->compare(0, pattern.length(), pattern) == 0) {
+					expectedPrefix.push_back(*it);
+				}
+			}
+			ASSERT_EQ(find_all(history, pattern), expected);
+
+			std::vector<std::wstring> foundPrefix;
+			for (auto seq : find_all_with_prefix(history, pattern)) {
+				foundPrefix.emplace_back(history.entry(seq));
+			}
+			ASSERT_EQ(foundPrefix, expectedPrefix);
+		}
+	}
+}
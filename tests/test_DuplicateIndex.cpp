@@ -0,0 +1,104 @@
+#include "pch.h"
+#include <string>
+#include "..\debug_utils\ConsoleHistory.h"
+#include "..\debug_utils\DuplicateIndex.h"
+
+// The index reads the text of the entries from a history. It is filled here with
+// the entries of the history, independently of the index of the history. Without removals,
+// the id of an entry is its number.
+static void index_all(const dbgutils::ConsoleHistory &history, dbgutils::DuplicateIndex *index)
+{
+	for (auto seq = history.begin_seq(); seq < history.end_seq(); seq++) {
+		index->insert(history.id_of(seq), history.entry(seq));
+	}
+}
+
+TEST(DuplicateIndex, Empty)
+{
+	dbgutils::ConsoleHistory history(4);
+	dbgutils::DuplicateIndex index;
+
+	uint64_t seq;
+	EXPECT_FALSE(index.find(history, L"a", &seq));
+	EXPECT_EQ(index.size(), 0);
+	EXPECT_EQ(index.memory_usage(), 0);
+}
+
+TEST(DuplicateIndex, FindsTheEntryOfAText)
+{
+	dbgutils::ConsoleHistory history(1000);
+	for (int i = 0; i < 1000; i++) {
+		history.push(L"cmd " + std::to_wstring(i));
+	}
+
+	dbgutils::DuplicateIndex index;
+	index_all(history, &index);
+	EXPECT_EQ(index.size(), 1000);
+
+	uint64_t seq;
+	for (int i = 0; i < 1000; i++) {
+		ASSERT_TRUE(index.find(history, L"cmd " + std::to_wstring(i), &seq));
+		ASSERT_EQ(seq, i);
+	}
+	EXPECT_FALSE(index.find(history, L"cmd", &seq));
+	EXPECT_FALSE(index.find(history, L"cmd 1000", &seq));
+	EXPECT_FALSE(index.find(history, L"", &seq));
+}
+
+TEST(DuplicateIndex, EraseKeepsTheOtherEntriesReachable)
+{
+	dbgutils::ConsoleHistory history(1000);
+	for (int i = 0; i < 1000; i++) {
+		history.push(L"cmd " + std::to_wstring(i));
+	}
+
+	dbgutils::DuplicateIndex index;
+	index_all(history, &index);
+
+	// Every other entry: the clusters of the table are broken in many places.
+	for (uint64_t i = 0; i < 1000; i += 2) {
+		index.erase(i, history.entry(i));
+	}
+	EXPECT_EQ(index.size(), 500);
+
+	uint64_t seq;
+	for (uint64_t i = 0; i < 1000; i++) {
+		auto found = index.find(history, history.entry(i), &seq);
+		ASSERT_EQ(found, i % 2 == 1) << i;
+		if (found) {
+			ASSERT_EQ(seq, i);
+		}
+	}
+}
+
+TEST(DuplicateIndex, IdsOfAHistoryWithRemovals)
+{
+	// The first b is removed: c keeps its id, 2, and takes the number 1.
+	dbgutils::ConsoleHistory history(4);
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	for (auto line : { L"a", L"b", L"c", L"b" }) {
+		history.push(line);
+	}
+	ASSERT_EQ(history.size(), 3);
+	EXPECT_EQ(history.id_of(1), 2);
+
+	dbgutils::DuplicateIndex index;
+	index_all(history, &index);
+
+	uint64_t id;
+	ASSERT_TRUE(index.find(history, L"c", &id));
+	EXPECT_EQ(id, 2);
+	ASSERT_TRUE(index.find(history, L"b", &id));
+	EXPECT_EQ(id, 3);
+	EXPECT_EQ(history.seq_of(id), 2);
+
+	index.erase(2, L"c");
+	EXPECT_FALSE(index.find(history, L"c", &id));
+	ASSERT_TRUE(index.find(history, L"a", &id));
+	EXPECT_EQ(id, 0);
+	EXPECT_EQ(index.size(), 2);
+
+	index.clear();
+	EXPECT_EQ(index.size(), 0);
+	EXPECT_FALSE(index.find(history, L"a", &id));
+}
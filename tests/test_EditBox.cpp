@@ -231,3 +231,154 @@ TEST(EditBox, CtrlRight)
 		EXPECT_EQ(got, exp);
 	}
 }
+
+TEST(EditBox, CtrlRightStopsAtPunctuationAndIdeographs)
+{
+	dbgutils::EditBox ed(L"a.b \u4e00\u4e8c");
+
+	struct Test {
+		size_t	caretBeforeTheCall;
+		size_t	expectedCaret;
+	};
+
+	std::vector<Test> tests = {
+		{0, 1},
+		{1, 2},
+		{2, 4},
+		{4, 5},
+		{5, 6}
+	};
+
+	for (const auto &t : tests) {
+		PositionCaretAt(ed, t.caretBeforeTheCall);
+
+		// The user presses Ctrl + Right keys.
+		ed.handle_key(VK_RIGHT, ModKeyState{ true, false });
+
+		EXPECT_EQ(ed.caret(), t.expectedCaret) << "caret before the call: " << t.caretBeforeTheCall;
+	}
+}
+
+TEST(EditBox, TypeAndBackspaceInTheMiddleOfALongLine)
+{
+	std::wstring line(10000, L'x');
+	dbgutils::EditBox ed(line);
+
+	for (int i = 0; i < 5000; i++) {
+		ed.handle_key(VK_LEFT);
+	}
+	ed.handle_character(L'a');
+	ed.handle_character(L'b');
+	ed.handle_key(VK_BACK);
+
+	line.insert(5000, L"a");
+	EXPECT_EQ(ed.content(), line);
+	EXPECT_EQ(ed.caret(), 5001);
+}
+
+TEST(EditBox, InsertText)
+{
+	dbgutils::EditBox ed(L"ad");
+	ed.handle_key(VK_LEFT);
+
+	EXPECT_TRUE(ed.insert_text(L"bc"));
+
+	EXPECT_EQ(ed.content(), L"abcd");
+	EXPECT_EQ(ed.caret(), 3);
+}
+
+TEST(EditBox, InsertEmptyText)
+{
+	dbgutils::EditBox ed(L"a");
+
+	EXPECT_FALSE(ed.insert_text(L""));
+	EXPECT_EQ(ed.content(), L"a");
+}
+
+TEST(EditBox, InsertTextReplacesLineBreaks)
+{
+	dbgutils::EditBox ed;
+
+	ed.insert_text(L"a\r\nb\nc");
+
+	EXPECT_EQ(ed.content(), L"a b c");
+	EXPECT_EQ(ed.caret(), 5);
+}
+
+TEST(EditBox, UndoTypedWord)
+{
+	dbgutils::EditBox ed;
+	for (auto c : std::wstring(L"spawn unit")) {
+		ed.handle_character(c);
+	}
+
+	EXPECT_TRUE(ed.handle_key('Z', ModKeyState{ true, false }));
+	EXPECT_EQ(ed.content(), L"spawn ");
+	EXPECT_EQ(ed.caret(), 6);
+
+	EXPECT_TRUE(ed.undo());
+	EXPECT_EQ(ed.content(), L"");
+	EXPECT_EQ(ed.caret(), 0);
+	EXPECT_FALSE(ed.undo());
+}
+
+TEST(EditBox, RedoAfterUndo)
+{
+	dbgutils::EditBox ed;
+	ed.insert_text(L"abc");
+	ed.handle_key(VK_LEFT);
+	ed.handle_key(VK_BACK);
+
+	EXPECT_EQ(ed.content(), L"ac");
+
+	ed.undo();
+	EXPECT_EQ(ed.content(), L"abc");
+	EXPECT_EQ(ed.caret(), 2);
+
+	ed.undo();
+	EXPECT_EQ(ed.content(), L"");
+
+	EXPECT_TRUE(ed.handle_key('Y', ModKeyState{ true, false }));
+	EXPECT_EQ(ed.content(), L"abc");
+	EXPECT_EQ(ed.caret(), 3);
+
+	ed.redo();
+	EXPECT_EQ(ed.content(), L"ac");
+	EXPECT_EQ(ed.caret(), 1);
+	EXPECT_FALSE(ed.redo());
+}
+
+TEST(EditBox, MovingTheCaretSplitsTheUndoRecords)
+{
+	dbgutils::EditBox ed;
+	ed.handle_character(L'a');
+	ed.handle_character(L'c');
+	ed.handle_key(VK_LEFT);
+	ed.handle_character(L'b');
+
+	ed.undo();
+	EXPECT_EQ(ed.content(), L"ac");
+	EXPECT_EQ(ed.caret(), 1);
+}
+
+TEST(EditBox, ZWithoutCtrlDoesNotUndo)
+{
+	dbgutils::EditBox ed(L"a");
+	ed.handle_character(L'b');
+
+	EXPECT_FALSE(ed.handle_key('Z'));
+	EXPECT_EQ(ed.content(), L"ab");
+}
+
+TEST(EditBox, UndoKeepsTheCtrlMovementsInSync)
+{
+	dbgutils::EditBox ed(L"ab cd");
+	ed.handle_key(VK_BACK, ModKeyState{ true, false });
+	EXPECT_EQ(ed.content(), L"ab ");
+
+	ed.undo();
+	ed.handle_key(VK_LEFT, ModKeyState{ true, false });
+	EXPECT_EQ(ed.caret(), 3);
+	ed.handle_key(VK_LEFT, ModKeyState{ true, false });
+	EXPECT_EQ(ed.caret(), 0);
+}
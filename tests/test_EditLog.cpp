@@ -0,0 +1,141 @@
+#include "pch.h"
+#include <string>
+#include "..\debug_utils\EditLog.h"
+
+using dbgutils::EditLog;
+
+TEST(EditLog, Empty)
+{
+	EditLog log;
+	EditLog::Edit edit;
+
+	EXPECT_TRUE(log.empty());
+	EXPECT_FALSE(log.can_undo());
+	EXPECT_FALSE(log.can_redo());
+	EXPECT_FALSE(log.undo(&edit));
+	EXPECT_FALSE(log.redo(&edit));
+}
+
+TEST(EditLog, UndoThenRedo)
+{
+	EditLog log;
+	log.record(3, L"abc", L"xy", 6);
+
+	EditLog::Edit edit;
+	ASSERT_TRUE(log.undo(&edit));
+	EXPECT_EQ(edit.position, 3);
+	EXPECT_EQ(edit.erased, L"abc");
+	EXPECT_EQ(edit.inserted, L"xy");
+	EXPECT_EQ(edit.caret, 6);
+	EXPECT_FALSE(log.can_undo());
+
+	ASSERT_TRUE(log.redo(&edit));
+	EXPECT_EQ(edit.erased, L"abc");
+	EXPECT_EQ(edit.inserted, L"xy");
+	EXPECT_FALSE(log.can_redo());
+}
+
+TEST(EditLog, TypedCharactersCoalesce)
+{
+	EditLog log;
+	for (size_t i = 0; i < 3; i++) {
+		log.record_character(i, L"abc"[i], i);
+	}
+
+	EXPECT_EQ(log.size(), 1);
+
+	EditLog::Edit edit;
+	ASSERT_TRUE(log.undo(&edit));
+	EXPECT_EQ(edit.position, 0);
+	EXPECT_EQ(edit.inserted, L"abc");
+	EXPECT_EQ(edit.caret, 0);
+}
+
+TEST(EditLog, WordsAndSealsSplitTheRecords)
+{
+	EditLog log;
+	std::wstring s = L"ab cd";
+	for (size_t i = 0; i < s.length(); i++) {
+		log.record_character(i, s[i], i);
+	}
+
+	// "ab " and "cd"
+	EXPECT_EQ(log.size(), 2);
+
+	log.seal();
+	log.record_character(5, L'e', 5);
+	EXPECT_EQ(log.size(), 3);
+
+	// Not at the end of the previous record.
+	log.record_character(0, L'f', 0);
+	EXPECT_EQ(log.size(), 4);
+}
+
+TEST(EditLog, RecordingDropsTheRedoRecords)
+{
+	EditLog log;
+	log.record(0, L"", L"abc", 0);
+	log.record(3, L"", L"def", 3);
+
+	EditLog::Edit edit;
+	log.undo(&edit);
+	log.record(3, L"", L"g", 3);
+
+	EXPECT_EQ(log.size(), 2);
+	EXPECT_FALSE(log.can_redo());
+
+	ASSERT_TRUE(log.undo(&edit));
+	EXPECT_EQ(edit.inserted, L"g");
+	ASSERT_TRUE(log.undo(&edit));
+	EXPECT_EQ(edit.inserted, L"abc");
+}
+
+TEST(EditLog, UndoSealsTheRecord)
+{
+	EditLog log;
+	log.record_character(0, L'a', 0);
+
+	EditLog::Edit edit;
+	log.undo(&edit);
+	log.record_character(0, L'b', 0);
+
+	ASSERT_TRUE(log.undo(&edit));
+	EXPECT_EQ(edit.inserted, L"b");
+	EXPECT_FALSE(log.can_undo());
+}
+
+TEST(EditLog, TheBudgetDropsTheOldestRecords)
+{
+	const size_t kBudget = 1024;
+	EditLog log(kBudget);
+
+	for (size_t i = 0; i < 1000; i++) {
+		log.record(i, L"", std::to_wstring(i), i);
+		ASSERT_LE(log.memory_usage(), kBudget);
+	}
+
+	// The latest records are kept.
+	EditLog::Edit edit;
+	ASSERT_TRUE(log.undo(&edit));
+	EXPECT_EQ(edit.inserted, L"999");
+	ASSERT_TRUE(log.undo(&edit));
+	EXPECT_EQ(edit.inserted, L"998");
+
+	auto n = log.size();
+	EXPECT_LT(n, 1000);
+	for (size_t i = 2; i < n; i++) {
+		ASSERT_TRUE(log.undo(&edit));
+		ASSERT_EQ(edit.inserted, std::to_wstring(999 - i));
+	}
+	EXPECT_FALSE(log.can_undo());
+}
+
+TEST(EditLog, AnEditLargerThanTheBudgetClearsTheLog)
+{
+	EditLog log(256);
+	log.record(0, L"", L"abc", 0);
+	log.record(3, L"", std::wstring(1000, L'x'), 3);
+
+	EXPECT_TRUE(log.empty());
+	EXPECT_EQ(log.memory_usage(), 0);
+}
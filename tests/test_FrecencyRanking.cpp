@@ -0,0 +1,194 @@
+#include "pch.h"
+#include <string>
+#include "..\debug_utils\FrecencyRanking.h"
+
+TEST(FrecencyRanking, Empty)
+{
+	dbgutils::FrecencyRanking ranking;
+
+	std::wstring_view command;
+	EXPECT_FALSE(ranking.suggest(L"", &command));
+	EXPECT_FALSE(ranking.suggest(L"g", &command));
+	EXPECT_EQ(ranking.score(L"git status"), 0);
+	EXPECT_EQ(ranking.size(), 0);
+	EXPECT_EQ(ranking.memory_usage(), 0);
+}
+
+TEST(FrecencyRanking, ScoreDecays)
+{
+	dbgutils::FrecencyRanking ranking(8, 2);
+
+	ranking.add(L"a");
+	EXPECT_DOUBLE_EQ(ranking.score(L"a"), 1);
+
+	// Halved every two uses.
+	ranking.add(L"b");
+	ranking.add(L"c");
+	EXPECT_DOUBLE_EQ(ranking.score(L"a"), 0.5);
+	EXPECT_DOUBLE_EQ(ranking.score(L"c"), 1);
+
+	ranking.add(L"b");
+	ranking.add(L"a");
+	EXPECT_DOUBLE_EQ(ranking.score(L"a"), 1.25);
+	EXPECT_EQ(ranking.size(), 3);
+}
+
+TEST(FrecencyRanking, ScoreSurvivesTheScaling)
+{
+	dbgutils::FrecencyRanking ranking(8, 1);
+
+	// The weight of a use doubles: the scores are scaled down many times.
+	for (int i = 0; i < 10000; i++) {
+		ranking.add(i % 2 ? L"a" : L"b");
+	}
+
+	EXPECT_NEAR(ranking.score(L"a"), 4.0 / 3, 1e-9);
+	EXPECT_NEAR(ranking.score(L"b"), 2.0 / 3, 1e-9);
+}
+
+TEST(FrecencyRanking, SuggestsTheBestRankedCommand)
+{
+	dbgutils::FrecencyRanking ranking;
+
+	ranking.add(L"git status");
+	ranking.add(L"git commit");
+	ranking.add(L"git commit");
+	ranking.add(L"make clean");
+
+	std::wstring_view command;
+	ASSERT_TRUE(ranking.suggest(L"", &command));
+	EXPECT_EQ(command, L"git commit");
+	ASSERT_TRUE(ranking.suggest(L"git ", &command));
+	EXPECT_EQ(command, L"git commit");
+	ASSERT_TRUE(ranking.suggest(L"git s", &command));
+	EXPECT_EQ(command, L"git status");
+	ASSERT_TRUE(ranking.suggest(L"m", &command));
+	EXPECT_EQ(command, L"make clean");
+	EXPECT_FALSE(ranking.suggest(L"x", &command));
+	EXPECT_FALSE(ranking.suggest(L"git commit -m", &command));
+
+	// The recent uses catch up with the frequent ones.
+	for (int i = 0; i < 3; i++) {
+		ranking.add(L"git status");
+	}
+	ASSERT_TRUE(ranking.suggest(L"g", &command));
+	EXPECT_EQ(command, L"git status");
+}
+
+TEST(FrecencyRanking, SuggestsOnlyLongerCommands)
+{
+	dbgutils::FrecencyRanking ranking;
+
+	ranking.add(L"ls");
+	ranking.add(L"ls");
+	ranking.add(L"ls -la");
+
+	std::wstring_view command;
+	ASSERT_TRUE(ranking.suggest(L"l", &command));
+	EXPECT_EQ(command, L"ls");
+	ASSERT_TRUE(ranking.suggest(L"ls", &command));
+	EXPECT_EQ(command, L"ls -la");
+	EXPECT_FALSE(ranking.suggest(L"ls -la", &command));
+}
+
+TEST(FrecencyRanking, ReplacesTheLowestRankedCommand)
+{
+	dbgutils::FrecencyRanking ranking(2, 1000);
+
+	ranking.add(L"a");
+	ranking.add(L"a");
+	ranking.add(L"b");
+
+	// The new command inherits the score of the replaced one, and more.
+	ranking.add(L"c");
+	EXPECT_EQ(ranking.size(), 2);
+	EXPECT_EQ(ranking.score(L"b"), 0);
+	EXPECT_GT(ranking.score(L"c"), ranking.score(L"a"));
+
+	std::wstring_view command;
+	EXPECT_FALSE(ranking.suggest(L"b", &command));
+	ASSERT_TRUE(ranking.suggest(L"", &command));
+	EXPECT_EQ(command, L"c");
+}
+
+TEST(FrecencyRanking, KeepsTheFrequentCommands)
+{
+	dbgutils::FrecencyRanking ranking(4, 1000);
+
+	// A command used more often than one use in capacity is always tracked.
+	for (int i = 0; i < 1000; i++) {
+		ranking.add(L"x" + std::to_wstring(i));
+		ranking.add(L"a");
+		EXPECT_GT(ranking.score(L"a"), 0);
+	}
+	EXPECT_EQ(ranking.size(), 4);
+}
+
+TEST(FrecencyRanking, ReplacementUpdatesThePrefixes)
+{
+	dbgutils::FrecencyRanking ranking(2);
+
+	ranking.add(L"ls");
+	ranking.add(L"ls");
+	ranking.add(L"ls -la");
+
+	std::wstring_view command;
+	ASSERT_TRUE(ranking.suggest(L"ls", &command));
+	EXPECT_EQ(command, L"ls -la");
+
+	// The longer command is replaced: the shorter one is not a suggestion for itself.
+	ranking.add(L"make");
+	EXPECT_FALSE(ranking.suggest(L"ls", &command));
+	EXPECT_FALSE(ranking.suggest(L"ls ", &command));
+	ASSERT_TRUE(ranking.suggest(L"l", &command));
+	EXPECT_EQ(command, L"ls");
+	ASSERT_TRUE(ranking.suggest(L"", &command));
+	EXPECT_EQ(command, L"make");
+}
+
+TEST(FrecencyRanking, MemoryIsBounded)
+{
+	dbgutils::FrecencyRanking ranking(16);
+
+	for (int i = 0; i < 1000; i++) {
+		ranking.add(L"spawn unit " + std::to_wstring(i));
+	}
+	auto bytes = ranking.memory_usage();
+
+	for (int i = 1000; i < 100000; i++) {
+		ranking.add(L"spawn unit " + std::to_wstring(i));
+	}
+	EXPECT_EQ(ranking.size(), 16);
+	EXPECT_LE(ranking.memory_usage(), 2 * bytes);
+
+	// The long commands are not tracked.
+	ranking.add(std::wstring(dbgutils::FrecencyRanking::kMaxLength + 1, L'x'));
+	EXPECT_EQ(ranking.score(std::wstring(dbgutils::FrecencyRanking::kMaxLength + 1, L'x')), 0);
+}
+
+TEST(FrecencyRanking, Clear)
+{
+	dbgutils::FrecencyRanking ranking;
+
+	ranking.add(L"git status");
+	ranking.clear();
+
+	std::wstring_view command;
+	EXPECT_FALSE(ranking.suggest(L"g", &command));
+	EXPECT_EQ(ranking.size(), 0);
+
+	ranking.add(L"make");
+	EXPECT_DOUBLE_EQ(ranking.score(L"make"), 1);
+}
+
+TEST(FrecencyRanking, EmptyCommand)
+{
+	dbgutils::FrecencyRanking ranking;
+
+	ranking.add(L"");
+	EXPECT_DOUBLE_EQ(ranking.score(L""), 1);
+
+	std::wstring_view command;
+	EXPECT_FALSE(ranking.suggest(L"", &command));
+	EXPECT_FALSE(ranking.suggest(L"a", &command));
+}
@@ -0,0 +1,122 @@
+#include "pch.h"
+#include <string>
+#include "..\debug_utils\GapBuffer.h"
+
+static std::wstring str_of(const dbgutils::GapBuffer &buf)
+{
+	std::wstring s;
+	buf.copy_to(&s);
+	return s;
+}
+
+TEST(GapBuffer, ctor)
+{
+	dbgutils::GapBuffer buf(L"abc");
+
+	EXPECT_EQ(buf.length(), 3);
+	EXPECT_EQ(str_of(buf), L"abc");
+	EXPECT_TRUE(dbgutils::GapBuffer().empty());
+}
+
+TEST(GapBuffer, InsertAtBothEndsAndInTheMiddle)
+{
+	dbgutils::GapBuffer buf(L"bd");
+
+	buf.insert(0, L'a');
+	buf.insert(2, L'c');
+	buf.insert(4, L'e');
+
+	EXPECT_EQ(str_of(buf), L"abcde");
+}
+
+TEST(GapBuffer, InsertText)
+{
+	dbgutils::GapBuffer buf(L"ad");
+
+	buf.insert(1, L"bc");
+
+	EXPECT_EQ(str_of(buf), L"abcd");
+}
+
+TEST(GapBuffer, Erase)
+{
+	dbgutils::GapBuffer buf(L"abcdef");
+
+	buf.erase(4, 2);
+	buf.erase(0, 1);
+	buf.erase(1, 1);
+
+	EXPECT_EQ(str_of(buf), L"bd");
+}
+
+TEST(GapBuffer, Index)
+{
+	dbgutils::GapBuffer buf(L"acd");
+	buf.insert(1, L'b');
+
+	std::wstring got;
+	for (size_t i = 0; i < buf.length(); i++) {
+		got += buf[i];
+	}
+
+	EXPECT_EQ(got, L"abcd");
+}
+
+TEST(GapBuffer, Segments)
+{
+	dbgutils::GapBuffer buf(L"acd");
+	buf.insert(1, L'b');
+
+	// The text is split at the gap, where the latest edit was.
+	auto segs = buf.segments();
+	EXPECT_EQ(segs.first, L"ab");
+	EXPECT_EQ(segs.second, L"cd");
+
+	buf.insert(4, L'e');
+	segs = buf.segments();
+	EXPECT_EQ(segs.first, L"abcde");
+	EXPECT_EQ(segs.second, L"");
+}
+
+TEST(GapBuffer, GrowsPastTheInitialGap)
+{
+	dbgutils::GapBuffer buf(L"[]");
+	std::wstring expected = L"[";
+
+	for (int i = 0; i < 1000; i++) {
+		buf.insert(1 + i, static_cast<wchar_t>(L'a' + i % 26));
+		expected += static_cast<wchar_t>(L'a' + i % 26);
+	}
+	expected += L"]";
+
+	EXPECT_EQ(str_of(buf), expected);
+}
+
+TEST(GapBuffer, MatchesStringUnderRandomEdits)
+{
+	dbgutils::GapBuffer buf;
+	std::wstring expected;
+
+	unsigned seed = 12345;
+	auto next = [&seed](size_t n) {
+		seed = seed * 1103515245u + 12345u;
+		return n == 0 ? 0 : (seed >> 8) % n;
+	};
+
+	for (int i = 0; i < 5000; i++) {
+		auto pos = next(expected.length() + 1);
+		if (next(3) != 0 || expected.empty()) {
+			auto c = static_cast<wchar_t>(L'a' + next(26));
+			buf.insert(pos, c);
+			expected.insert(pos, 1, c);
+		}
+		else {
+			pos = std::min(pos, expected.length() - 1);
+			auto count = std::min<size_t>(1 + next(4), expected.length() - pos);
+			buf.erase(pos, count);
+			expected.erase(pos, count);
+		}
+	}
+
+	EXPECT_EQ(str_of(buf), expected);
+}
@@ -0,0 +1,268 @@
+#include "pch.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "..\debug_utils\HistoryJournal.h"
+#include "..\debug_utils\ConsoleHistory.h"
+#include "..\debug_utils\Console.h"
+#include "CommandEcho.h"
+#include "TempFile.h"
+
+using Records = std::vector<std::wstring>;
+
+static Records load(const std::filesystem::path &path, size_t capacity)
+{
+	Records records;
+	dbgutils::HistoryJournal journal(path, capacity, &records);
+	return records;
+}
+
+// latest returns the entries of a history, from the latest to the oldest.
+static Records latest(dbgutils::ConsoleHistory &history)
+{
+	Records entries;
+	history.reset_iteration();
+	while (history.go_to_previous() == dbgutils::ConsoleHistory::ITEREVENT_AT_NEW_ENTRY) {
+		entries.emplace_back(history.get());
+	}
+	history.reset_iteration();
+	return entries;
+}
+
+TEST(HistoryJournal, NewFileIsEmpty)
+{
+	TempFile file("dbgutils_test_journal_new.bin");
+	Records records{ L"stale" };
+	dbgutils::HistoryJournal journal(file.path(), 4, &records);
+
+	EXPECT_TRUE(records.empty());
+	EXPECT_TRUE(std::filesystem::exists(file.path()));
+	EXPECT_EQ(journal.file_size(), std::filesystem::file_size(file.path()));
+}
+
+TEST(HistoryJournal, AppendAndReload)
+{
+	TempFile file("dbgutils_test_journal_reload.bin");
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 4, &records);
+		journal.append(L"hello");
+		journal.append(L"");
+		journal.append(L"w\u00f6rld");
+	}
+
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"hello", L"", L"w\u00f6rld" }));
+
+	// The loaded records are not appended again.
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"hello", L"", L"w\u00f6rld" }));
+}
+
+TEST(HistoryJournal, LoadsTheLatestRecordsOnly)
+{
+	TempFile file("dbgutils_test_journal_latest.bin");
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 3, &records);
+		for (int i = 0; i < 10; i++) {
+			journal.append(std::to_wstring(i));
+		}
+	}
+
+	EXPECT_EQ(load(file.path(), 3), (Records{ L"7", L"8", L"9" }));
+	EXPECT_EQ(load(file.path(), 100).size(), 10);
+}
+
+TEST(HistoryJournal, TornRecordIsDropped)
+{
+	TempFile file("dbgutils_test_journal_torn.bin");
+	uint64_t intactSize;
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 4, &records);
+		journal.append(L"one");
+		journal.append(L"two");
+		intactSize = journal.file_size();
+		journal.append(L"three");
+	}
+
+	// The process died while writing the latest record.
+	std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 3);
+
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"one", L"two" }));
+	EXPECT_EQ(std::filesystem::file_size(file.path()), intactSize);
+
+	// The next records follow the intact ones.
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 4, &records);
+		journal.append(L"four");
+	}
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"one", L"two", L"four" }));
+}
+
+TEST(HistoryJournal, CorruptedRecordIsDropped)
+{
+	TempFile file("dbgutils_test_journal_corrupted.bin");
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 4, &records);
+		journal.append(L"one");
+		journal.append(L"two");
+	}
+
+	// Flip a character of the latest record.
+	{
+		std::fstream f(file.path(), std::ios::binary | std::ios::in | std::ios::out);
+		f.seekp(-8, std::ios::end);
+		f.put('x');
+	}
+
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"one" }));
+}
+
+TEST(HistoryJournal, CorruptedRecordInTheMiddleKeepsTheLatestRecords)
+{
+	TempFile file("dbgutils_test_journal_middle.bin");
+	uint64_t recordBytes;
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 100, &records);
+		auto headerBytes = journal.file_size();
+		for (int i = 0; i < 10; i++) {
+			journal.append(L"cmd" + std::to_wstring(i));
+		}
+		recordBytes = (journal.file_size() - headerBytes) / 10;
+	}
+	auto size = std::filesystem::file_size(file.path());
+
+	// Flip a character of the third record.
+	{
+		std::fstream f(file.path(), std::ios::binary | std::ios::in | std::ios::out);
+		f.seekp(-static_cast<std::streamoff>(7 * recordBytes + 8), std::ios::end);
+		f.put('x');
+	}
+
+	Records expected;
+	for (int i = 3; i < 10; i++) {
+		expected.push_back(L"cmd" + std::to_wstring(i));
+	}
+	EXPECT_EQ(load(file.path(), 100), expected);
+	EXPECT_EQ(std::filesystem::file_size(file.path()), size);
+
+	// The next records follow them.
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 100, &records);
+		journal.append(L"cmd10");
+	}
+	expected.push_back(L"cmd10");
+	EXPECT_EQ(load(file.path(), 100), expected);
+}
+
+TEST(HistoryJournal, OtherFileIsReset)
+{
+	TempFile file("dbgutils_test_journal_other.bin");
+	{
+		std::ofstream f(file.path(), std::ios::binary);
+		f << "not a journal";
+	}
+
+	EXPECT_TRUE(load(file.path(), 4).empty());
+
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 4, &records);
+		journal.append(L"one");
+	}
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"one" }));
+}
+
+TEST(HistoryJournal, CompactionKeepsTheLatestRecords)
+{
+	TempFile file("dbgutils_test_journal_compaction.bin");
+	const std::wstring padding(200, L'.');
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 4, &records);
+
+		size_t numCompactions = 0;
+		for (int i = 0; i < 1000; i++) {
+			journal.append(std::to_wstring(i) + padding);
+			numCompactions += journal.is_compacting();
+			journal.wait_for_compaction();
+
+			ASSERT_LE(journal.file_size(), dbgutils::HistoryJournal::kMinCompactionBytes + 4 * 1024);
+			ASSERT_EQ(journal.file_size(), std::filesystem::file_size(file.path()));
+		}
+		EXPECT_GT(numCompactions, 0);
+		EXPECT_FALSE(std::filesystem::exists(file.path().string() + ".tmp"));
+	}
+
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"996" + padding, L"997" + padding, L"998" + padding, L"999" + padding }));
+}
+
+TEST(HistoryJournal, AppendsDuringCompactionAreKept)
+{
+	TempFile file("dbgutils_test_journal_concurrent.bin");
+	const std::wstring padding(1000, L'.');
+	{
+		Records records;
+		dbgutils::HistoryJournal journal(file.path(), 8, &records);
+		for (int i = 0; i < 500; i++) {
+			journal.append(std::to_wstring(i) + padding);
+		}
+	}
+
+	auto records = load(file.path(), 8);
+	ASSERT_EQ(records.size(), 8);
+	for (int i = 0; i < 8; i++) {
+		EXPECT_EQ(records[i], std::to_wstring(492 + i) + padding);
+	}
+	EXPECT_LT(std::filesystem::file_size(file.path()), 500 * padding.length() * sizeof(wchar_t) / 4);
+}
+
+TEST(HistoryJournal, ConsoleHistoryReload)
+{
+	TempFile file("dbgutils_test_journal_history.bin");
+	{
+		dbgutils::ConsoleHistory history(3);
+		EXPECT_EQ(history.open_journal(file.path()), 0);
+		for (auto line : { L"a", L"b", L"c", L"d" }) {
+			history.push(line);
+		}
+	}
+
+	// The next start of the process.
+	dbgutils::ConsoleHistory history(3);
+	EXPECT_EQ(history.open_journal(file.path()), 3);
+	EXPECT_EQ(latest(history), (Records{ L"d", L"c", L"b" }));
+
+	history.push(L"e");
+	EXPECT_EQ(latest(history), (Records{ L"e", L"d", L"c" }));
+	EXPECT_EQ(load(file.path(), 3), (Records{ L"c", L"d", L"e" }));
+}
+
+TEST(HistoryJournal, ConsoleReload)
+{
+	TempFile file("dbgutils_test_journal_console.bin");
+
+	auto interpreter = dbgutils::Interpreter({ std::make_shared<CommandEcho>() });
+	{
+		dbgutils::Console cons(interpreter);
+		EXPECT_EQ(cons.open_history_journal(file.path()), 0);
+
+		for (auto cmd : { L"echo a", L"echo b" }) {
+			cons.insert_text(cmd);
+			cons.handle_key(VK_RETURN);
+		}
+	}
+
+	// The next start of the process.
+	dbgutils::Console cons(interpreter);
+	EXPECT_EQ(cons.open_history_journal(file.path()), 2);
+
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo b");
+	cons.handle_key(VK_UP);
+	EXPECT_EQ(cons.cmdline(), L"echo a");
+}
@@ -11,4 +11,120 @@ TEST(Console, interpreter)
 	auto got = interp.execute(L"echo test");
 	auto expected = L"test";
 	EXPECT_EQ(got, expected);
-}
\ No newline at end of file
+}
+
+// A command that returns a fixed string, whatever its arguments.
+// It is used to find out which command the interpreter dispatched to.
+class CommandConst : public dbgutils::ICommand {
+public:
+	CommandConst(const std::wstring &name, const std::wstring &alias, const std::wstring &output)
+		: dbgutils::ICommand(name, alias)
+		, m_output(output)
+	{}
+
+	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		return m_output;
+	}
+
+private:
+	std::wstring	m_output;
+};
+
+TEST(Interpreter, Alias)
+{
+	dbgutils::Interpreter interp({ std::make_shared<CommandConst>(L"print", L"p", L"printed") });
+
+	EXPECT_EQ(interp.execute(L"p"), L"printed");
+	EXPECT_EQ(interp.execute(L"  print  a b"), L"printed");
+}
+
+TEST(Interpreter, UnknownCommand)
+{
+	dbgutils::Interpreter interp({ std::make_shared<CommandEcho>() });
+
+	EXPECT_EQ(interp.execute(L"ech test"), L"Unknown command");
+	EXPECT_EQ(interp.execute(L""), L"Unknown command");
+}
+
+TEST(Interpreter, OnlyTheFirstTokenIsACommandName)
+{
+	dbgutils::Interpreter interp({ std::make_shared<CommandEcho>() });
+
+	EXPECT_EQ(interp.execute(L"say echo test"), L"Unknown command");
+	EXPECT_EQ(interp.execute(L"echoes test"), L"Unknown command");
+}
+
+TEST(Interpreter, CommandsSharingAPrefix)
+{
+	dbgutils::Interpreter interp({
+		std::make_shared<CommandConst>(L"ls", L"", L"ls"),
+		std::make_shared<CommandConst>(L"lsx", L"l", L"lsx")
+	});
+
+	EXPECT_EQ(interp.execute(L"ls"), L"ls");
+	EXPECT_EQ(interp.execute(L"lsx"), L"lsx");
+	EXPECT_EQ(interp.execute(L"l"), L"lsx");
+}
+
+TEST(Interpreter, NameBeatsAlias)
+{
+	dbgutils::Interpreter interp({ std::make_shared<CommandConst>(L"list", L"", L"list") });
+	interp.InstallCommand(std::make_shared<CommandConst>(L"length", L"list", L"length"));
+
+	EXPECT_EQ(interp.execute(L"list"), L"list");
+
+	interp.InstallCommand(std::make_shared<CommandConst>(L"l", L"", L"l"));
+	interp.InstallCommand(std::make_shared<CommandConst>(L"lower", L"l", L"lower"));
+
+	EXPECT_EQ(interp.execute(L"l"), L"l");
+}
+
+TEST(Interpreter, LatestInstalledCommandWins)
+{
+	dbgutils::Interpreter interp({ std::make_shared<CommandConst>(L"run", L"r", L"old") });
+	interp.InstallCommand(std::make_shared<CommandConst>(L"run", L"r", L"new"));
+
+	EXPECT_EQ(interp.execute(L"run"), L"new");
+	EXPECT_EQ(interp.execute(L"r"), L"new");
+}
+
+// A command that counts its arguments through the CmdArgViews overload.
+class CommandCountArgs : public dbgutils::ICommand {
+public:
+	CommandCountArgs()
+		: dbgutils::ICommand(L"count")
+	{}
+
+	std::wstring execute(const dbgutils::CmdArgViews &args) override
+	{
+		return std::to_wstring(args.size());
+	}
+
+	// The interpreter does not go through the copy of the arguments.
+	std::wstring execute(const dbgutils::CmdArgs &args) override
+	{
+		return L"copied";
+	}
+};
+
+TEST(Interpreter, CmdArgViewsOverload)
+{
+	dbgutils::Interpreter interp({ std::make_shared<CommandCountArgs>() });
+
+	EXPECT_EQ(interp.execute(L"count"), L"0");
+	EXPECT_EQ(interp.execute(L"count a  bc d"), L"3");
+}
+
+TEST(Interpreter, CmdArgViewsOverloadForwardsToCmdArgsOverload)
+{
+	CommandEcho cmd;
+	dbgutils::ICommand &icmd = cmd;
+
+	std::wstring_view views[] = { L"a", L"b" };
+	EXPECT_EQ(icmd.execute(dbgutils::CmdArgViews(views, 2)), L"a b");
+
+	dbgutils::ChunkedText out;
+	icmd.execute(dbgutils::CmdArgViews(views, 2), out);
+	EXPECT_EQ(out.str(), L"a b");
+}
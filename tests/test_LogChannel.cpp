@@ -0,0 +1,123 @@
+#include "pch.h"
+#include <thread>
+#include <vector>
+#include "..\debug_utils\LogChannel.h"
+#include "..\debug_utils\Console.h"
+
+TEST(LogChannel, OneThread)
+{
+	dbgutils::LogChannel channel;
+
+	channel.log(L"a");
+	channel.log(L"b");
+
+	std::vector<dbgutils::LogMessage> batch;
+	EXPECT_EQ(channel.drain(&batch), 2);
+
+	ASSERT_EQ(batch.size(), 2);
+	EXPECT_EQ(batch[0].text, L"a");
+	EXPECT_EQ(batch[1].text, L"b");
+	EXPECT_LT(batch[0].seq, batch[1].seq);
+
+	EXPECT_EQ(channel.drain(&batch), 0);
+}
+
+TEST(LogChannel, DropsTheOldestMessagesOfAFullThread)
+{
+	dbgutils::LogChannel channel(2);
+
+	channel.log(L"a");
+	channel.log(L"b");
+	channel.log(L"c");
+
+	std::vector<dbgutils::LogMessage> batch;
+	channel.drain(&batch);
+
+	ASSERT_EQ(batch.size(), 2);
+	EXPECT_EQ(batch[0].text, L"b");
+	EXPECT_EQ(batch[1].text, L"c");
+	EXPECT_EQ(channel.dropped(), 1);
+}
+
+TEST(LogChannel, ReleasesTheBuffersOfExitedThreads)
+{
+	dbgutils::LogChannel channel;
+
+	std::thread t([&channel] { channel.log(L"a"); });
+	t.join();
+
+	EXPECT_EQ(channel.num_producers(), 1);
+
+	std::vector<dbgutils::LogMessage> batch;
+	channel.drain(&batch);
+
+	EXPECT_EQ(batch.size(), 1);
+	EXPECT_EQ(channel.num_producers(), 0);
+}
+
+// Many threads log concurrently while the consumer drains.
+// Each thread's messages are received in order, the batches are sorted by
+// sequence number, and no message is lost.
+TEST(LogChannel, Stress)
+{
+	const size_t kNumThreads = 16;
+	const size_t kNumMessages = 2000;
+
+	dbgutils::LogChannel channel(kNumMessages);
+
+	std::vector<std::thread> producers;
+	for (size_t t = 0; t < kNumThreads; t++) {
+		producers.emplace_back([&channel, t] {
+			for (size_t i = 0; i < kNumMessages; i++) {
+				channel.log(std::to_wstring(t * kNumMessages + i));
+			}
+		});
+	}
+
+	std::vector<size_t> nextIndex(kNumThreads, 0);
+	size_t received = 0;
+	bool fifo = true;
+	bool sorted = true;
+
+	auto consume = [&] {
+		std::vector<dbgutils::LogMessage> batch;
+		channel.drain(&batch);
+
+		for (size_t k = 0; k < batch.size(); k++) {
+			sorted = sorted && (k == 0 || batch[k - 1].seq < batch[k].seq);
+
+			auto id = std::stoull(batch[k].text);
+			auto t = id / kNumMessages;
+			auto i = id % kNumMessages;
+			fifo = fifo && i == nextIndex[t];
+			nextIndex[t] = i + 1;
+			received++;
+		}
+	};
+
+	while (received < kNumThreads * kNumMessages) {
+		consume();
+	}
+	for (auto &p : producers) {
+		p.join();
+	}
+	consume();
+
+	EXPECT_TRUE(fifo);
+	EXPECT_TRUE(sorted);
+	EXPECT_EQ(received, kNumThreads * kNumMessages);
+	EXPECT_EQ(channel.dropped(), 0);
+}
+
+TEST(LogChannel, ConsoleOutput)
+{
+	dbgutils::Console cons;
+
+	std::thread t([&cons] { cons.log_channel().log(L"from another thread"); });
+	t.join();
+
+	EXPECT_EQ(cons.output_size(), 0);
+	EXPECT_TRUE(cons.update());
+	ASSERT_EQ(cons.output_size(), 1);
+	EXPECT_EQ(cons.get_output(0), L"from another thread");
+}
@@ -0,0 +1,159 @@
+#include "pch.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "..\debug_utils\MappedOutputRing.h"
+#include "..\debug_utils\Console.h"
+#include "CommandEcho.h"
+#include "TempFile.h"
+
+static std::vector<std::wstring> texts_of(const std::vector<dbgutils::MappedOutputRecord> &records)
+{
+	std::vector<std::wstring> texts;
+	for (const auto &r : records) {
+		texts.push_back(r.text);
+	}
+	return texts;
+}
+
+TEST(MappedOutputRing, NewFileIsEmpty)
+{
+	TempFile file("dbgutils_test_ring_new.bin");
+	dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 4);
+
+	EXPECT_EQ(ring.generation(), 1);
+	EXPECT_EQ(ring.write_index(), 0);
+	EXPECT_TRUE(ring.records().empty());
+}
+
+TEST(MappedOutputRing, AppendAndRecover)
+{
+	TempFile file("dbgutils_test_ring_append.bin");
+	dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 4);
+
+	ring.append(L"hello");
+	ring.append(L"");
+	ring.append(L"world");
+
+	auto records = ring.records();
+	EXPECT_EQ(texts_of(records), (std::vector<std::wstring>{ L"hello", L"", L"world" }));
+	EXPECT_EQ(records[2].number, 2);
+	EXPECT_EQ(records[2].generation, 1);
+}
+
+TEST(MappedOutputRing, RecordsSurviveReopening)
+{
+	TempFile file("dbgutils_test_ring_reopen.bin");
+	{
+		dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 4);
+		ring.append(L"a");
+		ring.append(L"b");
+	}
+
+	dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 4);
+	EXPECT_EQ(ring.generation(), 2);
+	EXPECT_EQ(texts_of(ring.records()), (std::vector<std::wstring>{ L"a", L"b" }));
+
+	// The numbering goes on; the generation tells the runs apart.
+	ring.append(L"c");
+	auto records = ring.records();
+	EXPECT_EQ(records.back().number, 2);
+	EXPECT_EQ(records.back().generation, 2);
+	EXPECT_EQ(records.front().generation, 1);
+}
+
+TEST(MappedOutputRing, OldestOverwrittenWhenSlotsFull)
+{
+	TempFile file("dbgutils_test_ring_slots.bin");
+	dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 2);
+
+	ring.append(L"a");
+	ring.append(L"b");
+	ring.append(L"c");
+
+	EXPECT_EQ(texts_of(ring.records()), (std::vector<std::wstring>{ L"b", L"c" }));
+}
+
+TEST(MappedOutputRing, OldestOverwrittenWhenDataFull)
+{
+	TempFile file("dbgutils_test_ring_data.bin");
+	dbgutils::MappedOutputRing ring(file.path(), 10 * sizeof(wchar_t), 100);
+
+	ring.append(L"aaaa");
+	ring.append(L"bbbb");
+	ring.append(L"cccc");	// does not fit at the end: starts at the beginning
+
+	EXPECT_EQ(texts_of(ring.records()), (std::vector<std::wstring>{ L"bbbb", L"cccc" }));
+}
+
+TEST(MappedOutputRing, TruncatedToTheDataSize)
+{
+	TempFile file("dbgutils_test_ring_trunc.bin");
+	dbgutils::MappedOutputRing ring(file.path(), 4 * sizeof(wchar_t), 4);
+
+	ring.append(L"0123456789");
+
+	EXPECT_EQ(texts_of(ring.records()), (std::vector<std::wstring>{ L"0123" }));
+}
+
+TEST(MappedOutputRing, ResetWhenGeometryChanges)
+{
+	TempFile file("dbgutils_test_ring_geometry.bin");
+	{
+		dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 4);
+		ring.append(L"a");
+	}
+
+	dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 8);
+	EXPECT_EQ(ring.generation(), 1);
+	EXPECT_TRUE(ring.records().empty());
+}
+
+TEST(MappedOutputRing, ResetWhenHeaderCorrupted)
+{
+	TempFile file("dbgutils_test_ring_corrupted.bin");
+	{
+		dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 4);
+		ring.append(L"a");
+	}
+
+	// Change the generation (after magic, version and character size):
+	// only the checksum tells.
+	{
+		std::fstream f(file.path(), std::ios::in | std::ios::out | std::ios::binary);
+		f.seekp(12);
+		f.put('\x7f');
+	}
+
+	dbgutils::MappedOutputRing ring(file.path(), 100 * sizeof(wchar_t), 4);
+	EXPECT_EQ(ring.generation(), 1);
+	EXPECT_TRUE(ring.records().empty());
+}
+
+TEST(MappedOutputRing, ConsoleRecoversOutputs)
+{
+	TempFile file("dbgutils_test_ring_console.bin");
+	auto interpreter = dbgutils::Interpreter({ std::make_shared<CommandEcho>() });
+	{
+		dbgutils::Console cons(interpreter);
+		EXPECT_EQ(cons.map_outputs_to_file(file.path()), 0);
+
+		for (auto cmd : { L"echo a", L"echo b" }) {
+			for (auto c : std::wstring(cmd)) {
+				cons.handle_character(c);
+			}
+			cons.handle_key(VK_RETURN);
+		}
+		cons.log_channel().log(L"logged");
+		cons.update();
+	}
+
+	// The next start of the process.
+	dbgutils::Console cons(interpreter);
+	EXPECT_EQ(cons.map_outputs_to_file(file.path()), 3);
+
+	EXPECT_EQ(cons.output_size(), 3);
+	EXPECT_EQ(cons.get_output(0), L"logged");
+	EXPECT_EQ(cons.get_output(1), L"b");
+	EXPECT_EQ(cons.get_output(2), L"a");
+}
@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "..\debug_utils\OutputSink.h"
+
+TEST(ChunkedText, Empty)
+{
+	dbgutils::ChunkedText text;
+
+	EXPECT_TRUE(text.empty());
+	EXPECT_EQ(text.num_chunks(), 0);
+	EXPECT_EQ(text.str(), L"");
+}
+
+TEST(ChunkedText, SmallWritesAreCoalesced)
+{
+	dbgutils::ChunkedText text;
+
+	text.write(L"ab");
+	text.write(L"");
+	text.write(L"c");
+
+	EXPECT_EQ(text.num_chunks(), 1);
+	EXPECT_EQ(text.length(), 3);
+	EXPECT_EQ(text.str(), L"abc");
+}
+
+TEST(ChunkedText, BigWritesGetTheirOwnChunk)
+{
+	using dbgutils::ChunkedText;
+
+	std::wstring big(ChunkedText::kChunkCapacity + 1, L'x');
+	ChunkedText text;
+
+	text.write(L"a");
+	text.write(big);
+	text.write(L"b");
+
+	EXPECT_EQ(text.num_chunks(), 3);
+	EXPECT_EQ(text.length(), big.length() + 2);
+	EXPECT_EQ(text.str(), L"a" + big + L"b");
+}
+
+TEST(ChunkedText, CompareWithString)
+{
+	dbgutils::ChunkedText text;
+
+	text.write(L"hello, ");
+	text.write(L"world");
+
+	EXPECT_TRUE(text == L"hello, world");
+	EXPECT_FALSE(text == L"hello, world!");
+	EXPECT_FALSE(text == L"hello, World");
+}
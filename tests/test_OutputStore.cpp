@@ -0,0 +1,236 @@
+#include "pch.h"
+#include <string>
+#include "..\debug_utils\OutputStore.h"
+
+static uint64_t push_text(dbgutils::OutputStore &store, std::wstring_view text)
+{
+	auto seq = store.push();
+	store.begin_write(seq);
+	store.write(text);
+	store.end_write();
+
+	return seq;
+}
+
+TEST(OutputStore, ctor)
+{
+	dbgutils::OutputStore store(100 * sizeof(wchar_t), 4);
+
+	EXPECT_EQ(store.size(), 0);
+	EXPECT_TRUE(store.empty());
+	EXPECT_EQ(store.capacity(), 4);
+	EXPECT_EQ(store.byte_budget(), 100 * sizeof(wchar_t));
+	EXPECT_EQ(store.end_seq(), 0);
+}
+
+TEST(OutputStore, PushAndGet)
+{
+	dbgutils::OutputStore store(100 * sizeof(wchar_t), 4);
+
+	auto a = push_text(store, L"hello");
+	auto b = push_text(store, L"");
+
+	EXPECT_EQ(a, 0);
+	EXPECT_EQ(b, 1);
+	EXPECT_EQ(store.size(), 2);
+	EXPECT_EQ(store.get(a), L"hello");
+	EXPECT_EQ(store.get(b), L"");
+}
+
+TEST(OutputStore, WriteInSeveralChunks)
+{
+	dbgutils::OutputStore store(100 * sizeof(wchar_t), 4);
+
+	auto seq = store.push();
+	store.begin_write(seq);
+	store.write(L"hello, ");
+	store.write(L"world");
+	store.end_write();
+
+	EXPECT_EQ(store.get(seq), L"hello, world");
+}
+
+TEST(OutputStore, OldestEvictedWhenIndexFull)
+{
+	dbgutils::OutputStore store(100 * sizeof(wchar_t), 2);
+
+	push_text(store, L"a");
+	push_text(store, L"b");
+	push_text(store, L"c");
+
+	EXPECT_EQ(store.size(), 2);
+	EXPECT_EQ(store.first_seq(), 1);
+	EXPECT_FALSE(store.contains(0));
+	EXPECT_EQ(store.get(1), L"b");
+	EXPECT_EQ(store.get(2), L"c");
+}
+
+TEST(OutputStore, OldestEvictedWhenOverBudget)
+{
+	dbgutils::OutputStore store(10 * sizeof(wchar_t), 100);
+
+	push_text(store, L"aaaa");
+	push_text(store, L"bbbb");
+	push_text(store, L"cccc");
+
+	EXPECT_EQ(store.size(), 2);
+	EXPECT_EQ(store.first_seq(), 1);
+	EXPECT_EQ(store.get(1), L"bbbb");
+	EXPECT_EQ(store.get(2), L"cccc");
+}
+
+TEST(OutputStore, TextStaysContiguousAcrossTheArenaEnd)
+{
+	dbgutils::OutputStore store(10 * sizeof(wchar_t), 100);
+
+	push_text(store, L"aaaaaaa");
+
+	// The text does not fit at the end of the arena:
+	// it is moved to the beginning, chunk already written included.
+	auto seq = store.push();
+	store.begin_write(seq);
+	store.write(L"xy");
+	store.write(L"z1234");
+	store.end_write();
+
+	EXPECT_EQ(store.get(seq), L"xyz1234");
+	EXPECT_FALSE(store.contains(0));
+}
+
+TEST(OutputStore, TruncatedToTheArenaSize)
+{
+	dbgutils::OutputStore store(10 * sizeof(wchar_t), 100);
+
+	push_text(store, L"abc");
+	auto seq = push_text(store, L"0123456789ABCDEF");
+
+	EXPECT_EQ(store.size(), 1);
+	EXPECT_EQ(store.get(seq), L"0123456789");
+}
+
+TEST(OutputStore, PendingOutputWrittenLater)
+{
+	dbgutils::OutputStore store(100 * sizeof(wchar_t), 4);
+
+	auto pending = store.push(true);
+	auto after = push_text(store, L"after");
+
+	EXPECT_TRUE(store.is_pending(pending));
+	EXPECT_EQ(store.get(pending), L"");
+
+	store.begin_write(pending);
+	store.write(L"done");
+	store.end_write();
+
+	EXPECT_FALSE(store.is_pending(pending));
+	EXPECT_EQ(store.get(pending), L"done");
+	EXPECT_EQ(store.get(after), L"after");
+}
+
+TEST(OutputStore, RewrittenOutputReleasesItsOldText)
+{
+	dbgutils::OutputStore store(10 * sizeof(wchar_t), 100);
+
+	auto seq = push_text(store, L"aaaa");
+	store.begin_write(seq);
+	store.write(L"bbbb");
+	store.end_write();
+
+	// The old text of the output is dead: evicting it keeps the output.
+	auto next = push_text(store, L"cccc");
+
+	EXPECT_EQ(store.size(), 2);
+	EXPECT_EQ(store.get(seq), L"bbbb");
+	EXPECT_EQ(store.get(next), L"cccc");
+}
+
+TEST(OutputStore, LateTextEvictedWithNewerOutputs)
+{
+	dbgutils::OutputStore store(10 * sizeof(wchar_t), 100);
+
+	auto pending = store.push(true);
+	push_text(store, L"aaa");
+
+	// The pending output gets its text after the newer output.
+	store.begin_write(pending);
+	store.write(L"bbb");
+	store.end_write();
+
+	// Evicting the text of the newer output evicts the pending output too,
+	// although its text is still in the arena.
+	auto latest = push_text(store, L"cccccc");
+
+	EXPECT_EQ(store.size(), 1);
+	EXPECT_EQ(store.first_seq(), latest);
+	EXPECT_EQ(store.get(latest), L"cccccc");
+}
+
+TEST(OutputStore, WriteIgnoredWhenEvicted)
+{
+	dbgutils::OutputStore store(100 * sizeof(wchar_t), 1);
+
+	auto pending = store.push(true);
+	auto latest = push_text(store, L"latest");
+
+	store.begin_write(pending);
+	store.write(L"lost");
+	store.end_write();
+
+	EXPECT_EQ(store.size(), 1);
+	EXPECT_EQ(store.get(latest), L"latest");
+}
+
+TEST(OutputStore, LateTextDoesNotEvictNewerOutputs)
+{
+	dbgutils::OutputStore store(10 * sizeof(wchar_t), 100);
+
+	auto pending = store.push(true);
+	auto newer = push_text(store, L"aaaaaa");
+
+	// Only two characters fit before the text of the newer output:
+	// the late text is truncated at the chunk which does not fit.
+	store.begin_write(pending);
+	store.write(L"bb");
+	store.write(L"cccc");
+	store.write(L"d");
+	store.end_write();
+
+	EXPECT_EQ(store.size(), 2);
+	EXPECT_EQ(store.get(pending), L"bb");
+	EXPECT_EQ(store.get(newer), L"aaaaaa");
+}
+
+TEST(OutputStore, ManyOutputsWithASmallIndex)
+{
+	dbgutils::OutputStore store(1024 * 1024, 32);
+	auto memory = store.memory_usage();
+
+	uint64_t last = 0;
+	for (int i = 0; i < 200000; i++) {
+		last = push_text(store, std::to_wstring(i));
+	}
+
+	EXPECT_EQ(store.size(), 32);
+	EXPECT_EQ(store.get(last), L"199999");
+	EXPECT_EQ(store.get(last - 31), L"199968");
+	EXPECT_EQ(store.memory_usage(), memory);
+}
+
+TEST(OutputStore, OutputRewrittenManyTimesAfterAnOlderOne)
+{
+	dbgutils::OutputStore store(1024 * sizeof(wchar_t), 4);
+
+	// The block of the first output stays at the front of the arena
+	// while the blocks of the rewritten output die behind it.
+	auto first = push_text(store, L"first");
+	auto rewritten = store.push();
+	for (int i = 0; i < 100; i++) {
+		store.begin_write(rewritten);
+		store.write(std::to_wstring(i));
+		store.end_write();
+	}
+
+	EXPECT_EQ(store.size(), 2);
+	EXPECT_EQ(store.get(first), L"first");
+	EXPECT_EQ(store.get(rewritten), L"99");
+}
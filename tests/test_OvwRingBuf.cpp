@@ -1,5 +1,8 @@
 #include "pch.h"
+#include <stdexcept>
 #include <vector>
+#include <memory>
+#include <string>
 #include "..\debug_utils\OvwRingBuf.h"
 
 TEST(OvwRingBuf, ctor)
@@ -100,3 +103,240 @@ TEST(OvwRingBuf, FillAndPeekAll)
 	auto expected = std::vector<int>{ 0,1,2 };
 	EXPECT_EQ(got, expected);
 }
+
+TEST(OvwRingBuf, OverwriteWhenFull)
+{
+	dbgutils::OvwRingBuf<int>	buf(3);
+	for (int i = 0; i < 5; i++) {
+		buf.push_back(i);
+	}
+
+	auto got = peek_collect(buf, buf.capacity());
+	auto expected = std::vector<int>{ 2,3,4 };
+	EXPECT_EQ(got, expected);
+}
+
+// A type that can only be moved and has no default constructor.
+struct MoveOnly {
+	explicit MoveOnly(int v)
+		: value(new int(v))
+	{}
+
+	std::unique_ptr<int>	value;
+};
+
+TEST(OvwRingBuf, MoveOnlyType)
+{
+	dbgutils::OvwRingBuf<MoveOnly>	buf(2);
+
+	buf.push_back(MoveOnly(1));
+	buf.emplace_back(2);
+	buf.emplace_back(3);// evicts 1
+
+	EXPECT_EQ(buf.size(), 2);
+	EXPECT_EQ(*buf.pop_front().value, 2);
+	EXPECT_EQ(*buf.pop_front().value, 3);
+	EXPECT_TRUE(buf.empty());
+}
+
+// A type counting its live instances.
+struct Counted {
+	static int	alive;
+
+	Counted() { alive++; }
+	Counted(const Counted &) { alive++; }
+	~Counted() { alive--; }
+
+	Counted &operator=(const Counted &) = default;
+};
+int Counted::alive = 0;
+
+TEST(OvwRingBuf, ItemsAreConstructedOnInsertionAndDestroyedOnRemoval)
+{
+	{
+		dbgutils::OvwRingBuf<Counted>	buf(3);
+		EXPECT_EQ(Counted::alive, 0);
+
+		buf.emplace_back();
+		buf.emplace_back();
+		EXPECT_EQ(Counted::alive, 2);
+
+		buf.pop_front();
+		EXPECT_EQ(Counted::alive, 1);
+
+		for (int i = 0; i < 5; i++) {
+			buf.emplace_back();
+		}
+		EXPECT_EQ(Counted::alive, 3);
+
+		auto copy = buf;
+		EXPECT_EQ(Counted::alive, 6);
+	}
+
+	EXPECT_EQ(Counted::alive, 0);
+}
+
+// A counted type whose constructor throws on demand.
+struct ThrowingCounted : Counted {
+	explicit ThrowingCounted(bool fail)
+	{
+		if (fail) {
+			throw std::runtime_error("construction failed");
+		}
+	}
+};
+
+TEST(OvwRingBuf, FailedEmplaceLosesOnlyTheFrontItem)
+{
+	{
+		dbgutils::OvwRingBuf<ThrowingCounted>	buf(2);
+		buf.emplace_back(false);
+
+		// The buffer is not full: it is unchanged.
+		EXPECT_THROW(buf.emplace_back(true), std::runtime_error);
+		EXPECT_EQ(buf.size(), 1);
+		EXPECT_EQ(Counted::alive, 1);
+
+		// The buffer is full: the front item was destroyed before the construction.
+		buf.emplace_back(false);
+		EXPECT_THROW(buf.emplace_back(true), std::runtime_error);
+		EXPECT_EQ(buf.size(), 1);
+		EXPECT_EQ(Counted::alive, 1);
+
+		buf.emplace_back(false);
+		buf.emplace_back(false);
+		EXPECT_EQ(buf.size(), 2);
+		EXPECT_EQ(Counted::alive, 2);
+	}
+
+	EXPECT_EQ(Counted::alive, 0);
+}
+
+// A type that can be neither copied nor moved.
+struct Immovable {
+	explicit Immovable(int v)
+		: value(v)
+	{}
+
+	Immovable(const Immovable &) = delete;
+	Immovable &operator=(const Immovable &) = delete;
+
+	int	value;
+};
+
+TEST(OvwRingBuf, EmplaceConstructsInPlace)
+{
+	dbgutils::OvwRingBuf<Immovable>	buf(2);
+
+	buf.emplace_back(1);
+	buf.emplace_back(2);
+	auto &item = buf.emplace_back(3);// evicts 1, in its slot
+
+	EXPECT_EQ(&item, &buf.peek(1));
+	EXPECT_EQ(buf.size(), 2);
+	EXPECT_EQ(buf.peek(0).value, 2);
+	EXPECT_EQ(buf.peek(1).value, 3);
+}
+
+TEST(OvwRingBuf, MovedFromBufferIsEmpty)
+{
+	dbgutils::OvwRingBuf<std::wstring>	buf(2);
+	buf.push_back(L"a");
+
+	auto moved = std::move(buf);
+	EXPECT_EQ(moved.size(), 1);
+	EXPECT_EQ(buf.size(), 0);
+	EXPECT_EQ(buf.capacity(), 0);
+	EXPECT_TRUE(buf.empty());
+
+	// It can be assigned to.
+	buf = dbgutils::OvwRingBuf<std::wstring>(3);
+	buf.push_back(L"b");
+	EXPECT_EQ(buf.capacity(), 3);
+	EXPECT_EQ(buf.peek(0), L"b");
+}
+
+TEST(OvwRingBuf, PushBackMovesTheItem)
+{
+	dbgutils::OvwRingBuf<std::wstring>	buf(2);
+
+	std::wstring s(100, L'x');
+	const auto *data = s.data();
+
+	buf.push_back(std::move(s));
+
+	EXPECT_EQ(buf.peek(0).data(), data);
+}
+
+TEST(OvwRingBuf, PowerOfTwo)
+{
+	dbgutils::Pow2OvwRingBuf<int>	buf(4);
+	for (int i = 0; i < 7; i++) {
+		buf.push_back(i);
+	}
+
+	EXPECT_EQ(buf.size(), 4);
+	EXPECT_EQ(buf.peek(0), 3);
+	EXPECT_EQ(buf.peek(3), 6);
+	EXPECT_EQ(buf.pop_front(), 3);
+}
+
+TEST(OvwRingBuf, Iterators)
+{
+	dbgutils::OvwRingBuf<int>	buf(3);
+	for (int i = 0; i < 5; i++) {
+		buf.push_back(i);
+	}
+
+	auto got = std::vector<int>(buf.begin(), buf.end());
+	auto expected = std::vector<int>{ 2,3,4 };
+	EXPECT_EQ(got, expected);
+
+	auto it = buf.begin();
+	EXPECT_EQ(it[2], 4);
+	EXPECT_EQ(*(it + 1), 3);
+	EXPECT_EQ(buf.end() - it, 3);
+
+	for (auto &x : buf) {
+		x *= 10;
+	}
+
+	const auto &cbuf = buf;
+	got = std::vector<int>(cbuf.begin(), cbuf.end());
+	expected = std::vector<int>{ 20,30,40 };
+	EXPECT_EQ(got, expected);
+}
+
+// collect_spans concatenates the spans of a buffer.
+template <class Buf>
+static std::vector<int> collect_spans(const Buf &buf)
+{
+	auto spans = buf.spans();
+
+	std::vector<int> items(spans.first.begin(), spans.first.end());
+	items.insert(items.end(), spans.second.begin(), spans.second.end());
+	return items;
+}
+
+TEST(OvwRingBuf, Spans)
+{
+	dbgutils::Pow2OvwRingBuf<int>	buf(4);
+
+	EXPECT_EQ(buf.spans().first.size, 0);
+	EXPECT_EQ(buf.spans().second.size, 0);
+
+	// Contiguous items.
+	buf.push_back(0);
+	buf.push_back(1);
+	buf.push_back(2);
+	EXPECT_EQ(buf.spans().second.size, 0);
+	EXPECT_EQ(collect_spans(buf), (std::vector<int>{ 0,1,2 }));
+
+	// Items wrapping around the end of the storage.
+	buf.push_back(3);
+	buf.push_back(4);
+	buf.push_back(5);
+	EXPECT_EQ(buf.spans().first.size, 2);
+	EXPECT_EQ(buf.spans().second.size, 2);
+	EXPECT_EQ(collect_spans(buf), (std::vector<int>{ 2,3,4,5 }));
+}
@@ -0,0 +1,172 @@
+#include "pch.h"
+#include <string>
+#include <vector>
+#include "..\debug_utils\ConsoleHistory.h"
+#include "..\debug_utils\PrefixIndex.h"
+
+// The index reads the text of the entries from a history. It is filled here with
+// the entries of the history, independently of the index of the history. Without removals,
+// the id of an entry is its number.
+static void index_all(const dbgutils::ConsoleHistory &history, dbgutils::PrefixIndex *index)
+{
+	for (auto seq = history.begin_seq(); seq < history.end_seq(); seq++) {
+		index->insert(history, history.id_of(seq));
+	}
+}
+
+// backwards returns the entries starting with a prefix, from the latest to the oldest.
+static std::vector<uint64_t> backwards(const dbgutils::ConsoleHistory &history, const dbgutils::PrefixIndex &index, std::wstring_view prefix)
+{
+	std::vector<uint64_t> seqs;
+	uint64_t seq;
+	for (auto before = UINT64_MAX; index.find_previous(history, prefix, before, &seq); before = seq) {
+		seqs.push_back(seq);
+	}
+	return seqs;
+}
+
+// forwards returns the entries starting with a prefix, from the oldest to the latest.
+static std::vector<uint64_t> forwards(const dbgutils::ConsoleHistory &history, const dbgutils::PrefixIndex &index, std::wstring_view prefix)
+{
+	std::vector<uint64_t> seqs;
+	uint64_t seq;
+	for (uint64_t after = 0; index.find_next(history, prefix, after, &seq); after = seq) {
+		seqs.push_back(seq);
+	}
+	return seqs;
+}
+
+TEST(PrefixIndex, Empty)
+{
+	dbgutils::ConsoleHistory history(4);
+	dbgutils::PrefixIndex index;
+
+	EXPECT_EQ(index.size(), 0);
+	EXPECT_EQ(index.memory_usage(), 0);
+	EXPECT_TRUE(backwards(history, index, L"a").empty());
+}
+
+TEST(PrefixIndex, FindsTheEntriesStartingWithThePrefix)
+{
+	dbgutils::ConsoleHistory history(16);
+	for (auto line : { L"", L"git status", L"make", L"git commit", L"gi", L"git status", L"ls", L"git" }) {
+		history.push(line);
+	}
+
+	dbgutils::PrefixIndex index;
+	index_all(history, &index);
+	EXPECT_EQ(index.size(), 8);
+
+	EXPECT_EQ(backwards(history, index, L"git"), (std::vector<uint64_t>{ 7, 5, 3, 1 }));
+	EXPECT_EQ(backwards(history, index, L"git s"), (std::vector<uint64_t>{ 5, 1 }));
+	EXPECT_EQ(backwards(history, index, L"gi"), (std::vector<uint64_t>{ 7, 5, 4, 3, 1 }));
+	EXPECT_EQ(backwards(history, index, L"m"), (std::vector<uint64_t>{ 2 }));
+	EXPECT_EQ(backwards(history, index, L"git statusx"), (std::vector<uint64_t>{}));
+	EXPECT_EQ(backwards(history, index, L"a"), (std::vector<uint64_t>{}));
+	EXPECT_EQ(backwards(history, index, L"z"), (std::vector<uint64_t>{}));
+	EXPECT_EQ(backwards(history, index, L"").size(), 8);
+
+	EXPECT_EQ(forwards(history, index, L"git"), (std::vector<uint64_t>{ 1, 3, 5, 7 }));
+	EXPECT_EQ(forwards(history, index, L"l"), (std::vector<uint64_t>{ 6 }));
+}
+
+TEST(PrefixIndex, SearchesFromAGivenEntry)
+{
+	dbgutils::ConsoleHistory history(16);
+	for (auto line : { L"ab", L"ab", L"b", L"ab", L"b" }) {
+		history.push(line);
+	}
+
+	dbgutils::PrefixIndex index;
+	index_all(history, &index);
+
+	uint64_t seq;
+	EXPECT_TRUE(index.find_previous(history, L"a", 3, &seq));
+	EXPECT_EQ(seq, 1);
+	EXPECT_FALSE(index.find_previous(history, L"a", 0, &seq));
+	EXPECT_TRUE(index.find_next(history, L"a", 1, &seq));
+	EXPECT_EQ(seq, 3);
+	EXPECT_FALSE(index.find_next(history, L"a", 3, &seq));
+}
+
+TEST(PrefixIndex, EraseAndReuseTheNodes)
+{
+	dbgutils::ConsoleHistory history(16);
+	for (auto line : { L"ab", L"ab", L"b", L"ab", L"b" }) {
+		history.push(line);
+	}
+
+	dbgutils::PrefixIndex index;
+	index_all(history, &index);
+
+	// A navigation through all the entries holds the memory of the smaller ones.
+	backwards(history, index, L"");
+	auto memory = index.memory_usage();
+
+	index.erase(history, 1);
+	index.erase(history, 4);
+	EXPECT_EQ(index.size(), 3);
+	EXPECT_EQ(backwards(history, index, L"a"), (std::vector<uint64_t>{ 3, 0 }));
+	EXPECT_EQ(backwards(history, index, L"b"), (std::vector<uint64_t>{ 2 }));
+
+	index.insert(history, 1);
+	index.insert(history, 4);
+	EXPECT_EQ(backwards(history, index, L"a"), (std::vector<uint64_t>{ 3, 1, 0 }));
+	EXPECT_EQ(index.memory_usage(), memory);
+
+	index.clear();
+	EXPECT_EQ(index.size(), 0);
+	EXPECT_TRUE(backwards(history, index, L"").empty());
+}
+
+TEST(PrefixIndex, IdsOfAHistoryWithRemovals)
+{
+	// The first b is removed: the later entries keep their ids, 2, 3 and 4.
+	dbgutils::ConsoleHistory history(16);
+	history.set_duplicates(dbgutils::HISTORY_DUPLICATES_ERASE_OLDER);
+	for (auto line : { L"ab", L"b", L"ac", L"ab1", L"b" }) {
+		history.push(line);
+	}
+	ASSERT_EQ(history.size(), 4);
+
+	dbgutils::PrefixIndex index;
+	index_all(history, &index);
+
+	EXPECT_EQ(backwards(history, index, L"a"), (std::vector<uint64_t>{ 3, 2, 0 }));
+	EXPECT_EQ(backwards(history, index, L"ab"), (std::vector<uint64_t>{ 3, 0 }));
+	EXPECT_EQ(forwards(history, index, L"b"), (std::vector<uint64_t>{ 4 }));
+
+	index.erase(history, 2);
+	EXPECT_EQ(backwards(history, index, L"a"), (std::vector<uint64_t>{ 3, 0 }));
+}
+
+TEST(PrefixIndex, NavigationStartsOverWhenTheIndexChanges)
+{
+	dbgutils::ConsoleHistory history(16);
+	for (auto line : { L"ab", L"b", L"ac" }) {
+		history.push(line);
+	}
+
+	dbgutils::PrefixIndex index;
+	index_all(history, &index);
+
+	uint64_t seq;
+	EXPECT_TRUE(index.find_previous(history, L"a", 3, &seq));
+	EXPECT_EQ(seq, 2);
+
+	history.push(L"ad");
+	index.insert(history, 3);
+	EXPECT_TRUE(index.find_previous(history, L"a", 4, &seq));
+	EXPECT_EQ(seq, 3);
+
+	// Back and forth in the same navigation.
+	EXPECT_TRUE(index.find_previous(history, L"a", 3, &seq));
+	EXPECT_EQ(seq, 2);
+	EXPECT_TRUE(index.find_previous(history, L"a", 2, &seq));
+	EXPECT_EQ(seq, 0);
+	EXPECT_TRUE(index.find_next(history, L"a", 0, &seq));
+	EXPECT_EQ(seq, 2);
+	EXPECT_TRUE(index.find_next(history, L"a", 2, &seq));
+	EXPECT_EQ(seq, 3);
+	EXPECT_FALSE(index.find_next(history, L"a", 3, &seq));
+}
@@ -0,0 +1,369 @@
+#include "pch.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "..\debug_utils\SharedHistory.h"
+#include "..\debug_utils\ConsoleHistory.h"
+#include "..\debug_utils\Console.h"
+#include "CommandEcho.h"
+#include "TempFile.h"
+
+// The processes sharing a file are simulated by several SharedHistory objects, each one
+// with its own handles on the file.
+
+using Records = std::vector<std::wstring>;
+
+static Records load(const std::filesystem::path &path, size_t capacity)
+{
+	Records records;
+	dbgutils::SharedHistory shared(path, capacity, &records);
+	return records;
+}
+
+static Records poll(dbgutils::SharedHistory &shared)
+{
+	Records lines{ L"stale" };
+	shared.poll(&lines);
+	return lines;
+}
+
+// record_bytes returns the bytes of a record, as another writer appends it.
+static std::string record_bytes(std::wstring_view line)
+{
+	TempFile other("dbgutils_test_shared_record.bin");
+	{
+		Records records;
+		dbgutils::SharedHistory c(other.path(), 4, &records);
+		c.append(line);
+	}
+
+	auto size = std::filesystem::file_size(other.path());
+	std::ifstream in(other.path(), std::ios::binary);
+	std::string bytes(static_cast<size_t>(size), '\0');
+	in.read(&bytes[0], size);
+
+	// After the header.
+	return bytes.substr(64);
+}
+
+// append_garbage appends the first bytes of a record, as if its writer had crashed.
+static void append_garbage(const std::filesystem::path &path)
+{
+	std::ofstream out(path, std::ios::binary | std::ios::app);
+	const char bytes[] = { 20, 0, 0, 0, 1, 2, 3, 4, 5, 6 };
+	out.write(bytes, sizeof(bytes));
+}
+
+TEST(SharedHistory, NewFileIsEmpty)
+{
+	TempFile file("dbgutils_test_shared_new.bin");
+	Records records{ L"stale" };
+	dbgutils::SharedHistory shared(file.path(), 4, &records);
+
+	EXPECT_TRUE(records.empty());
+	EXPECT_TRUE(std::filesystem::exists(file.path()));
+	EXPECT_EQ(shared.generation(), 0);
+	EXPECT_TRUE(poll(shared).empty());
+}
+
+TEST(SharedHistory, OtherWritersAreMerged)
+{
+	TempFile file("dbgutils_test_shared_merge.bin");
+	Records records;
+	dbgutils::SharedHistory a(file.path(), 4, &records);
+	dbgutils::SharedHistory b(file.path(), 4, &records);
+	EXPECT_NE(a.writer(), b.writer());
+
+	a.append(L"hello");
+	a.append(L"wörld");
+	b.append(L"");
+	EXPECT_EQ(a.generation(), 3);
+	EXPECT_EQ(b.generation(), 3);
+
+	// Each one reads the records of the other one only, once.
+	EXPECT_EQ(poll(b), (Records{ L"hello", L"wörld" }));
+	EXPECT_EQ(poll(a), (Records{ L"" }));
+	EXPECT_TRUE(poll(a).empty());
+	EXPECT_TRUE(poll(b).empty());
+
+	a.append(L"again");
+	EXPECT_EQ(poll(b), (Records{ L"again" }));
+}
+
+TEST(SharedHistory, PollReadsTheNewBytesOnly)
+{
+	TempFile file("dbgutils_test_shared_bytes.bin");
+	Records records;
+	dbgutils::SharedHistory a(file.path(), 4, &records);
+	dbgutils::SharedHistory b(file.path(), 4, &records);
+
+	for (int i = 0; i < 1000; i++) {
+		a.append(L"command " + std::to_wstring(i));
+		if (i % 10 == 9) {
+			ASSERT_EQ(b.poll(&records), 10);
+			EXPECT_EQ(records.back(), L"command " + std::to_wstring(i));
+		}
+	}
+
+	// Every byte was read once, the header when the file was opened.
+	auto bytesRead = b.bytes_read();
+	EXPECT_EQ(bytesRead, std::filesystem::file_size(file.path()));
+
+	// Without a new append, there is nothing to read.
+	EXPECT_EQ(b.poll(&records), 0);
+	EXPECT_EQ(b.bytes_read(), bytesRead);
+}
+
+TEST(SharedHistory, LoadsTheLatestRecordsOnly)
+{
+	TempFile file("dbgutils_test_shared_latest.bin");
+	{
+		Records records;
+		dbgutils::SharedHistory a(file.path(), 3, &records);
+		dbgutils::SharedHistory b(file.path(), 3, &records);
+		for (int i = 0; i < 10; i++) {
+			(i % 2 ? a : b).append(std::to_wstring(i));
+		}
+	}
+
+	EXPECT_EQ(load(file.path(), 3), (Records{ L"7", L"8", L"9" }));
+	EXPECT_EQ(load(file.path(), 100).size(), 10);
+}
+
+TEST(SharedHistory, LoadingReadsTheEndOfTheFile)
+{
+	TempFile file("dbgutils_test_shared_end.bin");
+	{
+		Records records;
+		dbgutils::SharedHistory a(file.path(), 10, &records);
+		for (int i = 0; i < 100000; i++) {
+			a.append(L"command " + std::to_wstring(i));
+		}
+	}
+
+	Records records;
+	dbgutils::SharedHistory b(file.path(), 10, &records);
+	EXPECT_EQ(records.size(), 10);
+	EXPECT_EQ(records.back(), L"command 99999");
+	EXPECT_LT(b.bytes_read(), std::filesystem::file_size(file.path()) / 10);
+
+	// Larger than the first block.
+	Records many;
+	dbgutils::SharedHistory c(file.path(), 20000, &many);
+	ASSERT_EQ(many.size(), 20000);
+	EXPECT_EQ(many.front(), L"command 80000");
+	EXPECT_EQ(many.back(), L"command 99999");
+}
+
+TEST(SharedHistory, TornRecordIsSkipped)
+{
+	TempFile file("dbgutils_test_shared_torn.bin");
+	Records records;
+	dbgutils::SharedHistory a(file.path(), 4, &records);
+	dbgutils::SharedHistory b(file.path(), 4, &records);
+
+	a.append(L"one");
+	append_garbage(file.path());
+
+	// The garbage may be a record being written: the poll stops before it.
+	a.append(L"two");
+	EXPECT_EQ(poll(b), (Records{ L"one" }));
+	a.append(L"three");
+	EXPECT_TRUE(poll(b).empty());
+
+	// It is still not intact after the delay: it is torn, even without a new append.
+	std::this_thread::sleep_for(dbgutils::SharedHistory::kTornRecordDelay);
+	EXPECT_EQ(poll(b), (Records{ L"two", L"three" }));
+
+	// Loading skips it.
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"one", L"two", L"three" }));
+}
+
+TEST(SharedHistory, RecordBeingWrittenIsReadLater)
+{
+	TempFile file("dbgutils_test_shared_partial.bin");
+	Records records;
+	dbgutils::SharedHistory a(file.path(), 4, &records);
+	a.append(L"one");
+
+	// The first half of a record, without the increment of the generation.
+	{
+		TempFile other("dbgutils_test_shared_partial_other.bin");
+		dbgutils::SharedHistory c(other.path(), 4, &records);
+		c.append(L"two");
+		auto size = std::filesystem::file_size(other.path());
+
+		std::ifstream in(other.path(), std::ios::binary);
+		std::string bytes(static_cast<size_t>(size), '\0');
+		in.read(&bytes[0], size);
+
+		std::ofstream out(file.path(), std::ios::binary | std::ios::app);
+		out.write(bytes.data() + 64, (size - 64) / 2);
+		out.flush();
+
+		// A new reader loads the intact records.
+		dbgutils::SharedHistory b(file.path(), 4, &records);
+		EXPECT_EQ(records, (Records{ L"one" }));
+		EXPECT_TRUE(poll(b).empty());
+
+		// The end of the record, then the next append.
+		out.write(bytes.data() + 64 + (size - 64) / 2, (size - 64) - (size - 64) / 2);
+		out.flush();
+		a.append(L"three");
+		EXPECT_EQ(poll(b), (Records{ L"two", L"three" }));
+	}
+}
+
+TEST(SharedHistory, RecordCompletedAfterALaterOneIsRead)
+{
+	TempFile file("dbgutils_test_shared_late.bin");
+	Records records;
+	dbgutils::SharedHistory a(file.path(), 4, &records);
+	dbgutils::SharedHistory b(file.path(), 4, &records);
+	a.append(L"one");
+
+	// The space of a record whose writer wrote the first half only, before the append of a.
+	auto bytes = record_bytes(L"two");
+	auto start = std::filesystem::file_size(file.path());
+	{
+		std::ofstream out(file.path(), std::ios::binary | std::ios::app);
+		out.write(bytes.data(), bytes.size() / 2);
+		out.write(std::string(bytes.size() - bytes.size() / 2, '\0').data(), bytes.size() - bytes.size() / 2);
+	}
+	a.append(L"three");
+	EXPECT_EQ(poll(b), (Records{ L"one" }));
+
+	// More appends complete before it.
+	a.append(L"four");
+	EXPECT_TRUE(poll(b).empty());
+
+	// Its writer completes it, then increments the generation.
+	{
+		std::fstream out(file.path(), std::ios::binary | std::ios::in | std::ios::out);
+		out.seekp(static_cast<std::streamoff>(start + bytes.size() / 2));
+		out.write(bytes.data() + bytes.size() / 2, bytes.size() - bytes.size() / 2);
+	}
+	a.append(L"five");
+	EXPECT_EQ(poll(b), (Records{ L"two", L"three", L"four", L"five" }));
+}
+
+TEST(SharedHistory, OtherFileIsReset)
+{
+	TempFile file("dbgutils_test_shared_other.bin");
+	{
+		std::ofstream out(file.path(), std::ios::binary);
+		out << "not a shared history, but long enough to hold a header of sixty-four bytes";
+	}
+
+	Records records{ L"stale" };
+	dbgutils::SharedHistory shared(file.path(), 4, &records);
+	EXPECT_TRUE(records.empty());
+
+	shared.append(L"hello");
+	EXPECT_EQ(load(file.path(), 4), (Records{ L"hello" }));
+}
+
+TEST(SharedHistory, ConcurrentWriters)
+{
+	TempFile file("dbgutils_test_shared_concurrent.bin");
+	const int numWriters = 4;
+	const int numLines = 2000;
+
+	Records records;
+	dbgutils::SharedHistory reader(file.path(), 4, &records);
+	Records merged;
+
+	std::vector<std::thread> writers;
+	for (int w = 0; w < numWriters; w++) {
+		writers.emplace_back([&file, w]() {
+			Records ignored;
+			dbgutils::SharedHistory shared(file.path(), 4, &ignored);
+			for (int i = 0; i < numLines; i++) {
+				shared.append(L"writer " + std::to_wstring(w) + L" line " + std::to_wstring(i));
+			}
+		});
+	}
+
+	// The reader polls while the writers append.
+	for (int k = 0; k < 1000; k++) {
+		reader.poll(&records);
+		merged.insert(merged.end(), records.begin(), records.end());
+	}
+	for (auto &writer : writers) {
+		writer.join();
+	}
+	reader.poll(&records);
+	merged.insert(merged.end(), records.begin(), records.end());
+
+	// Every line once, and the lines of a writer in order.
+	ASSERT_EQ(merged.size(), numWriters * numLines);
+	std::vector<int> next(numWriters, 0);
+	for (const auto &line : merged) {
+		int w = std::stoi(line.substr(7));
+		ASSERT_EQ(line, L"writer " + std::to_wstring(w) + L" line " + std::to_wstring(next[w]));
+		next[w]++;
+	}
+	EXPECT_EQ(reader.generation(), numWriters * numLines);
+	EXPECT_EQ(load(file.path(), numWriters * numLines), merged);
+}
+
+TEST(SharedHistory, ConsoleHistoriesShareTheirEntries)
+{
+	TempFile file("dbgutils_test_shared_history.bin");
+	dbgutils::ConsoleHistory a(4);
+	dbgutils::ConsoleHistory b(4);
+	EXPECT_EQ(a.open_shared(file.path()), 0);
+	EXPECT_EQ(b.merge_shared(), 0);
+
+	a.push(L"one");
+	a.push(L"two");
+	EXPECT_EQ(b.open_shared(file.path()), 2);
+	b.push(L"three");
+
+	EXPECT_EQ(a.merge_shared(), 1);
+	EXPECT_EQ(b.merge_shared(), 0);
+	ASSERT_EQ(a.size(), 3);
+	EXPECT_EQ(a.entry(a.end_seq() - 1), L"three");
+	EXPECT_EQ(b.entry(b.end_seq() - 1), L"three");
+
+	// A third process starts with the latest entries.
+	dbgutils::ConsoleHistory c(2);
+	EXPECT_EQ(c.open_shared(file.path()), 2);
+	EXPECT_EQ(c.entry(c.begin_seq()), L"two");
+}
+
+TEST(SharedHistory, ConsoleMergesWhenIdle)
+{
+	TempFile file("dbgutils_test_shared_console.bin");
+
+	auto interpreter = dbgutils::Interpreter({ std::make_shared<CommandEcho>() });
+	dbgutils::Console a(interpreter);
+	dbgutils::Console b(interpreter);
+	EXPECT_EQ(a.open_shared_history(file.path()), 0);
+	EXPECT_EQ(b.open_shared_history(file.path()), 0);
+
+	auto execute = [](dbgutils::Console &cons, const wchar_t *cmd) {
+		cons.insert_text(cmd);
+		cons.handle_key(VK_RETURN);
+	};
+	execute(a, L"echo one");
+	execute(b, L"echo two");
+
+	// b is browsing its history: the entry of a waits.
+	b.handle_key(VK_UP);
+	b.update();
+	EXPECT_EQ(b.cmdline(), L"echo two");
+	EXPECT_FALSE(b.handle_key(VK_UP));
+
+	b.handle_key(VK_DOWN);
+	b.update();
+	b.handle_key(VK_UP);
+	EXPECT_EQ(b.cmdline(), L"echo one");
+	b.handle_key(VK_UP);
+	EXPECT_EQ(b.cmdline(), L"echo two");
+
+	a.update();
+	a.handle_key(VK_UP);
+	EXPECT_EQ(a.cmdline(), L"echo two");
+}
@@ -0,0 +1,117 @@
+#include "pch.h"
+#include <thread>
+#include <vector>
+#include "..\debug_utils\SpscOvwRingBuf.h"
+
+TEST(SpscOvwRingBuf, ctor)
+{
+	dbgutils::SpscOvwRingBuf<int>	buf(3);
+
+	EXPECT_EQ(buf.capacity(), 3);
+	EXPECT_EQ(buf.size(), 0);
+	EXPECT_TRUE(buf.empty());
+	EXPECT_EQ(buf.dropped(), 0);
+}
+
+TEST(SpscOvwRingBuf, PushPop)
+{
+	dbgutils::SpscOvwRingBuf<int>	buf(3);
+	buf.push_back(1);
+
+	EXPECT_EQ(buf.size(), 1);
+
+	int got = 0;
+	EXPECT_TRUE(buf.pop_front(&got));
+	EXPECT_EQ(got, 1);
+	EXPECT_TRUE(buf.empty());
+	EXPECT_FALSE(buf.pop_front(&got));
+}
+
+TEST(SpscOvwRingBuf, OverwriteWhenFull)
+{
+	dbgutils::SpscOvwRingBuf<int>	buf(3);
+	for (int i = 0; i < 5; i++) {
+		EXPECT_TRUE(buf.push_back(i));
+	}
+
+	EXPECT_EQ(buf.size(), 3);
+	EXPECT_EQ(buf.dropped(), 2);
+
+	dbgutils::OvwRingBuf<int> out(8);
+	EXPECT_EQ(buf.drain_into(out), 3);
+	EXPECT_EQ(out.peek(0), 2);
+	EXPECT_EQ(out.peek(1), 3);
+	EXPECT_EQ(out.peek(2), 4);
+}
+
+TEST(SpscOvwRingBuf, CapacityOfOne)
+{
+	dbgutils::SpscOvwRingBuf<int>	buf(1);
+	for (int i = 0; i < 3; i++) {
+		EXPECT_TRUE(buf.push_back(i));
+	}
+
+	EXPECT_EQ(buf.size(), 1);
+	EXPECT_EQ(buf.dropped(), 2);
+
+	int got = 0;
+	EXPECT_TRUE(buf.pop_front(&got));
+	EXPECT_EQ(got, 2);
+	EXPECT_FALSE(buf.pop_front(&got));
+
+	EXPECT_TRUE(buf.push_back(3));
+	EXPECT_TRUE(buf.pop_front(&got));
+	EXPECT_EQ(got, 3);
+	EXPECT_TRUE(buf.empty());
+}
+
+TEST(SpscOvwRingBuf, WrapAround)
+{
+	dbgutils::SpscOvwRingBuf<std::wstring>	buf(2);
+
+	for (int i = 0; i < 10; i++) {
+		buf.push_back(std::to_wstring(i));
+
+		std::wstring got;
+		EXPECT_TRUE(buf.pop_front(&got));
+		EXPECT_EQ(got, std::to_wstring(i));
+	}
+
+	EXPECT_EQ(buf.dropped(), 0);
+}
+
+// The consumer receives the items in order and every item sent
+// is either received or counted as dropped.
+TEST(SpscOvwRingBuf, TwoThreads)
+{
+	const uint64_t kNumItems = 200000;
+	dbgutils::SpscOvwRingBuf<uint64_t>	buf(64);
+
+	std::thread producer([&buf] {
+		for (uint64_t i = 1; i <= kNumItems; i++) {
+			buf.push_back(i);
+		}
+	});
+
+	uint64_t received = 0;
+	uint64_t last = 0;
+	bool inOrder = true;
+
+	auto consume = [&] {
+		uint64_t item;
+		while (buf.pop_front(&item)) {
+			inOrder = inOrder && item > last;
+			last = item;
+			received++;
+		}
+	};
+
+	while (last != kNumItems && received + buf.dropped() < kNumItems) {
+		consume();
+	}
+	producer.join();
+	consume();
+
+	EXPECT_TRUE(inOrder);
+	EXPECT_EQ(received + buf.dropped(), kNumItems);
+}
@@ -0,0 +1,144 @@
+#include "pch.h"
+#include <string>
+#include <vector>
+#include "..\debug_utils\TrigramIndex.h"
+
+// candidates returns the candidates for a pattern, from the latest to the oldest.
+static std::vector<uint64_t> candidates(const dbgutils::TrigramIndex &index, std::wstring_view pattern)
+{
+	std::vector<uint64_t> seqs;
+	uint64_t seq;
+	for (auto before = UINT64_MAX; index.find_candidate(pattern, before, &seq); before = seq) {
+		seqs.push_back(seq);
+	}
+	return seqs;
+}
+
+TEST(TrigramIndex, Empty)
+{
+	dbgutils::TrigramIndex index;
+
+	EXPECT_EQ(index.size(), 0);
+	EXPECT_EQ(index.memory_usage(), 0);
+	EXPECT_TRUE(candidates(index, L"abc").empty());
+}
+
+TEST(TrigramIndex, FindsTheEntriesHoldingAllTheTrigrams)
+{
+	dbgutils::TrigramIndex index;
+	index.add(0, L"git status");
+	index.add(1, L"ls -l");
+	index.add(2, L"git commit");
+	index.add(3, L"digit");
+	index.add(4, L"gi");
+
+	EXPECT_EQ(candidates(index, L"git"), (std::vector<uint64_t>{ 3, 2, 0 }));
+	EXPECT_EQ(candidates(index, L"git "), (std::vector<uint64_t>{ 2, 0 }));
+	EXPECT_EQ(candidates(index, L"git c"), (std::vector<uint64_t>{ 2 }));
+	EXPECT_TRUE(candidates(index, L"xyz").empty());
+	EXPECT_EQ(index.size(), 5);
+}
+
+TEST(TrigramIndex, FindsThePatternsShorterThanATrigram)
+{
+	dbgutils::TrigramIndex index;
+	index.add(0, L"git status");
+	index.add(1, L"ls -l");
+	index.add(2, L"gi");
+	index.add(3, L"g");
+
+	// They are keys by themselves, so their candidates contain them.
+	EXPECT_EQ(candidates(index, L"g"), (std::vector<uint64_t>{ 3, 2, 0 }));
+	EXPECT_EQ(candidates(index, L"gi"), (std::vector<uint64_t>{ 2, 0 }));
+	EXPECT_EQ(candidates(index, L"l"), (std::vector<uint64_t>{ 1 }));
+	EXPECT_EQ(candidates(index, L" -"), (std::vector<uint64_t>{ 1 }));
+	EXPECT_TRUE(candidates(index, L"x").empty());
+	EXPECT_TRUE(candidates(index, L"ig").empty());
+}
+
+TEST(TrigramIndex, CandidatesMayHoldTheTrigramsOutOfOrder)
+{
+	dbgutils::TrigramIndex index;
+	index.add(0, L"abcd bcde");
+
+	// "abcde" is not in the text, but its trigrams are.
+	EXPECT_EQ(candidates(index, L"abcde"), (std::vector<uint64_t>{ 0 }));
+}
+
+TEST(TrigramIndex, RemoveTheOldestEntries)
+{
+	dbgutils::TrigramIndex index;
+	for (uint64_t i = 0; i < 100; i++) {
+		index.add(i, i % 2 == 0 ? L"even line" : L"odd line");
+	}
+	for (uint64_t i = 0; i < 95; i++) {
+		index.remove(i, i % 2 == 0 ? L"even line" : L"odd line");
+	}
+
+	EXPECT_EQ(index.size(), 5);
+	EXPECT_EQ(candidates(index, L"line"), (std::vector<uint64_t>{ 99, 98, 97, 96, 95 }));
+	EXPECT_EQ(candidates(index, L"even"), (std::vector<uint64_t>{ 98, 96 }));
+
+	// The trigrams of the removed entries only are dropped.
+	index.add(100, L"new");
+	index.remove(95, L"odd line");
+	index.remove(96, L"even line");
+	index.remove(97, L"odd line");
+	index.remove(98, L"even line");
+	EXPECT_TRUE(candidates(index, L"even").empty());
+	EXPECT_EQ(candidates(index, L"line"), (std::vector<uint64_t>{ 99 }));
+	// The sequences of one, two and three characters of "odd line", and the ones of "new"
+	// which are not in it: "w", "ew" and "new".
+	EXPECT_EQ(index.num_grams(), 7 + 7 + 6 + 3);
+}
+
+TEST(TrigramIndex, FindBeforeAnEntry)
+{
+	dbgutils::TrigramIndex index;
+	for (uint64_t i = 0; i < 10; i++) {
+		index.add(i, L"same");
+	}
+
+	uint64_t seq;
+	ASSERT_TRUE(index.find_candidate(L"same", 5, &seq));
+	EXPECT_EQ(seq, 4);
+	EXPECT_FALSE(index.find_candidate(L"same", 0, &seq));
+}
+
+TEST(TrigramIndex, NumbersAboveTwoToThe32)
+{
+	dbgutils::TrigramIndex index;
+	const uint64_t first = (1ull << 32) - 3;
+
+	for (uint64_t i = first; i < first + 6; i++) {
+		index.add(i, i % 2 == 0 ? L"even" : L"odd");
+	}
+	index.remove(first, L"odd");
+
+	EXPECT_EQ(candidates(index, L"even"), (std::vector<uint64_t>{ first + 5, first + 3, first + 1 }));
+	EXPECT_EQ(candidates(index, L"odd"), (std::vector<uint64_t>{ first + 4, first + 2 }));
+}
+
+TEST(TrigramIndex, EraseFromTheMiddle)
+{
+	dbgutils::TrigramIndex index;
+	const wchar_t *texts[] = { L"make all", L"git status", L"make clean", L"git diff" };
+	for (uint64_t i = 0; i < 4; i++) {
+		index.add(i, texts[i]);
+	}
+
+	// The other entries keep their number.
+	index.erase(1, texts[1]);
+	EXPECT_EQ(index.size(), 3);
+	EXPECT_EQ(candidates(index, L"make"), (std::vector<uint64_t>{ 2, 0 }));
+	EXPECT_EQ(candidates(index, L"git"), (std::vector<uint64_t>{ 3 }));
+	EXPECT_TRUE(candidates(index, L"status").empty());
+
+	// The oldest entry can be erased too, and the numbers may have gaps.
+	index.erase(0, texts[0]);
+	index.add(7, L"git status");
+	EXPECT_EQ(candidates(index, L"git"), (std::vector<uint64_t>{ 7, 3 }));
+	index.remove(2, texts[2]);
+	EXPECT_TRUE(candidates(index, L"make").empty());
+	EXPECT_EQ(candidates(index, L"git"), (std::vector<uint64_t>{ 7, 3 }));
+}
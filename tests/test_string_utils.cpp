@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "..\debug_utils\string_utils.h"
+
+static std::vector<std::wstring_view> tokenize(std::wstring_view str)
+{
+	std::vector<std::wstring_view> tokens;
+	wstr_tokenize(str, &tokens);
+	return tokens;
+}
+
+TEST(wstr_tokenize, EmptyString)
+{
+	EXPECT_TRUE(tokenize(L"").empty());
+	EXPECT_TRUE(tokenize(L" \t  \r\n").empty());
+}
+
+TEST(wstr_tokenize, Tokens)
+{
+	auto got = tokenize(L"  echo a\tbc  \n d ");
+	auto expected = std::vector<std::wstring_view>{ L"echo", L"a", L"bc", L"d" };
+	EXPECT_EQ(got, expected);
+}
+
+TEST(wstr_tokenize, TokensAreViewsOnTheInput)
+{
+	std::wstring str = L"ab cd";
+
+	auto got = tokenize(str);
+
+	ASSERT_EQ(got.size(), 2);
+	EXPECT_EQ(got[0].data(), str.data());
+	EXPECT_EQ(got[1].data(), str.data() + 3);
+}
+
+TEST(wstr_tokenize, ReusesTheTokensVector)
+{
+	std::vector<std::wstring_view> tokens;
+
+	wstr_tokenize(L"a b c", &tokens);
+	wstr_tokenize(L"d", &tokens);
+
+	auto expected = std::vector<std::wstring_view>{ L"d" };
+	EXPECT_EQ(tokens, expected);
+}
+
+static std::vector<std::wstring_view> split_lines(std::wstring_view str)
+{
+	std::vector<std::wstring_view> lines;
+	wstr_split_lines(str, &lines);
+	return lines;
+}
+
+TEST(wstr_split_lines, NoLineBreak)
+{
+	auto expected = std::vector<std::wstring_view>{ L"echo a" };
+	EXPECT_EQ(split_lines(L"echo a"), expected);
+}
+
+TEST(wstr_split_lines, AllKindsOfLineBreaks)
+{
+	auto expected = std::vector<std::wstring_view>{ L"a", L"b", L"c", L"", L"d" };
+	EXPECT_EQ(split_lines(L"a\r\nb\nc\r\rd"), expected);
+}
+
+TEST(wstr_split_lines, TrailingLineBreak)
+{
+	auto expected = std::vector<std::wstring_view>{ L"a", L"" };
+	EXPECT_EQ(split_lines(L"a\n"), expected);
+}
@@ -0,0 +1,73 @@
+"""Generates the character class table of debug_utils/CharClass.cpp.
+
+The classes come from the Unicode Character Database shipped with Python
+(unicodedata): the White_Space property, and the general categories for the
+word classes. Run it and paste its output in CharClass.cpp:
+
+    python tools/gen_char_class.py
+"""
+import unicodedata
+
+BLOCK_BITS = 6
+BLOCK_SIZE = 1 << BLOCK_BITS
+
+# Must match the CHAR_CLASS enum of CharClass.h.
+OTHER, SPACE, LETTER, DIGIT, CONNECTOR, PUNCT, IDEOGRAPH = range(7)
+
+# The White_Space property (PropList.txt).
+WHITE_SPACE = set([0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x20, 0x85, 0xA0, 0x1680]
+                  + list(range(0x2000, 0x200B))
+                  + [0x2028, 0x2029, 0x202F, 0x205F, 0x3000])
+
+
+def char_class(c):
+    if c in WHITE_SPACE:
+        return SPACE
+    ch = chr(c)
+    gc = unicodedata.category(ch)
+    name = unicodedata.name(ch, '')
+    if name.startswith('CJK UNIFIED IDEOGRAPH') or name.startswith('CJK COMPATIBILITY IDEOGRAPH'):
+        return IDEOGRAPH
+    if 0x3041 <= c <= 0x309F and gc[0] == 'L':  # Hiragana
+        return IDEOGRAPH
+    if gc == 'Cs':  # the halves of the characters outside the BMP, mostly letters
+        return LETTER
+    if gc[0] in 'LM':
+        return LETTER
+    if gc == 'Nd':
+        return DIGIT
+    if gc[0] == 'N':
+        return LETTER
+    if gc == 'Pc':
+        return CONNECTOR
+    if gc[0] in 'PS':
+        return PUNCT
+    return OTHER
+
+
+def main():
+    blocks = []
+    index = []
+    for b in range(0x10000 // BLOCK_SIZE):
+        block = [char_class(b * BLOCK_SIZE + i) for i in range(BLOCK_SIZE)]
+        if block not in blocks:
+            blocks.append(block)
+        index.append(blocks.index(block))
+
+    print('\t// Generated by tools/gen_char_class.py (Unicode %s).' % unicodedata.unidata_version)
+    print('\t// kCharClassBlockBits (CharClass.h) must be %d.' % BLOCK_BITS)
+    print()
+    print('\tconst uint8_t kCharClassBlockIndex[%d] = {' % len(index))
+    for i in range(0, len(index), 32):
+        print('\t\t' + ','.join('%d' % x for x in index[i:i + 32]) + ',')
+    print('\t};')
+    print()
+    # Two classes per byte, the first one in the low nibble.
+    print('\tconst uint8_t kCharClassBlocks[%d][%d] = {' % (len(blocks), BLOCK_SIZE // 2))
+    for block in blocks:
+        packed = [block[i] | (block[i + 1] << 4) for i in range(0, BLOCK_SIZE, 2)]
+        print('\t\t{ ' + ','.join('0x%02x' % x for x in packed) + ' },')
+    print('\t};')
+
+if __name__ == '__main__':
+    main()